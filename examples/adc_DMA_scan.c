@@ -0,0 +1,277 @@
+/*
+--|----------------------------------------------------------------------------|
+--| FILE DESCRIPTION:
+--|   adc_DMA_scan.c provides a simple demo which samples PA0, PA1 and the
+--|   internal reference at a fixed rate set by TIM3, using DMA to fill a
+--|   double buffer, and averages each half of the buffer.
+--|  
+--|----------------------------------------------------------------------------|
+--| REFERENCES:
+--|   stm32f10x reference manual, page 215
+--|
+--|----------------------------------------------------------------------------|
+*/
+
+/*
+--|----------------------------------------------------------------------------|
+--| INCLUDE FILES
+--|----------------------------------------------------------------------------|
+*/
+
+#include <stddef.h>
+
+#include "PSP_ADC.h"
+#include "PSP_Clock_Tree.h"
+#include "PSP_Core_Instructions.h"
+#include "PSP_GPIO.h"
+#include "PSP_NVIC.h"
+#include "PSP_RCC.h"
+#include "PSP_TIMx.h"
+
+/*
+--|----------------------------------------------------------------------------|
+--| DEFINES
+--|----------------------------------------------------------------------------|
+*/
+
+/*
+--| NAME: SCAN_RATE_HZ
+--| DESCRIPTION: the scans per second, set by the TIM3 update rate
+--| TYPE: uint32_t
+*/
+#define SCAN_RATE_HZ (10000u)
+
+/*
+--| NAME: SEQUENCE_LENGTH
+--| DESCRIPTION: the conversions in each scan
+--| TYPE: uint32_t
+*/
+#define SEQUENCE_LENGTH (3u)
+
+/*
+--| NAME: SCANS_PER_HALF
+--| DESCRIPTION: the scans in each half of the buffer, a callback every
+--|   10 mSec at SCAN_RATE_HZ
+--| TYPE: uint32_t
+*/
+#define SCANS_PER_HALF (100u)
+
+/*
+--| NAME: ANALOG_GPIO_PORT
+--| DESCRIPTION: the GPIO port which contains the analog inputs
+--| TYPE: GPIO_Port_t*
+*/
+#define ANALOG_GPIO_PORT (GPIO_Port_A)
+
+/*
+--|----------------------------------------------------------------------------|
+--| TYPES
+--|----------------------------------------------------------------------------|
+*/
+
+/* None */
+
+/*
+--|----------------------------------------------------------------------------|
+--| CONSTANTS
+--|----------------------------------------------------------------------------|
+*/
+
+/*
+--| NAME: sequence
+--| DESCRIPTION: the conversions of each scan, the internal reference needs
+--|   a long sample time
+--| TYPE: ADC_Sequence_Entry_t[]
+*/
+static const ADC_Sequence_Entry_t sequence[SEQUENCE_LENGTH] =
+{
+    {0u,  ADC_SMPR_28_5_CYCLES},  // PA0
+    {1u,  ADC_SMPR_28_5_CYCLES},  // PA1
+    {17u, ADC_SMPR_239_5_CYCLES}, // internal reference
+};
+
+_Static_assert(CLOCK_TREE_TIMER_PSC(CLOCK_TREE_TIM3_CLK_HZ, 1000000u) <= CLOCK_TREE_TIMER_MAX,
+               "TIM3 clock cannot be divided down to 1MHz");
+_Static_assert(CLOCK_TREE_TIMER_ARR(1000000u, SCAN_RATE_HZ) <= CLOCK_TREE_TIMER_MAX,
+               "1MHz cannot be divided down to SCAN_RATE_HZ");
+
+/*
+--|----------------------------------------------------------------------------|
+--| VARIABLES
+--|----------------------------------------------------------------------------|
+*/
+
+/*
+--| NAME: sample_buffer
+--| DESCRIPTION: the double buffer, written by DMA
+--| TYPE: uint16_t[]
+*/
+uint16_t sample_buffer[2u * SCANS_PER_HALF * SEQUENCE_LENGTH];
+
+/*
+--| NAME: adc_handle
+--| DESCRIPTION: the ADC1 handle
+--| TYPE: ADC_Handle_t
+*/
+ADC_Handle_t adc_handle;
+
+/*
+--| NAME: averages
+--| DESCRIPTION: the average of each channel over the last half buffer, for
+--|   watching in a debugger
+--| TYPE: uint32_t[]
+*/
+volatile uint32_t averages[SEQUENCE_LENGTH];
+
+/*
+--| NAME: analog_pin_init_data
+--| DESCRIPTION: initialization data for the analog input pins
+--| TYPE: GPIO_Pin_Initialization_Data_t
+*/
+GPIO_Pin_Initialization_Data_t analog_pin_init_data = 
+{
+    GPIO_PIN_CNFy_ANALOG_MODE,
+    GPIO_PIN_MODEy_INPUT_MODE,
+    GPIO_PIN_NO_PULL_UP_OR_DOWN
+};
+
+/*
+--|----------------------------------------------------------------------------|
+--| FUNCTION PROTOTYPES
+--|----------------------------------------------------------------------------|
+*/
+
+/*------------------------------------------------------------------------------
+Function Name:
+    main
+
+Function Description:
+    main application function which sets up ADC1 and TIM3 and sleeps, all
+    of the sampling is done by the ADC and DMA.
+
+Parameters:
+    None
+
+Returns:
+    int [return is never reached]
+
+Assumptions/Limitations:
+    None
+------------------------------------------------------------------------------*/
+int main(void);
+
+/*------------------------------------------------------------------------------
+Function Name:
+    Average_Half_Callback
+
+Function Description:
+    Average each channel over a half of the buffer.
+
+Parameters:
+    p_context: unused.
+    p_samples: the samples, interleaved scan by scan.
+    num_scans: the number of scans.
+
+Returns:
+    None
+
+Assumptions/Limitations:
+    None
+------------------------------------------------------------------------------*/
+void Average_Half_Callback(void * p_context, const uint16_t * p_samples, uint32_t num_scans);
+
+/*------------------------------------------------------------------------------
+Function Name:
+    DMA1_chan1_IRQ_handler
+
+Function Description:
+    ADC1 DMA channel interrupt handler.
+
+Parameters:
+    None
+
+Returns:
+    None
+
+Assumptions/Limitations:
+    None
+------------------------------------------------------------------------------*/
+void DMA1_chan1_IRQ_handler(void);
+
+/*
+--|----------------------------------------------------------------------------|
+--| FUNCTION DEFINITIONS
+--|----------------------------------------------------------------------------|
+*/
+
+int main(void)
+{
+    GPIO_Pin_t analog_pins[2] =
+    {
+        {ANALOG_GPIO_PORT, 0u},
+        {ANALOG_GPIO_PORT, 1u}
+    };
+
+    ADC_Initialization_Data_t adc_init_data =
+    {
+        sequence,
+        SEQUENCE_LENGTH,
+        ADC_CR2_EXTSEL_TIM3_TRGO,
+        sample_buffer,
+        SCANS_PER_HALF,
+        Average_Half_Callback,
+        NULL
+    };
+
+    // enable the clock control for GPIO port A, ADC1 and TIM3
+    RCC->APB2ENR |= RCC_APB2ENR_IOPAEN_FLAG | RCC_APB2ENR_ADC1EN_FLAG;
+    RCC->APB1ENR |= RCC_APB1ENR_TIM3EN_FLAG;
+
+    PSP_GPIO_Set_Pin_Mode(&analog_pins[0], &analog_pin_init_data);
+    PSP_GPIO_Set_Pin_Mode(&analog_pins[1], &analog_pin_init_data);
+
+    (void)ADC_Init(&adc_handle, &adc_init_data);
+    NVIC_Enable_IRQ(DMA1_Channel1_IRQn);
+    ADC_Start(&adc_handle);
+
+    // TIM3 counts at 1 MHz and its update event, as TRGO, starts each scan
+    TIM3->PSC = CLOCK_TREE_TIMER_PSC(CLOCK_TREE_TIM3_CLK_HZ, 1000000u);
+    TIM3->ARR = CLOCK_TREE_TIMER_ARR(1000000u, SCAN_RATE_HZ);
+    TIM3->CR2 = TIMx_CR2_MMS_UPDATE << TIMx_CR2_MMS_SHIFT_AMT;
+    TIMx_Start(TIM3);
+
+    while (1)
+    {
+        Core_Wait_For_Interrupt();
+    }
+
+    // never reached
+    return 0;
+}
+
+void Average_Half_Callback(void * p_context, const uint16_t * p_samples, uint32_t num_scans)
+{
+    uint32_t sums[SEQUENCE_LENGTH] = {0u};
+    uint32_t scan;
+    uint32_t i;
+
+    (void)p_context;
+
+    for (scan = 0u; scan < num_scans; scan++)
+    {
+        for (i = 0u; i < SEQUENCE_LENGTH; i++)
+        {
+            sums[i] += p_samples[(scan * SEQUENCE_LENGTH) + i];
+        }
+    }
+
+    for (i = 0u; i < SEQUENCE_LENGTH; i++)
+    {
+        averages[i] = sums[i] / num_scans;
+    }
+}
+
+void DMA1_chan1_IRQ_handler(void)
+{
+    ADC_DMA_IRQ_Handler(&adc_handle);
+}
@@ -17,6 +17,7 @@
 --|----------------------------------------------------------------------------|
 */
 
+#include "PSP_Clock_Tree.h"
 #include "PSP_GPIO.h"
 #include "PSP_RCC.h"
 #include "PSP_TIMx.h"
@@ -55,7 +56,10 @@
 --|----------------------------------------------------------------------------|
 */
 
-/* None */
+_Static_assert(CLOCK_TREE_TIMER_PSC(CLOCK_TREE_TIM2_CLK_HZ, 10000u) <= CLOCK_TREE_TIMER_MAX,
+               "TIM2 clock cannot be divided down to 10kHz");
+_Static_assert(CLOCK_TREE_TIMER_ARR(10000u, 10u) <= CLOCK_TREE_TIMER_MAX,
+               "10kHz cannot be divided down to 10Hz");
 
 /*
 --|----------------------------------------------------------------------------|
@@ -128,10 +132,10 @@ int main(void)
     RCC->APB1ENR |= RCC_APB1ENR_TIM2EN_FLAG;
 
     // use TIM2 prescaler to divide system clock down to 10kHz
-    TIM2->PSC = 3200u - 1u;
+    TIM2->PSC = CLOCK_TREE_TIMER_PSC(CLOCK_TREE_TIM2_CLK_HZ, 10000u);
 
     // use TIM2 auto-reload divide system clock down to 10Hz
-    TIM2->ARR = 1000u - 1u;
+    TIM2->ARR = CLOCK_TREE_TIMER_ARR(10000u, 10u);
 
     // set GPIO A 1 to toggle on a match
     TIM2->CCMR1 |= TIMx_CCMR1_OC2M_TOGGLE << TIMx_CCMR1_OC2M_SHIFT_AMT;
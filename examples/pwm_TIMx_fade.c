@@ -0,0 +1,199 @@
+/*
+--|----------------------------------------------------------------------------|
+--| FILE DESCRIPTION:
+--|   pwm_TIMx_fade.c provides a simple demo which fades a LED in and out
+--|   using PWM from the TIM2 general purpose timer.
+--|  
+--|----------------------------------------------------------------------------|
+--| REFERENCES:
+--|   stm32f10x reference manual, page 365
+--|
+--|----------------------------------------------------------------------------|
+*/
+
+/*
+--|----------------------------------------------------------------------------|
+--| INCLUDE FILES
+--|----------------------------------------------------------------------------|
+*/
+
+#include "PSP_GPIO.h"
+#include "PSP_RCC.h"
+#include "PSP_SysTick.h"
+#include "PSP_TIMx.h"
+
+/*
+--|----------------------------------------------------------------------------|
+--| DEFINES
+--|----------------------------------------------------------------------------|
+*/
+
+/*
+--| NAME: PWM_FREQUENCY_Hz
+--| DESCRIPTION: the PWM frequency, fast enough that the LED does not flicker
+--| TYPE: uint32_t
+*/
+#define PWM_FREQUENCY_Hz (1000u)
+
+/*
+--| NAME: FADE_STEP_TIME_mSec
+--| DESCRIPTION: the time between brightness steps in milliseconds
+--| TYPE: uint32_t
+*/
+#define FADE_STEP_TIME_mSec (2u)
+
+/*
+--| NAME: LED_PIN_NUMBER
+--| DESCRIPTION: the pin number for the LED, TIM2 channel 2
+--| TYPE: uint32_t
+*/
+#define LED_PIN_NUMBER (1u)
+
+/*
+--| NAME: LED_GPIO_PORT
+--| DESCRIPTION: the GPIO port which contains the LED pin
+--| TYPE: GPIO_Port_t*
+*/
+#define LED_GPIO_PORT (GPIO_Port_A)
+
+/*
+--|----------------------------------------------------------------------------|
+--| TYPES
+--|----------------------------------------------------------------------------|
+*/
+
+/* None */
+
+/*
+--|----------------------------------------------------------------------------|
+--| CONSTANTS
+--|----------------------------------------------------------------------------|
+*/
+
+/* None */
+
+/*
+--|----------------------------------------------------------------------------|
+--| VARIABLES
+--|----------------------------------------------------------------------------|
+*/
+
+/*
+--| NAME: fade_timer
+--| DESCRIPTION: periodic timeout timer structure for stepping the brightness
+--| TYPE: SysTick_Timeout_Timer_t
+*/
+SysTick_Timeout_Timer_t fade_timer;
+
+/*
+--| NAME: PWM_init_data
+--| DESCRIPTION: initialization data for the TIM2 PWM time base
+--| TYPE: TIMx_PWM_Initialization_Data_t
+*/
+TIMx_PWM_Initialization_Data_t PWM_init_data =
+{
+    PWM_FREQUENCY_Hz,
+    TIMx_CR1_CMS_EDGE_ALIGNED_MODE
+};
+
+/*
+--| NAME: LED_pin
+--| DESCRIPTION: GPIO pin structure for fading the LED
+--| TYPE: GPIO_Pin_t
+*/
+GPIO_Pin_t LED_pin =
+{
+    LED_GPIO_PORT,
+    LED_PIN_NUMBER
+};
+
+/*
+--| NAME: LED_pin_init_data
+--| DESCRIPTION: initialization data for the LED pin
+--| TYPE: GPIO_Pin_Initialization_Data_t
+*/
+GPIO_Pin_Initialization_Data_t LED_pin_init_data = 
+{
+    GPIO_PIN_CNFy_ALTERNATE_FUNCTION_OUTPUT_PUSH_PULL,
+    GPIO_PIN_MODEy_OUTPUT_10MHz_MAX,
+    GPIO_PIN_NO_PULL_UP_OR_DOWN
+};
+
+/*
+--|----------------------------------------------------------------------------|
+--| FUNCTION PROTOTYPES
+--|----------------------------------------------------------------------------|
+*/
+
+/*------------------------------------------------------------------------------
+Function Name:
+    main
+
+Function Description:
+    main application function which fades the LED in an endless loop. 
+
+Parameters:
+    None
+
+Returns:
+    int [return is never reached]
+
+Assumptions/Limitations:
+    None
+------------------------------------------------------------------------------*/
+int main(void);
+
+/*
+--|----------------------------------------------------------------------------|
+--| FUNCTION DEFINITIONS
+--|----------------------------------------------------------------------------|
+*/
+
+int main(void)
+{
+    // enable the clock control for GPIO port A
+    RCC->APB2ENR |= RCC_APB2ENR_IOPAEN_FLAG;
+
+    // set the led pin as alternate function output    
+    PSP_GPIO_Set_Pin_Mode(&LED_pin, &LED_pin_init_data);
+
+    // enable timer 2 clock
+    RCC->APB1ENR |= RCC_APB1ENR_TIM2EN_FLAG;
+
+    TIMx_PWM_Init(TIM2, &PWM_init_data);
+
+    // GPIO A 1 is TIM2 channel 2
+    TIMx_PWM_Channel_Init(TIM2, TIMx_CHANNEL_2, TIMx_OUTPUT_ACTIVE_HIGH, 0u);
+
+    TIMx_Start(TIM2);
+
+    fade_timer.timeout_period_mSec = FADE_STEP_TIME_mSec;
+
+    SysTick_Start_Timeout_Timer(&fade_timer);
+
+    uint32_t duty_permille = 0u;
+    bool     getting_brighter = true;
+
+    while (1)
+    {
+        if (SysTick_Poll_Periodic_Timer(&fade_timer))
+        {
+            if (getting_brighter)
+            {
+                duty_permille++;
+                getting_brighter = (duty_permille < 1000u);
+            }
+            else
+            {
+                duty_permille--;
+                getting_brighter = (duty_permille == 0u);
+            }
+
+            // the compare register is preloaded, so the change is glitch-free
+            TIMx_PWM_Set_Duty_Permille(TIM2, TIMx_CHANNEL_2, duty_permille);
+        }
+    }
+
+    // never reached
+    return 0;
+}
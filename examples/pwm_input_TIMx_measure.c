@@ -0,0 +1,214 @@
+/*
+--|----------------------------------------------------------------------------|
+--| FILE DESCRIPTION:
+--|   pwm_input_TIMx_measure.c provides a simple demo which measures the
+--|   frequency and duty cycle of a PWM signal using TIM3 in PWM input mode.
+--|  
+--|----------------------------------------------------------------------------|
+--| REFERENCES:
+--|   stm32f10x reference manual, page 380
+--|
+--|----------------------------------------------------------------------------|
+*/
+
+/*
+--|----------------------------------------------------------------------------|
+--| INCLUDE FILES
+--|----------------------------------------------------------------------------|
+*/
+
+#include "PSP_GPIO.h"
+#include "PSP_NVIC.h"
+#include "PSP_RCC.h"
+#include "PSP_TIMx.h"
+
+/*
+--|----------------------------------------------------------------------------|
+--| DEFINES
+--|----------------------------------------------------------------------------|
+*/
+
+/*
+--| NAME: CAPTURE_TICK_Hz
+--| DESCRIPTION: the capture counter frequency, 1 uSec resolution
+--| TYPE: uint32_t
+*/
+#define CAPTURE_TICK_Hz (1000000u)
+
+/*
+--| NAME: INPUT_PIN_NUMBER
+--| DESCRIPTION: the pin number for the PWM input, TIM3 channel 1
+--| TYPE: uint32_t
+*/
+#define INPUT_PIN_NUMBER (6u)
+
+/*
+--| NAME: INPUT_GPIO_PORT
+--| DESCRIPTION: the GPIO port which contains the input pin
+--| TYPE: GPIO_Port_t*
+*/
+#define INPUT_GPIO_PORT (GPIO_Port_A)
+
+/*
+--|----------------------------------------------------------------------------|
+--| TYPES
+--|----------------------------------------------------------------------------|
+*/
+
+/* None */
+
+/*
+--|----------------------------------------------------------------------------|
+--| CONSTANTS
+--|----------------------------------------------------------------------------|
+*/
+
+/* None */
+
+/*
+--|----------------------------------------------------------------------------|
+--| VARIABLES
+--|----------------------------------------------------------------------------|
+*/
+
+/*
+--| NAME: capture_handle
+--| DESCRIPTION: the TIM3 PWM input measurements
+--| TYPE: TIMx_Capture_Handle_t
+*/
+TIMx_Capture_Handle_t capture_handle =
+{
+    .p_TIMx  = TIM3,
+    .channel = TIMx_CHANNEL_1
+};
+
+/*
+--| NAME: capture_init_data
+--| DESCRIPTION: initialization data for the TIM3 PWM input
+--| TYPE: TIMx_Input_Capture_Initialization_Data_t
+*/
+TIMx_Input_Capture_Initialization_Data_t capture_init_data =
+{
+    CAPTURE_TICK_Hz,
+    TIMx_CCMR1_IC1F_FILTER_MODE_2,
+    TIMx_CCMR1_IC1PSC_NO_PRESCALER,
+    TIMx_CAPTURE_RISING_EDGE
+};
+
+/*
+--| NAME: input_pin
+--| DESCRIPTION: GPIO pin structure for the PWM input
+--| TYPE: GPIO_Pin_t
+*/
+GPIO_Pin_t input_pin =
+{
+    INPUT_GPIO_PORT,
+    INPUT_PIN_NUMBER
+};
+
+/*
+--| NAME: input_pin_init_data
+--| DESCRIPTION: initialization data for the input pin
+--| TYPE: GPIO_Pin_Initialization_Data_t
+*/
+GPIO_Pin_Initialization_Data_t input_pin_init_data = 
+{
+    GPIO_PIN_CNFy_FLOATING_INPUT,
+    GPIO_PIN_MODEy_INPUT_MODE,
+    GPIO_PIN_NO_PULL_UP_OR_DOWN
+};
+
+/*
+--| NAME: frequency_Hz
+--| DESCRIPTION: the last measured input frequency, for watching in a debugger
+--| TYPE: uint32_t
+*/
+volatile uint32_t frequency_Hz;
+
+/*
+--| NAME: duty_permille
+--| DESCRIPTION: the last measured input duty cycle, for watching in a debugger
+--| TYPE: uint32_t
+*/
+volatile uint32_t duty_permille;
+
+/*
+--|----------------------------------------------------------------------------|
+--| FUNCTION PROTOTYPES
+--|----------------------------------------------------------------------------|
+*/
+
+/*------------------------------------------------------------------------------
+Function Name:
+    main
+
+Function Description:
+    main application function which measures the input in an endless loop. 
+
+Parameters:
+    None
+
+Returns:
+    int [return is never reached]
+
+Assumptions/Limitations:
+    None
+------------------------------------------------------------------------------*/
+int main(void);
+
+/*------------------------------------------------------------------------------
+Function Name:
+    TIM3_IRQ_handler
+
+Function Description:
+    TIM3 global interrupt handler, which processes the captures.
+
+Parameters:
+    None
+
+Returns:
+    None
+
+Assumptions/Limitations:
+    None
+------------------------------------------------------------------------------*/
+void TIM3_IRQ_handler(void);
+
+/*
+--|----------------------------------------------------------------------------|
+--| FUNCTION DEFINITIONS
+--|----------------------------------------------------------------------------|
+*/
+
+int main(void)
+{
+    // enable the clock control for GPIO port A
+    RCC->APB2ENR |= RCC_APB2ENR_IOPAEN_FLAG;
+
+    // set the input pin as a floating input
+    PSP_GPIO_Set_Pin_Mode(&input_pin, &input_pin_init_data);
+
+    // enable timer 3 clock
+    RCC->APB1ENR |= RCC_APB1ENR_TIM3EN_FLAG;
+
+    TIMx_PWM_Input_Init(&capture_handle, &capture_init_data);
+
+    // enable the TIM3 interrupt
+    NVIC_Enable_IRQ(TIM3_IRQn);
+
+    TIMx_Start(TIM3);
+
+    while (1)
+    {
+        frequency_Hz  = TIMx_Capture_Get_Frequency_Hz(&capture_handle);
+        duty_permille = TIMx_Capture_Get_Duty_Permille(&capture_handle);
+    }
+
+    // never reached
+    return 0;
+}
+
+void TIM3_IRQ_handler(void)
+{
+    TIMx_PWM_Input_IRQ_Handler(&capture_handle);
+}
@@ -0,0 +1,296 @@
+/*
+--|----------------------------------------------------------------------------|
+--| FILE DESCRIPTION:
+--|   usart_DMA_echo.c provides a simple demo which echoes every frame
+--|   received on USART1 back to the sender, using DMA in both directions.
+--|  
+--|----------------------------------------------------------------------------|
+--| REFERENCES:
+--|   stm32f10x reference manual, page 771
+--|
+--|----------------------------------------------------------------------------|
+*/
+
+/*
+--|----------------------------------------------------------------------------|
+--| INCLUDE FILES
+--|----------------------------------------------------------------------------|
+*/
+
+#include <stddef.h>
+
+#include "PSP_Core_Instructions.h"
+#include "PSP_GPIO.h"
+#include "PSP_NVIC.h"
+#include "PSP_RCC.h"
+#include "PSP_USART.h"
+
+/*
+--|----------------------------------------------------------------------------|
+--| DEFINES
+--|----------------------------------------------------------------------------|
+*/
+
+/*
+--| NAME: BAUD_RATE
+--| DESCRIPTION: the USART1 baud rate
+--| TYPE: uint32_t
+*/
+#define BAUD_RATE (2000000u)
+
+/*
+--| NAME: RX_BUFFER_SIZE
+--| DESCRIPTION: the size of the circular receive buffer in bytes
+--| TYPE: uint32_t
+*/
+#define RX_BUFFER_SIZE (256u)
+
+/*
+--| NAME: TX_PIN_NUMBER
+--| DESCRIPTION: the pin number for the USART1 TX output
+--| TYPE: uint32_t
+*/
+#define TX_PIN_NUMBER (9u)
+
+/*
+--| NAME: RX_PIN_NUMBER
+--| DESCRIPTION: the pin number for the USART1 RX input
+--| TYPE: uint32_t
+*/
+#define RX_PIN_NUMBER (10u)
+
+/*
+--| NAME: USART_GPIO_PORT
+--| DESCRIPTION: the GPIO port which contains the USART1 pins
+--| TYPE: GPIO_Port_t*
+*/
+#define USART_GPIO_PORT (GPIO_Port_A)
+
+/*
+--|----------------------------------------------------------------------------|
+--| TYPES
+--|----------------------------------------------------------------------------|
+*/
+
+/* None */
+
+/*
+--|----------------------------------------------------------------------------|
+--| CONSTANTS
+--|----------------------------------------------------------------------------|
+*/
+
+/* None */
+
+/*
+--|----------------------------------------------------------------------------|
+--| VARIABLES
+--|----------------------------------------------------------------------------|
+*/
+
+/*
+--| NAME: rx_buffer
+--| DESCRIPTION: the circular receive buffer, written by DMA
+--| TYPE: uint8_t[]
+*/
+uint8_t rx_buffer[RX_BUFFER_SIZE];
+
+/*
+--| NAME: usart_handle
+--| DESCRIPTION: the USART1 handle
+--| TYPE: USART_Handle_t
+*/
+USART_Handle_t usart_handle =
+{
+    .p_USART = USART1
+};
+
+/*
+--| NAME: tx_pin
+--| DESCRIPTION: GPIO pin structure for the TX output
+--| TYPE: GPIO_Pin_t
+*/
+GPIO_Pin_t tx_pin =
+{
+    USART_GPIO_PORT,
+    TX_PIN_NUMBER
+};
+
+/*
+--| NAME: rx_pin
+--| DESCRIPTION: GPIO pin structure for the RX input
+--| TYPE: GPIO_Pin_t
+*/
+GPIO_Pin_t rx_pin =
+{
+    USART_GPIO_PORT,
+    RX_PIN_NUMBER
+};
+
+/*
+--| NAME: tx_pin_init_data
+--| DESCRIPTION: initialization data for the TX pin
+--| TYPE: GPIO_Pin_Initialization_Data_t
+*/
+GPIO_Pin_Initialization_Data_t tx_pin_init_data = 
+{
+    GPIO_PIN_CNFy_ALTERNATE_FUNCTION_OUTPUT_PUSH_PULL,
+    GPIO_PIN_MODEy_OUTPUT_50MHz_MAX,
+    GPIO_PIN_NO_PULL_UP_OR_DOWN
+};
+
+/*
+--| NAME: rx_pin_init_data
+--| DESCRIPTION: initialization data for the RX pin
+--| TYPE: GPIO_Pin_Initialization_Data_t
+*/
+GPIO_Pin_Initialization_Data_t rx_pin_init_data = 
+{
+    GPIO_PIN_CNFy_FLOATING_INPUT,
+    GPIO_PIN_MODEy_INPUT_MODE,
+    GPIO_PIN_NO_PULL_UP_OR_DOWN
+};
+
+/*
+--| NAME: frames_received
+--| DESCRIPTION: the number of frames received, for watching in a debugger
+--| TYPE: uint32_t
+*/
+volatile uint32_t frames_received;
+
+/*
+--|----------------------------------------------------------------------------|
+--| FUNCTION PROTOTYPES
+--|----------------------------------------------------------------------------|
+*/
+
+/*------------------------------------------------------------------------------
+Function Name:
+    main
+
+Function Description:
+    main application function which sets up USART1 and sleeps, all of the
+    work is done by DMA and the interrupt handlers.
+
+Parameters:
+    None
+
+Returns:
+    int [return is never reached]
+
+Assumptions/Limitations:
+    None
+------------------------------------------------------------------------------*/
+int main(void);
+
+/*------------------------------------------------------------------------------
+Function Name:
+    Echo_RX_Callback
+
+Function Description:
+    Queue received data straight from the receive buffer to be sent back.
+
+Parameters:
+    p_context: unused.
+    p_data: the received data, in the receive buffer.
+    length: the number of bytes.
+    frame_end: true if the line has gone idle.
+
+Returns:
+    None
+
+Assumptions/Limitations:
+    The data is sent in place, which is safe as long as the sender leaves
+    a gap before it has sent another half buffer. Data is dropped if the
+    transmit queue is full.
+------------------------------------------------------------------------------*/
+void Echo_RX_Callback(void * p_context, const uint8_t * p_data, uint32_t length, bool frame_end);
+
+/*------------------------------------------------------------------------------
+Function Name:
+    USART1_IRQ_handler, DMA1_chan4_IRQ_handler, DMA1_chan5_IRQ_handler
+
+Function Description:
+    USART1 and its transmit and receive DMA channel interrupt handlers.
+
+Parameters:
+    None
+
+Returns:
+    None
+
+Assumptions/Limitations:
+    None
+------------------------------------------------------------------------------*/
+void USART1_IRQ_handler(void);
+void DMA1_chan4_IRQ_handler(void);
+void DMA1_chan5_IRQ_handler(void);
+
+/*
+--|----------------------------------------------------------------------------|
+--| FUNCTION DEFINITIONS
+--|----------------------------------------------------------------------------|
+*/
+
+int main(void)
+{
+    USART_Initialization_Data_t usart_init_data =
+    {
+        BAUD_RATE,
+        rx_buffer,
+        RX_BUFFER_SIZE,
+        Echo_RX_Callback,
+        NULL
+    };
+
+    // enable the clock control for GPIO port A and USART1
+    RCC->APB2ENR |= RCC_APB2ENR_IOPAEN_FLAG | RCC_APB2ENR_USART1EN_FLAG;
+
+    PSP_GPIO_Set_Pin_Mode(&tx_pin, &tx_pin_init_data);
+    PSP_GPIO_Set_Pin_Mode(&rx_pin, &rx_pin_init_data);
+
+    (void)USART_Init(&usart_handle, &usart_init_data);
+
+    // the three handlers share the handle, so they must not preempt each other
+    NVIC_Enable_IRQ(USART1_IRQn);
+    NVIC_Enable_IRQ(DMA1_Channel4_IRQn);
+    NVIC_Enable_IRQ(DMA1_Channel5_IRQn);
+
+    while (1)
+    {
+        Core_Wait_For_Interrupt();
+    }
+
+    // never reached
+    return 0;
+}
+
+void Echo_RX_Callback(void * p_context, const uint8_t * p_data, uint32_t length, bool frame_end)
+{
+    (void)p_context;
+
+    if (length > 0u)
+    {
+        (void)USART_Write(&usart_handle, p_data, length);
+    }
+
+    if (frame_end)
+    {
+        frames_received++;
+    }
+}
+
+void USART1_IRQ_handler(void)
+{
+    USART_IRQ_Handler(&usart_handle);
+}
+
+void DMA1_chan4_IRQ_handler(void)
+{
+    USART_IRQ_Handler(&usart_handle);
+}
+
+void DMA1_chan5_IRQ_handler(void)
+{
+    USART_IRQ_Handler(&usart_handle);
+}
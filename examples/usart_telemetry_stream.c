@@ -0,0 +1,252 @@
+/*
+--|----------------------------------------------------------------------------|
+--| FILE DESCRIPTION:
+--|   usart_telemetry_stream.c provides a simple demo which streams binary
+--|   telemetry records on USART1 TX, to be read on a host with
+--|   tools/telemetry_decode.c.
+--|  
+--|----------------------------------------------------------------------------|
+--| REFERENCES:
+--|   stm32f10x reference manual, page 771
+--|
+--|----------------------------------------------------------------------------|
+*/
+
+/*
+--|----------------------------------------------------------------------------|
+--| INCLUDE FILES
+--|----------------------------------------------------------------------------|
+*/
+
+#include <stddef.h>
+
+#include "PSP_GPIO.h"
+#include "PSP_NVIC.h"
+#include "PSP_RCC.h"
+#include "PSP_SysTick.h"
+#include "PSP_Telemetry.h"
+#include "PSP_USART.h"
+
+/*
+--|----------------------------------------------------------------------------|
+--| DEFINES
+--|----------------------------------------------------------------------------|
+*/
+
+/*
+--| NAME: BAUD_RATE
+--| DESCRIPTION: the USART1 baud rate
+--| TYPE: uint32_t
+*/
+#define BAUD_RATE (2000000u)
+
+/*
+--| NAME: TELEMETRY_BUFFER_SIZE
+--| DESCRIPTION: the size of the buffer of records waiting to be sent, in
+--|   bytes, a power of 2
+--| TYPE: uint32_t
+*/
+#define TELEMETRY_BUFFER_SIZE (1024u)
+
+/*
+--| NAME: SAMPLE_PERIOD_mSec
+--| DESCRIPTION: the time between sample records
+--| TYPE: uint32_t
+*/
+#define SAMPLE_PERIOD_mSec (10u)
+
+/*
+--| NAME: TX_PIN_NUMBER
+--| DESCRIPTION: the pin number for the USART1 TX output
+--| TYPE: uint32_t
+*/
+#define TX_PIN_NUMBER (9u)
+
+/*
+--| NAME: USART_GPIO_PORT
+--| DESCRIPTION: the GPIO port which contains the USART1 pins
+--| TYPE: GPIO_Port_t*
+*/
+#define USART_GPIO_PORT (GPIO_Port_A)
+
+/*
+--|----------------------------------------------------------------------------|
+--| TYPES
+--|----------------------------------------------------------------------------|
+*/
+
+/* None */
+
+/*
+--|----------------------------------------------------------------------------|
+--| CONSTANTS
+--|----------------------------------------------------------------------------|
+*/
+
+/*
+--| NAME: start_message
+--| DESCRIPTION: text record sent once at startup
+--| TYPE: char[]
+*/
+static const char start_message[] = "telemetry stream started";
+
+/*
+--|----------------------------------------------------------------------------|
+--| VARIABLES
+--|----------------------------------------------------------------------------|
+*/
+
+/*
+--| NAME: telemetry_buffer
+--| DESCRIPTION: the buffer of encoded records waiting to be sent by DMA
+--| TYPE: uint8_t[]
+*/
+uint8_t telemetry_buffer[TELEMETRY_BUFFER_SIZE];
+
+/*
+--| NAME: telemetry
+--| DESCRIPTION: the telemetry stream
+--| TYPE: Telemetry_t
+*/
+Telemetry_t telemetry;
+
+/*
+--| NAME: usart_handle
+--| DESCRIPTION: the USART1 handle
+--| TYPE: USART_Handle_t
+*/
+USART_Handle_t usart_handle =
+{
+    .p_USART = USART1
+};
+
+/*
+--| NAME: sample_timer
+--| DESCRIPTION: periodic timeout timer structure for scheduling the samples
+--| TYPE: SysTick_Timeout_Timer_t
+*/
+SysTick_Timeout_Timer_t sample_timer;
+
+/*
+--| NAME: tx_pin
+--| DESCRIPTION: GPIO pin structure for the TX output
+--| TYPE: GPIO_Pin_t
+*/
+GPIO_Pin_t tx_pin =
+{
+    USART_GPIO_PORT,
+    TX_PIN_NUMBER
+};
+
+/*
+--| NAME: tx_pin_init_data
+--| DESCRIPTION: initialization data for the TX pin
+--| TYPE: GPIO_Pin_Initialization_Data_t
+*/
+GPIO_Pin_Initialization_Data_t tx_pin_init_data = 
+{
+    GPIO_PIN_CNFy_ALTERNATE_FUNCTION_OUTPUT_PUSH_PULL,
+    GPIO_PIN_MODEy_OUTPUT_50MHz_MAX,
+    GPIO_PIN_NO_PULL_UP_OR_DOWN
+};
+
+/*
+--|----------------------------------------------------------------------------|
+--| FUNCTION PROTOTYPES
+--|----------------------------------------------------------------------------|
+*/
+
+/*------------------------------------------------------------------------------
+Function Name:
+    main
+
+Function Description:
+    main application function which sets up USART1 and the telemetry
+    stream, then sends the uptime and the dropped record count as a
+    record every SAMPLE_PERIOD_mSec.
+
+Parameters:
+    None
+
+Returns:
+    int [return is never reached]
+
+Assumptions/Limitations:
+    None
+------------------------------------------------------------------------------*/
+int main(void);
+
+/*------------------------------------------------------------------------------
+Function Name:
+    DMA1_chan4_IRQ_handler
+
+Function Description:
+    USART1 transmit DMA channel interrupt handler.
+
+Parameters:
+    None
+
+Returns:
+    None
+
+Assumptions/Limitations:
+    None
+------------------------------------------------------------------------------*/
+void DMA1_chan4_IRQ_handler(void);
+
+/*
+--|----------------------------------------------------------------------------|
+--| FUNCTION DEFINITIONS
+--|----------------------------------------------------------------------------|
+*/
+
+int main(void)
+{
+    USART_Initialization_Data_t usart_init_data =
+    {
+        BAUD_RATE,
+        NULL,
+        0u,
+        NULL,
+        NULL
+    };
+
+    // enable the clock control for GPIO port A, USART1 and the CRC unit
+    RCC->APB2ENR |= RCC_APB2ENR_IOPAEN_FLAG | RCC_APB2ENR_USART1EN_FLAG;
+    RCC->AHBENR  |= RCC_AHBENR_CRCEN_FLAG;
+
+    PSP_GPIO_Set_Pin_Mode(&tx_pin, &tx_pin_init_data);
+
+    (void)USART_Init(&usart_handle, &usart_init_data);
+    NVIC_Enable_IRQ(DMA1_Channel4_IRQn);
+
+    (void)Telemetry_Init(&telemetry, &usart_handle, telemetry_buffer, TELEMETRY_BUFFER_SIZE);
+    (void)Telemetry_Send(&telemetry, TELEMETRY_RECORD_TYPE_TEXT, start_message, sizeof(start_message) - 1u);
+
+    sample_timer.timeout_period_mSec = SAMPLE_PERIOD_mSec;
+    SysTick_Start_Timeout_Timer(&sample_timer);
+
+    while (1)
+    {
+        if (SysTick_Poll_Periodic_Timer(&sample_timer))
+        {
+            const uint32_t sample[2] =
+            {
+                SysTick_Get_mSec(),
+                Telemetry_Get_Dropped(&telemetry)
+            };
+
+            (void)Telemetry_Send(&telemetry, TELEMETRY_RECORD_TYPE_U32, sample, sizeof(sample));
+        }
+
+        Telemetry_Flush(&telemetry);
+    }
+
+    // never reached
+    return 0;
+}
+
+void DMA1_chan4_IRQ_handler(void)
+{
+    USART_IRQ_Handler(&usart_handle);
+}
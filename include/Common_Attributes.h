@@ -0,0 +1,79 @@
+/*
+--|----------------------------------------------------------------------------|
+--| FILE DESCRIPTION:
+--|   Common_Attributes.h provides common compiler attributes.
+--|   
+--|----------------------------------------------------------------------------|
+--| REFERENCES:
+--|   None.
+--|
+--|----------------------------------------------------------------------------|
+*/
+
+#ifndef COMMON_ATTRIBUTES_H_INCLUDED
+#define COMMON_ATTRIBUTES_H_INCLUDED
+
+/*
+--|----------------------------------------------------------------------------|
+--| INCLUDE FILES
+--|----------------------------------------------------------------------------|
+*/
+
+/* None */
+
+/*
+--|----------------------------------------------------------------------------|
+--| PUBLIC DEFINES
+--|----------------------------------------------------------------------------|
+*/
+
+/*
+--| NAME: RAMFUNC
+--| DESCRIPTION: place a function in the .ramfunc section, which reset_handler
+--|   copies from flash to SRAM, so it runs without flash wait states. SRAM
+--|   is out of BL range of flash, so calls to it are made as long calls
+--| TYPE: function attribute
+*/
+#define RAMFUNC __attribute__((section(".ramfunc"), long_call, noinline))
+
+/*
+--| NAME: WEAK
+--| DESCRIPTION: make a function a default, which the application replaces
+--|   by defining a function of the same name
+--| TYPE: function attribute
+*/
+#define WEAK __attribute__((weak))
+
+/*
+--|----------------------------------------------------------------------------|
+--| PUBLIC TYPES
+--|----------------------------------------------------------------------------|
+*/
+
+/* None */
+
+/*
+--|----------------------------------------------------------------------------|
+--| PUBLIC CONSTANTS
+--|----------------------------------------------------------------------------|
+*/
+
+/* None */
+
+/*
+--|----------------------------------------------------------------------------|
+--| PUBLIC VARIABLES
+--|----------------------------------------------------------------------------|
+*/
+
+/* None */
+
+/*
+--|----------------------------------------------------------------------------|
+--| PUBLIC FUNCTION PROTOTYPES
+--|----------------------------------------------------------------------------|
+*/
+
+/* None */
+
+#endif
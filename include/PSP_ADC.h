@@ -0,0 +1,385 @@
+/*
+--|----------------------------------------------------------------------------|
+--| FILE DESCRIPTION:
+--|   PSP_ADC.h provides types and interfaces for ADC1, sampling a scan
+--|   sequence of channels on a hardware trigger into a circular DMA double
+--|   buffer.
+--|
+--|----------------------------------------------------------------------------|
+--| REFERENCES:
+--|   stm32f10x reference manual, page 215
+--|
+--|----------------------------------------------------------------------------|
+*/
+
+#ifndef PSP_ADC_H_INCLUDED
+#define PSP_ADC_H_INCLUDED
+
+/*
+--|----------------------------------------------------------------------------|
+--| INCLUDE FILES
+--|----------------------------------------------------------------------------|
+*/
+
+#include "Common_Typedefs.h"
+#include "PSP_Peripherals_Memory_Map.h"
+
+/*
+--|----------------------------------------------------------------------------|
+--| PUBLIC DEFINES
+--|----------------------------------------------------------------------------|
+*/
+
+/*
+--| NAME: ADC1
+--| DESCRIPTION: pointer to analog to digital converter 1
+--| TYPE: ADC_t*
+*/
+#define ADC1 ((volatile ADC_t *)PSP_PERIPHERAL_ADC1_BASE)
+
+/*
+--| NAME: ADC2
+--| DESCRIPTION: pointer to analog to digital converter 2, which has no DMA
+--|   request of its own
+--| TYPE: ADC_t*
+*/
+#define ADC2 ((volatile ADC_t *)PSP_PERIPHERAL_ADC2_BASE)
+
+/*
+--| NAME: ADC_MAX_SEQUENCE_LENGTH
+--| DESCRIPTION: the most conversions in one scan of the regular sequence
+--| TYPE: unsigned integer
+*/
+#define ADC_MAX_SEQUENCE_LENGTH (16u)
+
+/*
+--| NAME: ADC_MAX_CHANNEL
+--| DESCRIPTION: the highest input channel, 16 is the temperature sensor and
+--|   17 is the internal reference
+--| TYPE: unsigned integer
+*/
+#define ADC_MAX_CHANNEL (17u)
+
+/*
+--|----------------------------------------------------------------------------|
+--| PUBLIC TYPES
+--|----------------------------------------------------------------------------|
+*/
+
+/*
+--| NAME: ADC_t
+--| DESCRIPTION: analog to digital converter structure
+*/
+typedef struct ADC_Type
+{
+    vuint32_t SR;    // status register
+    vuint32_t CR1;   // control register 1
+    vuint32_t CR2;   // control register 2
+    vuint32_t SMPR1; // sample time register 1 [channels 10 to 17]
+    vuint32_t SMPR2; // sample time register 2 [channels 0 to 9]
+    vuint32_t JOFR1; // injected channel data offset register 1 [12 bits]
+    vuint32_t JOFR2; // injected channel data offset register 2 [12 bits]
+    vuint32_t JOFR3; // injected channel data offset register 3 [12 bits]
+    vuint32_t JOFR4; // injected channel data offset register 4 [12 bits]
+    vuint32_t HTR;   // watchdog high threshold register [12 bits]
+    vuint32_t LTR;   // watchdog low threshold register [12 bits]
+    vuint32_t SQR1;  // regular sequence register 1 [length, conversions 13 to 16]
+    vuint32_t SQR2;  // regular sequence register 2 [conversions 7 to 12]
+    vuint32_t SQR3;  // regular sequence register 3 [conversions 1 to 6]
+    vuint32_t JSQR;  // injected sequence register
+    vuint32_t JDR1;  // injected data register 1 [16 bits, r]
+    vuint32_t JDR2;  // injected data register 2 [16 bits, r]
+    vuint32_t JDR3;  // injected data register 3 [16 bits, r]
+    vuint32_t JDR4;  // injected data register 4 [16 bits, r]
+    vuint32_t DR;    // regular data register [r]
+} ADC_t;
+
+/*
+--| NAME: ADC_SR_FLAGS_enum
+--| DESCRIPTION: ADC status register flags
+*/
+typedef enum ADC_SR_FLAGS_Enumeration
+{
+    ADC_SR_STRT_FLAG  = (1u << 4u), // regular channel start flag [rc_w0]
+    ADC_SR_JSTRT_FLAG = (1u << 3u), // injected channel start flag [rc_w0]
+    ADC_SR_JEOC_FLAG  = (1u << 2u), // injected channel end of conversion [rc_w0]
+    ADC_SR_EOC_FLAG   = (1u << 1u), // end of conversion [rc_w0]
+    ADC_SR_AWD_FLAG   = (1u << 0u), // analog watchdog flag [rc_w0]
+} ADC_SR_FLAGS_enum;
+
+/*
+--| NAME: ADC_CR1_FLAGS_enum
+--| DESCRIPTION: ADC control register 1 flags
+*/
+typedef enum ADC_CR1_FLAGS_Enumeration
+{
+    ADC_CR1_AWDEN_FLAG   = (1u << 23u), // analog watchdog enable on regular channels [rw]
+    ADC_CR1_JAWDEN_FLAG  = (1u << 22u), // analog watchdog enable on injected channels [rw]
+    ADC_CR1_JDISCEN_FLAG = (1u << 12u), // discontinuous mode on injected channels [rw]
+    ADC_CR1_DISCEN_FLAG  = (1u << 11u), // discontinuous mode on regular channels [rw]
+    ADC_CR1_JAUTO_FLAG   = (1u << 10u), // automatic injected group conversion [rw]
+    ADC_CR1_AWDSGL_FLAG  = (1u << 9u),  // analog watchdog on a single channel [rw]
+    ADC_CR1_SCAN_FLAG    = (1u << 8u),  // scan mode [rw]
+    ADC_CR1_JEOCIE_FLAG  = (1u << 7u),  // interrupt enable for injected channels [rw]
+    ADC_CR1_AWDIE_FLAG   = (1u << 6u),  // analog watchdog interrupt enable [rw]
+    ADC_CR1_EOCIE_FLAG   = (1u << 5u),  // interrupt enable for EOC [rw]
+} ADC_CR1_FLAGS_enum;
+
+/*
+--| NAME: ADC_CR2_FLAGS_enum
+--| DESCRIPTION: ADC control register 2 flags
+*/
+typedef enum ADC_CR2_FLAGS_Enumeration
+{
+    ADC_CR2_TSVREFE_FLAG  = (1u << 23u), // temperature sensor and VREFINT enable [rw]
+    ADC_CR2_SWSTART_FLAG  = (1u << 22u), // start conversion of regular channels [rw]
+    ADC_CR2_JSWSTART_FLAG = (1u << 21u), // start conversion of injected channels [rw]
+    ADC_CR2_EXTTRIG_FLAG  = (1u << 20u), // external trigger conversion mode for regular channels [rw]
+    ADC_CR2_JEXTTRIG_FLAG = (1u << 15u), // external trigger conversion mode for injected channels [rw]
+    ADC_CR2_ALIGN_FLAG    = (1u << 11u), // 0: right alignment, 1: left alignment [rw]
+    ADC_CR2_DMA_FLAG      = (1u << 8u),  // direct memory access mode [rw]
+    ADC_CR2_RSTCAL_FLAG   = (1u << 3u),  // reset calibration [rw]
+    ADC_CR2_CAL_FLAG      = (1u << 2u),  // A/D calibration [rw]
+    ADC_CR2_CONT_FLAG     = (1u << 1u),  // continuous conversion [rw]
+    ADC_CR2_ADON_FLAG     = (1u << 0u),  // A/D converter on / off [rw]
+} ADC_CR2_FLAGS_enum;
+
+/*
+--| NAME: ADC_CR2_EXTSEL_MASKS_enum
+--| DESCRIPTION: ADC CR2 external event select for the regular group of ADC1
+--|   and ADC2 [3 bits, rw]
+*/
+typedef enum ADC_CR2_EXTSEL_MASKS_Enumeration
+{
+    ADC_CR2_EXTSEL_TIM1_CC1  = 0b000u, // timer 1 CC1 event
+    ADC_CR2_EXTSEL_TIM1_CC2  = 0b001u, // timer 1 CC2 event
+    ADC_CR2_EXTSEL_TIM1_CC3  = 0b010u, // timer 1 CC3 event
+    ADC_CR2_EXTSEL_TIM2_CC2  = 0b011u, // timer 2 CC2 event
+    ADC_CR2_EXTSEL_TIM3_TRGO = 0b100u, // timer 3 TRGO event
+    ADC_CR2_EXTSEL_TIM4_CC4  = 0b101u, // timer 4 CC4 event
+    ADC_CR2_EXTSEL_EXTI11    = 0b110u, // EXTI line 11
+    ADC_CR2_EXTSEL_SWSTART   = 0b111u, // SWSTART
+    ADC_CR2_EXTSEL_SHIFT_AMT = 17u,    // position of EXTSEL in ADC CR2
+} ADC_CR2_EXTSEL_MASKS_enum;
+
+/*
+--| NAME: ADC_SMPR_MASKS_enum
+--| DESCRIPTION: ADC SMPRx channel sample time in ADC clock cycles [3 bits
+--|   per channel, rw]. Each conversion takes the sample time plus 12.5 cycles.
+*/
+typedef enum ADC_SMPR_MASKS_Enumeration
+{
+    ADC_SMPR_1_5_CYCLES   = 0b000u, // 1.5 cycles
+    ADC_SMPR_7_5_CYCLES   = 0b001u, // 7.5 cycles
+    ADC_SMPR_13_5_CYCLES  = 0b010u, // 13.5 cycles
+    ADC_SMPR_28_5_CYCLES  = 0b011u, // 28.5 cycles
+    ADC_SMPR_41_5_CYCLES  = 0b100u, // 41.5 cycles
+    ADC_SMPR_55_5_CYCLES  = 0b101u, // 55.5 cycles
+    ADC_SMPR_71_5_CYCLES  = 0b110u, // 71.5 cycles
+    ADC_SMPR_239_5_CYCLES = 0b111u, // 239.5 cycles
+    ADC_SMPR_WIDTH        = 3u,     // bits per channel in SMPRx
+} ADC_SMPR_MASKS_enum;
+
+/*
+--| NAME: ADC_SQR_MASKS_enum
+--| DESCRIPTION: ADC SQRx regular sequence fields [rw]
+*/
+typedef enum ADC_SQR_MASKS_Enumeration
+{
+    ADC_SQR_SQ_WIDTH     = 5u,  // bits per conversion in SQRx
+    ADC_SQR_SQ_PER_REG   = 6u,  // conversions per SQR2 and SQR3
+    ADC_SQR1_L_SHIFT_AMT = 20u, // position of L (sequence length - 1) in ADC SQR1
+} ADC_SQR_MASKS_enum;
+
+/*
+--| NAME: ADC_Half_Callback_t
+--| DESCRIPTION: function called from the DMA interrupt handler with the half
+--|   of the buffer DMA has just filled. The samples are interleaved, scan by
+--|   scan, in sequence order, and are only valid until DMA comes back
+--|   around to this half.
+*/
+typedef void (*ADC_Half_Callback_t)(void * p_context, const uint16_t * p_samples, uint32_t num_scans);
+
+/*
+--| NAME: ADC_Sequence_Entry_t
+--| DESCRIPTION: one conversion in the scan sequence
+*/
+typedef struct ADC_Sequence_Entry_Type
+{
+    uint32_t            channel;     // the input channel [0 to ADC_MAX_CHANNEL]
+    ADC_SMPR_MASKS_enum sample_time; // the sample time of the channel
+} ADC_Sequence_Entry_t;
+
+/*
+--| NAME: ADC_Initialization_Data_t
+--| DESCRIPTION: structure for ADC initialization data
+*/
+typedef struct ADC_Initialization_Data_Type
+{
+    const ADC_Sequence_Entry_t * p_sequence;      // the conversions of one scan, in order
+    uint32_t                     sequence_length; // [1 to ADC_MAX_SEQUENCE_LENGTH]
+    ADC_CR2_EXTSEL_MASKS_enum    trigger;         // starts each scan, SWSTART scans back to back
+    uint16_t *                   p_buffer;        // the double buffer, 2 * scans_per_half * sequence_length samples
+    uint32_t                     scans_per_half;  // scans in each half of the buffer
+    ADC_Half_Callback_t          half_callback;   // called as each half fills
+    void *                       p_context;       // passed to the callback
+} ADC_Initialization_Data_t;
+
+/*
+--| NAME: ADC_Handle_t
+--| DESCRIPTION: handle to ADC1. The members are private to the ADC driver.
+*/
+typedef struct ADC_Handle_Type
+{
+    ADC_CR2_EXTSEL_MASKS_enum trigger;        // starts each scan
+    uint16_t *                p_buffer;       // the double buffer
+    uint32_t                  half_length;    // samples in each half of the buffer
+    uint32_t                  scans_per_half; // scans in each half of the buffer
+    uint32_t                  scan_rate_max;  // the most scans per second the sequence allows
+    ADC_Half_Callback_t       half_callback;  // called as each half fills
+    void *                    p_context;      // passed to the callback
+    volatile uint32_t         overruns;       // halves overwritten before they were handled
+} ADC_Handle_t;
+
+/*
+--|----------------------------------------------------------------------------|
+--| PUBLIC CONSTANTS
+--|----------------------------------------------------------------------------|
+*/
+
+/* None */
+
+/*
+--|----------------------------------------------------------------------------|
+--| PUBLIC VARIABLES
+--|----------------------------------------------------------------------------|
+*/
+
+/* None */
+
+/*
+--|----------------------------------------------------------------------------|
+--| PUBLIC FUNCTION PROTOTYPES
+--|----------------------------------------------------------------------------|
+*/
+
+/*------------------------------------------------------------------------------
+Function Name:
+    ADC_Init
+
+Function Description:
+    Power up and calibrate ADC1, program the scan sequence and sample
+    times, and set DMA1 channel 1 running in circular mode over the double
+    buffer. Sampling starts with ADC_Start.
+
+Parameters:
+    p_handle: pointer to the ADC handle.
+    p_init_data: pointer to the initialization data.
+
+Returns:
+    true if ADC1 was set up, false if the sequence or buffer is invalid.
+
+Assumptions/Limitations:
+    Assumes the ADC1 clock is enabled and the analog pins are configured
+    as analog inputs. The ADC clock (CLOCK_TREE_ADC_CLK_HZ) must be 14 MHz
+    to reach 1 MS/s, with a 1.5 cycle sample time.
+------------------------------------------------------------------------------*/
+bool ADC_Init(ADC_Handle_t * p_handle, ADC_Initialization_Data_t * p_init_data);
+
+/*------------------------------------------------------------------------------
+Function Name:
+    ADC_Start
+
+Function Description:
+    Start sampling. With a timer trigger, each trigger event starts a
+    scan; with SWSTART, scans run back to back.
+
+Parameters:
+    p_handle: pointer to the ADC handle.
+
+Returns:
+    None
+
+Assumptions/Limitations:
+    The triggering timer is set up and started by the caller, for
+    instance TIM3 with its update event as TRGO (TIMx_CR2_MMS_UPDATE).
+------------------------------------------------------------------------------*/
+void ADC_Start(ADC_Handle_t * p_handle);
+
+/*------------------------------------------------------------------------------
+Function Name:
+    ADC_Stop
+
+Function Description:
+    Stop sampling. Further trigger events are ignored, a scan in progress
+    finishes.
+
+Parameters:
+    p_handle: pointer to the ADC handle.
+
+Returns:
+    None
+
+Assumptions/Limitations:
+    None
+------------------------------------------------------------------------------*/
+void ADC_Stop(ADC_Handle_t * p_handle);
+
+/*------------------------------------------------------------------------------
+Function Name:
+    ADC_DMA_IRQ_Handler
+
+Function Description:
+    Hand the half of the buffer DMA has just filled to the callback. Call
+    from DMA1_chan1_IRQ_handler.
+
+Parameters:
+    p_handle: pointer to the ADC handle.
+
+Returns:
+    None
+
+Assumptions/Limitations:
+    The callback must be done with a half before DMA fills the other one.
+------------------------------------------------------------------------------*/
+void ADC_DMA_IRQ_Handler(ADC_Handle_t * p_handle);
+
+/*------------------------------------------------------------------------------
+Function Name:
+    ADC_Get_Max_Scan_Rate_Hz
+
+Function Description:
+    Get the most scans per second the sequence and sample times allow, the
+    trigger rate must not be above it.
+
+Parameters:
+    p_handle: pointer to the ADC handle.
+
+Returns:
+    uint32_t: the scans per second.
+
+Assumptions/Limitations:
+    None
+------------------------------------------------------------------------------*/
+uint32_t ADC_Get_Max_Scan_Rate_Hz(ADC_Handle_t * p_handle);
+
+/*------------------------------------------------------------------------------
+Function Name:
+    ADC_Get_Overruns
+
+Function Description:
+    Get the number of halves DMA overwrote before the interrupt handler
+    got to them.
+
+Parameters:
+    p_handle: pointer to the ADC handle.
+
+Returns:
+    uint32_t: the overruns.
+
+Assumptions/Limitations:
+    None
+------------------------------------------------------------------------------*/
+uint32_t ADC_Get_Overruns(ADC_Handle_t * p_handle);
+
+#endif
@@ -0,0 +1,128 @@
+/*
+--|----------------------------------------------------------------------------|
+--| FILE DESCRIPTION:
+--|   PSP_CRC.h provides types and interfaces for the CRC calculation unit,
+--|   which computes the CRC-32 (polynomial 0x04C11DB7) of 32 bit words.
+--|
+--|----------------------------------------------------------------------------|
+--| REFERENCES:
+--|   stm32f10x reference manual, page 62
+--|
+--|----------------------------------------------------------------------------|
+*/
+
+#ifndef PSP_CRC_H_INCLUDED
+#define PSP_CRC_H_INCLUDED
+
+/*
+--|----------------------------------------------------------------------------|
+--| INCLUDE FILES
+--|----------------------------------------------------------------------------|
+*/
+
+#include "Common_Typedefs.h"
+#include "PSP_Peripherals_Memory_Map.h"
+
+/*
+--|----------------------------------------------------------------------------|
+--| PUBLIC DEFINES
+--|----------------------------------------------------------------------------|
+*/
+
+/*
+--| NAME: CRC
+--| DESCRIPTION: pointer to the CRC calculation unit
+--| TYPE: CRC_t*
+*/
+#define CRC ((volatile CRC_t *)PSP_PERIPHERAL_CRC_BASE)
+
+/*
+--|----------------------------------------------------------------------------|
+--| PUBLIC TYPES
+--|----------------------------------------------------------------------------|
+*/
+
+/*
+--| NAME: CRC_t
+--| DESCRIPTION: CRC calculation unit structure
+*/
+typedef struct CRC_Type
+{
+    vuint32_t DR;  // data register, written with each word, read for the CRC
+    vuint32_t IDR; // independent data register [8 bits]
+    vuint32_t CR;  // control register
+} CRC_t;
+
+/*
+--| NAME: CRC_CR_FLAGS_enum
+--| DESCRIPTION: CRC control register flags
+*/
+typedef enum CRC_CR_FLAGS_Enumeration
+{
+    CRC_CR_RESET_FLAG = (1u << 0u), // reset DR to 0xFFFFFFFF [w]
+} CRC_CR_FLAGS_enum;
+
+/*
+--|----------------------------------------------------------------------------|
+--| PUBLIC CONSTANTS
+--|----------------------------------------------------------------------------|
+*/
+
+/* None */
+
+/*
+--|----------------------------------------------------------------------------|
+--| PUBLIC VARIABLES
+--|----------------------------------------------------------------------------|
+*/
+
+/* None */
+
+/*
+--|----------------------------------------------------------------------------|
+--| PUBLIC FUNCTION PROTOTYPES
+--|----------------------------------------------------------------------------|
+*/
+
+/*------------------------------------------------------------------------------
+Function Name:
+    CRC_Calculate
+
+Function Description:
+    Compute the CRC of a block of words from the initial value 0xFFFFFFFF.
+    Each word is fed most significant bit first, with no reflection and no
+    final XOR (CRC-32/MPEG-2 over the words).
+
+Parameters:
+    p_words: the words.
+    num_words: the number of words.
+
+Returns:
+    uint32_t: the CRC.
+
+Assumptions/Limitations:
+    Assumes the CRC clock is enabled (RCC_AHBENR_CRCEN_FLAG). The unit is
+    shared, so it must not be used from two contexts at once.
+------------------------------------------------------------------------------*/
+uint32_t CRC_Calculate(const uint32_t * p_words, uint32_t num_words);
+
+/*------------------------------------------------------------------------------
+Function Name:
+    CRC_Accumulate
+
+Function Description:
+    Continue the CRC of the previous calls with a further block of words.
+
+Parameters:
+    p_words: the words.
+    num_words: the number of words.
+
+Returns:
+    uint32_t: the CRC of every word since the last CRC_Calculate.
+
+Assumptions/Limitations:
+    Same as CRC_Calculate.
+------------------------------------------------------------------------------*/
+uint32_t CRC_Accumulate(const uint32_t * p_words, uint32_t num_words);
+
+#endif
@@ -0,0 +1,334 @@
+/*
+--|----------------------------------------------------------------------------|
+--| FILE DESCRIPTION:
+--|   PSP_Clock_Tree.h provides a compile-time model of the RCC clock tree.
+--|
+--|   The clock source, PLL multiplier and bus prescalers are selected with
+--|   the CLOCK_TREE_CFG_ defines below (each can be overridden with -D on the
+--|   command line). Every derived clock frequency and register field value is
+--|   computed from those settings, so drivers never need to hand-compute a
+--|   prescaler from a magic number.
+--|
+--|----------------------------------------------------------------------------|
+--| REFERENCES:
+--|   stm32f10x reference manual, page 90, figure 8 (clock tree)
+--|   stm32f10x reference manual, page 100 (RCC_CFGR)
+--|   stm32f103xb datasheet, page 34 (maximum clock frequencies)
+--|
+--|----------------------------------------------------------------------------|
+*/
+
+#ifndef PSP_CLOCK_TREE_H_INCLUDED
+#define PSP_CLOCK_TREE_H_INCLUDED
+
+/*
+--|----------------------------------------------------------------------------|
+--| INCLUDE FILES
+--|----------------------------------------------------------------------------|
+*/
+
+/* None */
+
+/*
+--|----------------------------------------------------------------------------|
+--| PUBLIC DEFINES
+--|----------------------------------------------------------------------------|
+*/
+
+/*
+--| CLOCK SOURCE SELECTIONS
+--| these match the RCC CFGR SW field, so they may be written directly
+*/
+#define CLOCK_TREE_SYSCLK_SOURCE_HSI (0u)
+#define CLOCK_TREE_SYSCLK_SOURCE_HSE (1u)
+#define CLOCK_TREE_SYSCLK_SOURCE_PLL (2u)
+
+/*
+--| PLL SOURCE SELECTIONS
+--| these match the RCC CFGR PLLSRC flag
+*/
+#define CLOCK_TREE_PLL_SOURCE_HSI_DIV_2 (0u)
+#define CLOCK_TREE_PLL_SOURCE_HSE       (1u)
+
+/*
+--| NAME: CLOCK_TREE_HSI_HZ
+--| DESCRIPTION: frequency of the internal high speed oscillator
+--| TYPE: unsigned integer
+*/
+#define CLOCK_TREE_HSI_HZ (8000000u)
+
+/*
+--| NAME: CLOCK_TREE_HSE_HZ
+--| DESCRIPTION: frequency of the external high speed oscillator (board specific)
+--| TYPE: unsigned integer
+*/
+#ifndef CLOCK_TREE_HSE_HZ
+#define CLOCK_TREE_HSE_HZ (8000000u)
+#endif
+
+/*
+--| NAME: CLOCK_TREE_CFG_SYSCLK_SOURCE
+--| DESCRIPTION: the system clock source, one of CLOCK_TREE_SYSCLK_SOURCE_x
+--| TYPE: unsigned integer
+*/
+#ifndef CLOCK_TREE_CFG_SYSCLK_SOURCE
+#define CLOCK_TREE_CFG_SYSCLK_SOURCE (CLOCK_TREE_SYSCLK_SOURCE_PLL)
+#endif
+
+/*
+--| NAME: CLOCK_TREE_CFG_PLL_SOURCE
+--| DESCRIPTION: the PLL input clock, one of CLOCK_TREE_PLL_SOURCE_x
+--| TYPE: unsigned integer
+*/
+#ifndef CLOCK_TREE_CFG_PLL_SOURCE
+#define CLOCK_TREE_CFG_PLL_SOURCE (CLOCK_TREE_PLL_SOURCE_HSI_DIV_2)
+#endif
+
+/*
+--| NAME: CLOCK_TREE_CFG_PLLMUL
+--| DESCRIPTION: the PLL multiplication factor [2 to 16]
+--| TYPE: unsigned integer
+*/
+#ifndef CLOCK_TREE_CFG_PLLMUL
+#define CLOCK_TREE_CFG_PLLMUL (8u)
+#endif
+
+/*
+--| NAME: CLOCK_TREE_CFG_HPRE_DIV
+--| DESCRIPTION: the AHB prescaler [1, 2, 4, 8, 16, 64, 128, 256, 512]
+--| TYPE: unsigned integer
+*/
+#ifndef CLOCK_TREE_CFG_HPRE_DIV
+#define CLOCK_TREE_CFG_HPRE_DIV (1u)
+#endif
+
+/*
+--| NAME: CLOCK_TREE_CFG_PPRE1_DIV
+--| DESCRIPTION: the APB1 (low speed) prescaler [1, 2, 4, 8, 16]
+--| TYPE: unsigned integer
+*/
+#ifndef CLOCK_TREE_CFG_PPRE1_DIV
+#define CLOCK_TREE_CFG_PPRE1_DIV (1u)
+#endif
+
+/*
+--| NAME: CLOCK_TREE_CFG_PPRE2_DIV
+--| DESCRIPTION: the APB2 (high speed) prescaler [1, 2, 4, 8, 16]
+--| TYPE: unsigned integer
+*/
+#ifndef CLOCK_TREE_CFG_PPRE2_DIV
+#define CLOCK_TREE_CFG_PPRE2_DIV (1u)
+#endif
+
+/*
+--| NAME: CLOCK_TREE_CFG_ADCPRE_DIV
+--| DESCRIPTION: the ADC prescaler [2, 4, 6, 8]
+--| TYPE: unsigned integer
+*/
+#ifndef CLOCK_TREE_CFG_ADCPRE_DIV
+#define CLOCK_TREE_CFG_ADCPRE_DIV (4u)
+#endif
+
+/*
+--| DERIVED CLOCK FREQUENCIES
+*/
+
+/*
+--| NAME: CLOCK_TREE_PLL_INPUT_HZ
+--| DESCRIPTION: the clock entering the PLL multiplier
+--| TYPE: unsigned integer
+*/
+#define CLOCK_TREE_PLL_INPUT_HZ \
+    ((CLOCK_TREE_CFG_PLL_SOURCE == CLOCK_TREE_PLL_SOURCE_HSE) ? CLOCK_TREE_HSE_HZ : (CLOCK_TREE_HSI_HZ / 2u))
+
+/*
+--| NAME: CLOCK_TREE_PLL_OUTPUT_HZ
+--| DESCRIPTION: the PLL output clock (PLLCLK)
+--| TYPE: unsigned integer
+*/
+#define CLOCK_TREE_PLL_OUTPUT_HZ (CLOCK_TREE_PLL_INPUT_HZ * CLOCK_TREE_CFG_PLLMUL)
+
+/*
+--| NAME: CLOCK_TREE_SYSCLK_HZ
+--| DESCRIPTION: the system clock
+--| TYPE: unsigned integer
+*/
+#define CLOCK_TREE_SYSCLK_HZ                                                    \
+    ((CLOCK_TREE_CFG_SYSCLK_SOURCE == CLOCK_TREE_SYSCLK_SOURCE_PLL) ? CLOCK_TREE_PLL_OUTPUT_HZ : \
+     (CLOCK_TREE_CFG_SYSCLK_SOURCE == CLOCK_TREE_SYSCLK_SOURCE_HSE) ? CLOCK_TREE_HSE_HZ :        \
+                                                                      CLOCK_TREE_HSI_HZ)
+
+/*
+--| NAME: CLOCK_TREE_HCLK_HZ
+--| DESCRIPTION: the AHB clock, which also clocks the core, SysTick and DMA
+--| TYPE: unsigned integer
+*/
+#define CLOCK_TREE_HCLK_HZ (CLOCK_TREE_SYSCLK_HZ / CLOCK_TREE_CFG_HPRE_DIV)
+
+/*
+--| NAME: CLOCK_TREE_PCLK1_HZ
+--| DESCRIPTION: the APB1 peripheral clock (USART2/3, SPI2, I2C)
+--| TYPE: unsigned integer
+*/
+#define CLOCK_TREE_PCLK1_HZ (CLOCK_TREE_HCLK_HZ / CLOCK_TREE_CFG_PPRE1_DIV)
+
+/*
+--| NAME: CLOCK_TREE_PCLK2_HZ
+--| DESCRIPTION: the APB2 peripheral clock (USART1, SPI1, ADC, GPIO)
+--| TYPE: unsigned integer
+*/
+#define CLOCK_TREE_PCLK2_HZ (CLOCK_TREE_HCLK_HZ / CLOCK_TREE_CFG_PPRE2_DIV)
+
+/*
+--| NAME: CLOCK_TREE_APB1_TIMER_CLK_HZ
+--| DESCRIPTION: the TIM2, TIM3 and TIM4 kernel clock, doubled if APB1 is divided
+--| TYPE: unsigned integer
+*/
+#define CLOCK_TREE_APB1_TIMER_CLK_HZ \
+    ((CLOCK_TREE_CFG_PPRE1_DIV == 1u) ? CLOCK_TREE_PCLK1_HZ : (CLOCK_TREE_PCLK1_HZ * 2u))
+
+/*
+--| NAME: CLOCK_TREE_APB2_TIMER_CLK_HZ
+--| DESCRIPTION: the TIM1 kernel clock, doubled if APB2 is divided
+--| TYPE: unsigned integer
+*/
+#define CLOCK_TREE_APB2_TIMER_CLK_HZ \
+    ((CLOCK_TREE_CFG_PPRE2_DIV == 1u) ? CLOCK_TREE_PCLK2_HZ : (CLOCK_TREE_PCLK2_HZ * 2u))
+
+/*
+--| NAME: CLOCK_TREE_TIM1_CLK_HZ, CLOCK_TREE_TIM2_CLK_HZ, ...
+--| DESCRIPTION: per-timer kernel clocks
+--| TYPE: unsigned integer
+*/
+#define CLOCK_TREE_TIM1_CLK_HZ (CLOCK_TREE_APB2_TIMER_CLK_HZ)
+#define CLOCK_TREE_TIM2_CLK_HZ (CLOCK_TREE_APB1_TIMER_CLK_HZ)
+#define CLOCK_TREE_TIM3_CLK_HZ (CLOCK_TREE_APB1_TIMER_CLK_HZ)
+#define CLOCK_TREE_TIM4_CLK_HZ (CLOCK_TREE_APB1_TIMER_CLK_HZ)
+
+/*
+--| NAME: CLOCK_TREE_ADC_CLK_HZ
+--| DESCRIPTION: the ADC kernel clock
+--| TYPE: unsigned integer
+*/
+#define CLOCK_TREE_ADC_CLK_HZ (CLOCK_TREE_PCLK2_HZ / CLOCK_TREE_CFG_ADCPRE_DIV)
+
+/*
+--| REGISTER FIELD VALUES
+--| the encodings of the configured dividers, ready to be shifted into RCC CFGR
+*/
+#define CLOCK_TREE_PLLMUL_BITS (CLOCK_TREE_CFG_PLLMUL - 2u)
+
+#define CLOCK_TREE_HPRE_BITS                     \
+    ((CLOCK_TREE_CFG_HPRE_DIV == 1u)   ? 0b0000u : \
+     (CLOCK_TREE_CFG_HPRE_DIV == 2u)   ? 0b1000u : \
+     (CLOCK_TREE_CFG_HPRE_DIV == 4u)   ? 0b1001u : \
+     (CLOCK_TREE_CFG_HPRE_DIV == 8u)   ? 0b1010u : \
+     (CLOCK_TREE_CFG_HPRE_DIV == 16u)  ? 0b1011u : \
+     (CLOCK_TREE_CFG_HPRE_DIV == 64u)  ? 0b1100u : \
+     (CLOCK_TREE_CFG_HPRE_DIV == 128u) ? 0b1101u : \
+     (CLOCK_TREE_CFG_HPRE_DIV == 256u) ? 0b1110u : \
+     (CLOCK_TREE_CFG_HPRE_DIV == 512u) ? 0b1111u : 0xFFu)
+
+#define CLOCK_TREE_PPRE_BITS(div)   \
+    (((div) == 1u)  ? 0b000u :      \
+     ((div) == 2u)  ? 0b100u :      \
+     ((div) == 4u)  ? 0b101u :      \
+     ((div) == 8u)  ? 0b110u :      \
+     ((div) == 16u) ? 0b111u : 0xFFu)
+
+#define CLOCK_TREE_PPRE1_BITS (CLOCK_TREE_PPRE_BITS(CLOCK_TREE_CFG_PPRE1_DIV))
+#define CLOCK_TREE_PPRE2_BITS (CLOCK_TREE_PPRE_BITS(CLOCK_TREE_CFG_PPRE2_DIV))
+
+#define CLOCK_TREE_ADCPRE_BITS                 \
+    ((CLOCK_TREE_CFG_ADCPRE_DIV == 2u) ? 0b00u : \
+     (CLOCK_TREE_CFG_ADCPRE_DIV == 4u) ? 0b01u : \
+     (CLOCK_TREE_CFG_ADCPRE_DIV == 6u) ? 0b10u : \
+     (CLOCK_TREE_CFG_ADCPRE_DIV == 8u) ? 0b11u : 0xFFu)
+
+/*
+--| NAME: CLOCK_TREE_FLASH_LATENCY
+--| DESCRIPTION: flash wait states required for the configured SYSCLK
+--| TYPE: unsigned integer, matches FLASH_ACR_Latency_enum
+*/
+#define CLOCK_TREE_FLASH_LATENCY                   \
+    ((CLOCK_TREE_SYSCLK_HZ <= 24000000u) ? 0b000u :  \
+     (CLOCK_TREE_SYSCLK_HZ <= 48000000u) ? 0b001u : 0b010u)
+
+/*
+--| HELPERS
+*/
+
+/*
+--| NAME: CLOCK_TREE_TIMER_MAX
+--| DESCRIPTION: the largest TIMx PSC or ARR value, both are 16 bits, check
+--|   CLOCK_TREE_TIMER_PSC and CLOCK_TREE_TIMER_ARR results against it
+--| TYPE: unsigned integer
+*/
+#define CLOCK_TREE_TIMER_MAX (0xFFFFu)
+
+/*
+--| NAME: CLOCK_TREE_TIMER_PSC
+--| DESCRIPTION: the TIMx PSC value which divides timer_clk_hz down to the
+--|   nearest rate to tick_hz, above CLOCK_TREE_TIMER_MAX if out of range
+--| TYPE: unsigned integer
+*/
+#define CLOCK_TREE_TIMER_PSC(timer_clk_hz, tick_hz) \
+    ((((timer_clk_hz) + ((tick_hz) / 2u)) / (tick_hz)) - 1u)
+
+/*
+--| NAME: CLOCK_TREE_TIMER_ARR
+--| DESCRIPTION: the TIMx ARR value which divides tick_hz down to the nearest
+--|   rate to update_hz, above CLOCK_TREE_TIMER_MAX if out of range
+--| TYPE: unsigned integer
+*/
+#define CLOCK_TREE_TIMER_ARR(tick_hz, update_hz) \
+    ((((tick_hz) + ((update_hz) / 2u)) / (update_hz)) - 1u)
+
+/*
+--| NAME: CLOCK_TREE_SPI_BR
+--| DESCRIPTION: the SPI CR1 BR value giving the fastest SCK that does not
+--|   exceed max_sck_hz, matches SPI_CR1_BR_MASKS_enum
+--| TYPE: unsigned integer
+*/
+#define CLOCK_TREE_SPI_BR(pclk_hz, max_sck_hz)        \
+    ((((pclk_hz) / 2u)   <= (max_sck_hz)) ? 0b000u :  \
+     (((pclk_hz) / 4u)   <= (max_sck_hz)) ? 0b001u :  \
+     (((pclk_hz) / 8u)   <= (max_sck_hz)) ? 0b010u :  \
+     (((pclk_hz) / 16u)  <= (max_sck_hz)) ? 0b011u :  \
+     (((pclk_hz) / 32u)  <= (max_sck_hz)) ? 0b100u :  \
+     (((pclk_hz) / 64u)  <= (max_sck_hz)) ? 0b101u :  \
+     (((pclk_hz) / 128u) <= (max_sck_hz)) ? 0b110u : 0b111u)
+
+/*
+--|----------------------------------------------------------------------------|
+--| PUBLIC TYPES
+--|----------------------------------------------------------------------------|
+*/
+
+/* None */
+
+/*
+--|----------------------------------------------------------------------------|
+--| PUBLIC CONSTANTS
+--|----------------------------------------------------------------------------|
+*/
+
+/* None */
+
+/*
+--|----------------------------------------------------------------------------|
+--| PUBLIC VARIABLES
+--|----------------------------------------------------------------------------|
+*/
+
+/* None */
+
+/*
+--|----------------------------------------------------------------------------|
+--| PUBLIC FUNCTION PROTOTYPES
+--|----------------------------------------------------------------------------|
+*/
+
+/* None */
+
+#endif
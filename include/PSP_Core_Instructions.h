@@ -0,0 +1,412 @@
+/*
+--|----------------------------------------------------------------------------|
+--| FILE DESCRIPTION:
+--|   PSP_Core_Instructions.h provides inline wrappers for the Cortex-M3
+--|   instructions which have no C equivalent, such as interrupt masking,
+--|   barriers and sleep.
+--|
+--|----------------------------------------------------------------------------|
+--| REFERENCES:
+--|   PM0056 programming manual, chapter 3 (instruction set)
+--|
+--|----------------------------------------------------------------------------|
+*/
+
+#ifndef PSP_CORE_INSTRUCTIONS_H_INCLUDED
+#define PSP_CORE_INSTRUCTIONS_H_INCLUDED
+
+/*
+--|----------------------------------------------------------------------------|
+--| INCLUDE FILES
+--|----------------------------------------------------------------------------|
+*/
+
+#include "Common_Typedefs.h"
+
+/*
+--|----------------------------------------------------------------------------|
+--| PUBLIC DEFINES
+--|----------------------------------------------------------------------------|
+*/
+
+/* None */
+
+/*
+--|----------------------------------------------------------------------------|
+--| PUBLIC TYPES
+--|----------------------------------------------------------------------------|
+*/
+
+/* None */
+
+/*
+--|----------------------------------------------------------------------------|
+--| PUBLIC CONSTANTS
+--|----------------------------------------------------------------------------|
+*/
+
+/* None */
+
+/*
+--|----------------------------------------------------------------------------|
+--| PUBLIC VARIABLES
+--|----------------------------------------------------------------------------|
+*/
+
+/* None */
+
+/*
+--|----------------------------------------------------------------------------|
+--| PUBLIC FUNCTION PROTOTYPES
+--|----------------------------------------------------------------------------|
+*/
+
+/*------------------------------------------------------------------------------
+Function Name:
+    Core_Disable_Interrupts
+
+Function Description:
+    Mask all configurable priority interrupts by setting PRIMASK (CPSID i).
+
+Parameters:
+    None
+
+Returns:
+    None
+
+Assumptions/Limitations:
+    NMI and HardFault are not masked.
+------------------------------------------------------------------------------*/
+static inline void Core_Disable_Interrupts(void)
+{
+    __asm volatile ("cpsid i" : : : "memory");
+}
+
+/*------------------------------------------------------------------------------
+Function Name:
+    Core_Enable_Interrupts
+
+Function Description:
+    Unmask interrupts by clearing PRIMASK (CPSIE i).
+
+Parameters:
+    None
+
+Returns:
+    None
+
+Assumptions/Limitations:
+    None
+------------------------------------------------------------------------------*/
+static inline void Core_Enable_Interrupts(void)
+{
+    __asm volatile ("cpsie i" : : : "memory");
+}
+
+/*------------------------------------------------------------------------------
+Function Name:
+    Core_Get_PRIMASK
+
+Function Description:
+    Read the PRIMASK register.
+
+Parameters:
+    None
+
+Returns:
+    uint32_t: 1 if interrupts are masked, else 0.
+
+Assumptions/Limitations:
+    None
+------------------------------------------------------------------------------*/
+static inline uint32_t Core_Get_PRIMASK(void)
+{
+    uint32_t primask;
+
+    __asm volatile ("mrs %0, primask" : "=r" (primask));
+
+    return primask;
+}
+
+/*------------------------------------------------------------------------------
+Function Name:
+    Core_Set_PRIMASK
+
+Function Description:
+    Write the PRIMASK register, for restoring a value read by Core_Get_PRIMASK.
+
+Parameters:
+    primask: the value to write.
+
+Returns:
+    None
+
+Assumptions/Limitations:
+    None
+------------------------------------------------------------------------------*/
+static inline void Core_Set_PRIMASK(uint32_t primask)
+{
+    __asm volatile ("msr primask, %0" : : "r" (primask) : "memory");
+}
+
+/*------------------------------------------------------------------------------
+Function Name:
+    Core_Get_IPSR
+
+Function Description:
+    Read the IPSR register, the exception number of the running handler.
+
+Parameters:
+    None
+
+Returns:
+    uint32_t: the exception number, 16 + IRQn for device interrupts, or 0
+    in thread mode.
+
+Assumptions/Limitations:
+    None
+------------------------------------------------------------------------------*/
+static inline uint32_t Core_Get_IPSR(void)
+{
+    uint32_t ipsr;
+
+    __asm volatile ("mrs %0, ipsr" : "=r" (ipsr));
+
+    return ipsr;
+}
+
+/*------------------------------------------------------------------------------
+Function Name:
+    Core_Get_BASEPRI
+
+Function Description:
+    Read the BASEPRI register.
+
+Parameters:
+    None
+
+Returns:
+    uint32_t: the priority at and below which interrupts are masked, in the
+    upper bits, or 0 if none are masked.
+
+Assumptions/Limitations:
+    None
+------------------------------------------------------------------------------*/
+static inline uint32_t Core_Get_BASEPRI(void)
+{
+    uint32_t basepri;
+
+    __asm volatile ("mrs %0, basepri" : "=r" (basepri));
+
+    return basepri;
+}
+
+/*------------------------------------------------------------------------------
+Function Name:
+    Core_Set_BASEPRI
+
+Function Description:
+    Write the BASEPRI register, masking interrupts with a priority value
+    greater than or equal to basepri. 0 unmasks all.
+
+Parameters:
+    basepri: the value to write.
+
+Returns:
+    None
+
+Assumptions/Limitations:
+    None
+------------------------------------------------------------------------------*/
+static inline void Core_Set_BASEPRI(uint32_t basepri)
+{
+    __asm volatile ("msr basepri, %0" : : "r" (basepri) : "memory");
+}
+
+/*------------------------------------------------------------------------------
+Function Name:
+    Core_Raise_BASEPRI
+
+Function Description:
+    Write the BASEPRI register only if it raises the masking level
+    (BASEPRI_MAX), so a nested critical section can never unmask
+    interrupts masked by an outer one.
+
+Parameters:
+    basepri: the value to write, not 0.
+
+Returns:
+    None
+
+Assumptions/Limitations:
+    None
+------------------------------------------------------------------------------*/
+static inline void Core_Raise_BASEPRI(uint32_t basepri)
+{
+    __asm volatile ("msr basepri_max, %0" : : "r" (basepri) : "memory");
+}
+
+/*------------------------------------------------------------------------------
+Function Name:
+    Core_Load_Exclusive
+
+Function Description:
+    Read a word and mark its address for exclusive access (LDREX).
+
+Parameters:
+    p_address: the word to read.
+
+Returns:
+    uint32_t: the word.
+
+Assumptions/Limitations:
+    Must be followed by Core_Store_Exclusive or Core_Clear_Exclusive.
+------------------------------------------------------------------------------*/
+static inline uint32_t Core_Load_Exclusive(vuint32_t * p_address)
+{
+    uint32_t value;
+
+    __asm volatile ("ldrex %0, %1" : "=r" (value) : "Q" (*p_address));
+
+    return value;
+}
+
+/*------------------------------------------------------------------------------
+Function Name:
+    Core_Store_Exclusive
+
+Function Description:
+    Write a word only if nothing has broken the exclusive access since the
+    matching Core_Load_Exclusive (STREX). Any exception entry or return
+    breaks it, so a read-modify-write between the two is atomic with
+    respect to interrupts.
+
+Parameters:
+    value: the word to write.
+    p_address: the address given to Core_Load_Exclusive.
+
+Returns:
+    uint32_t: 0 if the word was written, 1 if the sequence must be retried.
+
+Assumptions/Limitations:
+    None
+------------------------------------------------------------------------------*/
+static inline uint32_t Core_Store_Exclusive(uint32_t value, vuint32_t * p_address)
+{
+    uint32_t failed;
+
+    __asm volatile ("strex %0, %2, %1" : "=&r" (failed), "=Q" (*p_address) : "r" (value) : "memory");
+
+    return failed;
+}
+
+/*------------------------------------------------------------------------------
+Function Name:
+    Core_Clear_Exclusive
+
+Function Description:
+    Abandon an exclusive access started by Core_Load_Exclusive (CLREX).
+
+Parameters:
+    None
+
+Returns:
+    None
+
+Assumptions/Limitations:
+    None
+------------------------------------------------------------------------------*/
+static inline void Core_Clear_Exclusive(void)
+{
+    __asm volatile ("clrex" : : : "memory");
+}
+
+/*------------------------------------------------------------------------------
+Function Name:
+    Core_Wait_For_Interrupt
+
+Function Description:
+    Sleep until an interrupt is pending (WFI).
+
+Parameters:
+    None
+
+Returns:
+    None
+
+Assumptions/Limitations:
+    A pending interrupt wakes the core even while PRIMASK is set, it is just
+    not taken until PRIMASK is cleared.
+------------------------------------------------------------------------------*/
+static inline void Core_Wait_For_Interrupt(void)
+{
+    __asm volatile ("wfi" : : : "memory");
+}
+
+/*------------------------------------------------------------------------------
+Function Name:
+    Core_Data_Memory_Barrier
+
+Function Description:
+    Order the memory accesses before the barrier ahead of those after it
+    (DMB), without waiting for them to complete. Also stops the compiler
+    moving memory accesses across it.
+
+Parameters:
+    None
+
+Returns:
+    None
+
+Assumptions/Limitations:
+    None
+------------------------------------------------------------------------------*/
+static inline void Core_Data_Memory_Barrier(void)
+{
+    __asm volatile ("dmb" : : : "memory");
+}
+
+/*------------------------------------------------------------------------------
+Function Name:
+    Core_Data_Sync_Barrier
+
+Function Description:
+    Wait for all outstanding memory accesses to complete (DSB).
+
+Parameters:
+    None
+
+Returns:
+    None
+
+Assumptions/Limitations:
+    None
+------------------------------------------------------------------------------*/
+static inline void Core_Data_Sync_Barrier(void)
+{
+    __asm volatile ("dsb" : : : "memory");
+}
+
+/*------------------------------------------------------------------------------
+Function Name:
+    Core_Instruction_Sync_Barrier
+
+Function Description:
+    Flush the pipeline, so that following instructions see the effect of
+    any preceding system register changes (ISB).
+
+Parameters:
+    None
+
+Returns:
+    None
+
+Assumptions/Limitations:
+    None
+------------------------------------------------------------------------------*/
+static inline void Core_Instruction_Sync_Barrier(void)
+{
+    __asm volatile ("isb" : : : "memory");
+}
+
+#endif
@@ -0,0 +1,287 @@
+/*
+--|----------------------------------------------------------------------------|
+--| FILE DESCRIPTION:
+--|   PSP_DMA.h provides types and interfaces for the DMA1 controller.
+--|
+--|----------------------------------------------------------------------------|
+--| REFERENCES:
+--|   stm32f10x reference manual, page 273
+--|
+--|----------------------------------------------------------------------------|
+*/
+
+#ifndef PSP_DMA_H_INCLUDED
+#define PSP_DMA_H_INCLUDED
+
+/*
+--|----------------------------------------------------------------------------|
+--| INCLUDE FILES
+--|----------------------------------------------------------------------------|
+*/
+
+#include "Common_Masks.h"
+#include "Common_Typedefs.h"
+#include "PSP_Peripherals_Memory_Map.h"
+
+/*
+--|----------------------------------------------------------------------------|
+--| PUBLIC DEFINES
+--|----------------------------------------------------------------------------|
+*/
+
+/*
+--| NAME: DMA1
+--| DESCRIPTION: pointer to the DMA1 controller
+--| TYPE: DMA_t*
+*/
+#define DMA1 ((volatile DMA_t *)PSP_PERIPHERAL_DMA_BASE)
+
+/*
+--| NAME: DMA_NUM_CHANNELS
+--| DESCRIPTION: the number of channels in the DMA1 controller
+--| TYPE: unsigned integer
+*/
+#define DMA_NUM_CHANNELS (7u)
+
+/*
+--| NAME: DMA_ISR_CHANNEL_WIDTH
+--| DESCRIPTION: the number of flag bits per channel in the ISR and IFCR registers
+--| TYPE: unsigned integer
+*/
+#define DMA_ISR_CHANNEL_WIDTH (4u)
+
+/*
+--|----------------------------------------------------------------------------|
+--| PUBLIC TYPES
+--|----------------------------------------------------------------------------|
+*/
+
+/*
+--| NAME: DMA_Channel_t
+--| DESCRIPTION: DMA channel registers structure
+*/
+typedef struct DMA_Channel_Type
+{
+    vuint32_t CCR;        // channel configuration register
+    vuint32_t CNDTR;      // channel number of data register [16 bits]
+    vuint32_t CPAR;       // channel peripheral address register
+    vuint32_t CMAR;       // channel memory address register
+     uint32_t RESERVED_0; //
+} DMA_Channel_t;
+
+/*
+--| NAME: DMA_t
+--| DESCRIPTION: DMA controller structure
+*/
+typedef struct DMA_Type
+{
+    vuint32_t     ISR;                        // interrupt status register [r]
+    vuint32_t     IFCR;                       // interrupt flag clear register [w]
+    DMA_Channel_t CHANNEL[DMA_NUM_CHANNELS];  // channels 1 to 7
+} DMA_t;
+
+/*
+--| NAME: DMA_Channel_enum
+--| DESCRIPTION: enumeration for the DMA1 channels
+*/
+typedef enum DMA_Channel_Enumeration
+{
+    DMA_CHANNEL_1 = 0u,
+    DMA_CHANNEL_2 = 1u,
+    DMA_CHANNEL_3 = 2u,
+    DMA_CHANNEL_4 = 3u,
+    DMA_CHANNEL_5 = 4u,
+    DMA_CHANNEL_6 = 5u,
+    DMA_CHANNEL_7 = 6u,
+    DMA_CHANNEL_NONE
+} DMA_Channel_enum;
+
+/*
+--| NAME: DMA_ISR_FLAGS_enum
+--| DESCRIPTION: DMA interrupt status and clear register flags for channel 1,
+--|   shift left by DMA_ISR_CHANNEL_WIDTH times the channel for the others
+*/
+typedef enum DMA_ISR_FLAGS_Enumeration
+{
+    DMA_ISR_TEIF_FLAG = (1u << 3u), // transfer error flag [r]
+    DMA_ISR_HTIF_FLAG = (1u << 2u), // half transfer flag [r]
+    DMA_ISR_TCIF_FLAG = (1u << 1u), // transfer complete flag [r]
+    DMA_ISR_GIF_FLAG  = (1u << 0u), // global interrupt flag [r]
+} DMA_ISR_FLAGS_enum;
+
+/*
+--| NAME: DMA_CCR_FLAGS_enum
+--| DESCRIPTION: DMA channel configuration register flags
+*/
+typedef enum DMA_CCR_FLAGS_Enumeration
+{
+    DMA_CCR_MEM2MEM_FLAG = (1u << 14u), // memory to memory mode [rw]
+    DMA_CCR_MINC_FLAG    = (1u << 7u),  // memory increment mode [rw]
+    DMA_CCR_PINC_FLAG    = (1u << 6u),  // peripheral increment mode [rw]
+    DMA_CCR_CIRC_FLAG    = (1u << 5u),  // circular mode [rw]
+    DMA_CCR_DIR_FLAG     = (1u << 4u),  // 0: read from peripheral, 1: read from memory [rw]
+    DMA_CCR_TEIE_FLAG    = (1u << 3u),  // transfer error interrupt enable [rw]
+    DMA_CCR_HTIE_FLAG    = (1u << 2u),  // half transfer interrupt enable [rw]
+    DMA_CCR_TCIE_FLAG    = (1u << 1u),  // transfer complete interrupt enable [rw]
+    DMA_CCR_EN_FLAG      = (1u << 0u),  // channel enable [rw]
+} DMA_CCR_FLAGS_enum;
+
+/*
+--| NAME: DMA_CCR_PL_MASKS_enum
+--| DESCRIPTION: DMA CCR channel priority level masks [2 bits, rw]
+*/
+typedef enum DMA_CCR_PL_MASKS_Enumeration
+{
+    DMA_CCR_PL_LOW       = 0b00u, // low
+    DMA_CCR_PL_MEDIUM    = 0b01u, // medium
+    DMA_CCR_PL_HIGH      = 0b10u, // high
+    DMA_CCR_PL_VERY_HIGH = 0b11u, // very high
+    DMA_CCR_PL_SHIFT_AMT = 12u,   // position of PL in DMA CCR
+} DMA_CCR_PL_MASKS_enum;
+
+/*
+--| NAME: DMA_CCR_SIZE_MASKS_enum
+--| DESCRIPTION: DMA CCR memory and peripheral size masks [2 bits each, rw]
+*/
+typedef enum DMA_CCR_SIZE_MASKS_Enumeration
+{
+    DMA_CCR_SIZE_8_BITS     = 0b00u, // 8 bits
+    DMA_CCR_SIZE_16_BITS    = 0b01u, // 16 bits
+    DMA_CCR_SIZE_32_BITS    = 0b10u, // 32 bits
+    DMA_CCR_MSIZE_SHIFT_AMT = 10u,   // position of MSIZE in DMA CCR
+    DMA_CCR_PSIZE_SHIFT_AMT = 8u,    // position of PSIZE in DMA CCR
+} DMA_CCR_SIZE_MASKS_enum;
+
+/*
+--| NAME: DMA_Channel_Initialization_Data_t
+--| DESCRIPTION: structure for DMA channel initialization data
+*/
+typedef struct DMA_Channel_Initialization_Data_Type
+{
+    volatile void *         p_peripheral;  // address of the peripheral data register
+    volatile void *         p_memory;      // address of the memory buffer
+    uint32_t                num_transfers; // the number of data items [1 to 65535]
+    DMA_CCR_SIZE_MASKS_enum transfer_size; // the size of each item, in both peripheral and memory
+    DMA_CCR_PL_MASKS_enum   priority;      // the channel priority
+    uint32_t                ccr_flags;     // any of DMA_CCR_FLAGS_enum, except EN
+} DMA_Channel_Initialization_Data_t;
+
+/*
+--|----------------------------------------------------------------------------|
+--| PUBLIC CONSTANTS
+--|----------------------------------------------------------------------------|
+*/
+
+/* None */
+
+/*
+--|----------------------------------------------------------------------------|
+--| PUBLIC VARIABLES
+--|----------------------------------------------------------------------------|
+*/
+
+/* None */
+
+/*
+--|----------------------------------------------------------------------------|
+--| PUBLIC FUNCTION PROTOTYPES
+--|----------------------------------------------------------------------------|
+*/
+
+/*------------------------------------------------------------------------------
+Function Name:
+    DMA_Channel_Init
+
+Function Description:
+    Configure a DMA channel and enable it. The channel then transfers data
+    each time its peripheral raises a DMA request.
+
+Parameters:
+    channel: the DMA channel.
+    p_init_data: pointer to the channel initialization data.
+
+Returns:
+    None
+
+Assumptions/Limitations:
+    Enables the DMA1 clock. Any transfer in progress on the channel is
+    stopped, and its interrupt flags are cleared.
+------------------------------------------------------------------------------*/
+void DMA_Channel_Init(DMA_Channel_enum channel, DMA_Channel_Initialization_Data_t * p_init_data);
+
+/*------------------------------------------------------------------------------
+Function Name:
+    DMA_Channel_Disable
+
+Function Description:
+    Stop a DMA channel.
+
+Parameters:
+    channel: the DMA channel.
+
+Returns:
+    None
+
+Assumptions/Limitations:
+    None
+------------------------------------------------------------------------------*/
+void DMA_Channel_Disable(DMA_Channel_enum channel);
+
+/*------------------------------------------------------------------------------
+Function Name:
+    DMA_Channel_Get_Remaining
+
+Function Description:
+    Get the number of data items left to transfer. In circular mode this
+    counts down to 1 and then reloads, so it gives the position of the
+    channel in the buffer.
+
+Parameters:
+    channel: the DMA channel.
+
+Returns:
+    uint32_t: the number of items left in the current pass.
+
+Assumptions/Limitations:
+    None
+------------------------------------------------------------------------------*/
+uint32_t DMA_Channel_Get_Remaining(DMA_Channel_enum channel);
+
+/*------------------------------------------------------------------------------
+Function Name:
+    DMA_Channel_Get_Flags
+
+Function Description:
+    Get the interrupt status flags of a DMA channel.
+
+Parameters:
+    channel: the DMA channel.
+
+Returns:
+    uint32_t: any of DMA_ISR_FLAGS_enum, shifted down to the channel 1 position.
+
+Assumptions/Limitations:
+    None
+------------------------------------------------------------------------------*/
+uint32_t DMA_Channel_Get_Flags(DMA_Channel_enum channel);
+
+/*------------------------------------------------------------------------------
+Function Name:
+    DMA_Channel_Clear_Flags
+
+Function Description:
+    Clear interrupt status flags of a DMA channel.
+
+Parameters:
+    channel: the DMA channel.
+    flags: any of DMA_ISR_FLAGS_enum, at the channel 1 position.
+
+Returns:
+    None
+
+Assumptions/Limitations:
+    None
+------------------------------------------------------------------------------*/
+void DMA_Channel_Clear_Flags(DMA_Channel_enum channel, uint32_t flags);
+
+#endif
@@ -0,0 +1,352 @@
+/*
+--|----------------------------------------------------------------------------|
+--| FILE DESCRIPTION:
+--|   PSP_DWT.h provides types and interfaces for the Data Watchpoint and Trace
+--|   unit, which is used here as a high resolution cycle counter for precise
+--|   delays and elapsed time measurement.
+--|
+--|----------------------------------------------------------------------------|
+--| REFERENCES:
+--|   cortex_m3 technical reference manual, chapter 11 (DWT)
+--|   cortex_m3 technical reference manual, chapter 10 (DEMCR)
+--|
+--|----------------------------------------------------------------------------|
+*/
+
+#ifndef PSP_DWT_H_INCLUDED
+#define PSP_DWT_H_INCLUDED
+
+/*
+--|----------------------------------------------------------------------------|
+--| INCLUDE FILES
+--|----------------------------------------------------------------------------|
+*/
+
+#include "Common_Typedefs.h"
+#include "PSP_Peripherals_Memory_Map.h"
+
+/*
+--|----------------------------------------------------------------------------|
+--| PUBLIC DEFINES
+--|----------------------------------------------------------------------------|
+*/
+
+/*
+--| NAME: DWT
+--| DESCRIPTION: pointer to the Data Watchpoint and Trace unit
+--| TYPE: DWT_t*
+*/
+#define DWT ((volatile DWT_t *)PSP_CORE_PERIPHERAL_DWT_BASE)
+
+/*
+--| NAME: DCB
+--| DESCRIPTION: pointer to the Debug Control Block
+--| TYPE: DCB_t*
+*/
+#define DCB ((volatile DCB_t *)PSP_CORE_PERIPHERAL_DCB_BASE)
+
+/*
+--|----------------------------------------------------------------------------|
+--| PUBLIC TYPES
+--|----------------------------------------------------------------------------|
+*/
+
+/*
+--| NAME: DWT_t
+--| DESCRIPTION: Data Watchpoint and Trace unit structure
+*/
+typedef struct DWT_Type
+{
+    vuint32_t CTRL;     // control register
+    vuint32_t CYCCNT;   // cycle count register [32 bits]
+    vuint32_t CPICNT;   // CPI count register [8 bits]
+    vuint32_t EXCCNT;   // exception overhead count register [8 bits]
+    vuint32_t SLEEPCNT; // sleep count register [8 bits]
+    vuint32_t LSUCNT;   // LSU count register [8 bits]
+    vuint32_t FOLDCNT;  // folded-instruction count register [8 bits]
+    vuint32_t PCSR;     // program counter sample register [r]
+} DWT_t;
+
+/*
+--| NAME: DWT_CTRL_FLAGS_enum
+--| DESCRIPTION: DWT control register flags
+*/
+typedef enum DWT_CTRL_FLAGS_Enumeration
+{
+    DWT_CTRL_NOCYCCNT_FLAG  = (1u << 25u), // cycle counter not supported [r]
+    DWT_CTRL_CYCCNTENA_FLAG = (1u << 0u),  // enable the cycle counter [rw]
+} DWT_CTRL_FLAGS_enum;
+
+/*
+--| NAME: DCB_t
+--| DESCRIPTION: Debug Control Block structure
+*/
+typedef struct DCB_Type
+{
+    vuint32_t DHCSR; // debug halting control and status register
+    vuint32_t DCRSR; // debug core register selector register
+    vuint32_t DCRDR; // debug core register data register
+    vuint32_t DEMCR; // debug exception and monitor control register
+} DCB_t;
+
+/*
+--| NAME: DCB_DEMCR_FLAGS_enum
+--| DESCRIPTION: debug exception and monitor control register flags
+*/
+typedef enum DCB_DEMCR_FLAGS_Enumeration
+{
+    DCB_DEMCR_TRCENA_FLAG = (1u << 24u), // enable the DWT and ITM units [rw]
+} DCB_DEMCR_FLAGS_enum;
+
+/*
+--| NAME: DWT_Stopwatch_t
+--| DESCRIPTION: structure for elapsed time measurement storage
+*/
+typedef struct DWT_Stopwatch_Type
+{
+    uint64_t start_cycles; // the cycle count when the stopwatch was started
+} DWT_Stopwatch_t;
+
+/*
+--| NAME: DWT_Cycle_Budget_t
+--| DESCRIPTION: a cycle budget for a hot path, with the worst case seen
+--|   and the number of times it was exceeded
+*/
+typedef struct DWT_Cycle_Budget_Type
+{
+    uint32_t budget_cycles; // the most cycles the hot path may take
+    uint32_t worst_cycles;  // the most cycles it has taken so far
+    uint32_t overruns;      // the number of times it took more than the budget
+} DWT_Cycle_Budget_t;
+
+/*
+--|----------------------------------------------------------------------------|
+--| PUBLIC CONSTANTS
+--|----------------------------------------------------------------------------|
+*/
+
+/* None */
+
+/*
+--|----------------------------------------------------------------------------|
+--| PUBLIC VARIABLES
+--|----------------------------------------------------------------------------|
+*/
+
+/* None */
+
+/*
+--|----------------------------------------------------------------------------|
+--| PUBLIC FUNCTION PROTOTYPES
+--|----------------------------------------------------------------------------|
+*/
+
+/*------------------------------------------------------------------------------
+Function Name:
+    DWT_Init
+
+Function Description:
+    Enable the DWT cycle counter. If the core was built without a cycle
+    counter, the SysTick timer is used as a fallback timebase.
+
+Parameters:
+    None
+
+Returns:
+    None
+
+Assumptions/Limitations:
+    This function is automatically called by System_Clock_Init.
+------------------------------------------------------------------------------*/
+void DWT_Init(void);
+
+/*------------------------------------------------------------------------------
+Function Name:
+    DWT_Get_Cycles
+
+Function Description:
+    Get the number of core clock cycles since DWT_Init was called.
+
+Parameters:
+    None
+
+Returns:
+    uint64_t: the 64 bit cycle count.
+
+Assumptions/Limitations:
+    The 32 bit hardware counter is extended to 64 bits by the SysTick
+    interrupt, so SysTick must not be masked for more than 2^32 cycles.
+------------------------------------------------------------------------------*/
+uint64_t DWT_Get_Cycles(void);
+
+/*------------------------------------------------------------------------------
+Function Name:
+    DWT_Get_uSec
+
+Function Description:
+    Get the number of microseconds since DWT_Init was called.
+
+Parameters:
+    None
+
+Returns:
+    uint64_t: the 64 bit microsecond count.
+
+Assumptions/Limitations:
+    Same as DWT_Get_Cycles.
+------------------------------------------------------------------------------*/
+uint64_t DWT_Get_uSec(void);
+
+/*------------------------------------------------------------------------------
+Function Name:
+    DWT_Delay_Cycles
+
+Function Description:
+    Wait for a given number of core clock cycles.
+
+Parameters:
+    cycles: the number of cycles to wait.
+
+Returns:
+    None
+
+Assumptions/Limitations:
+    The delay overshoots by the few cycles of call and loop overhead.
+------------------------------------------------------------------------------*/
+void DWT_Delay_Cycles(uint32_t cycles);
+
+/*------------------------------------------------------------------------------
+Function Name:
+    DWT_Delay_uSec
+
+Function Description:
+    Wait for a given number of microseconds.
+
+Parameters:
+    uSec: the number of microseconds to wait.
+
+Returns:
+    None
+
+Assumptions/Limitations:
+    None
+------------------------------------------------------------------------------*/
+void DWT_Delay_uSec(uint32_t uSec);
+
+/*------------------------------------------------------------------------------
+Function Name:
+    DWT_Start_Stopwatch
+
+Function Description:
+    Start (or restart) an elapsed time measurement.
+
+Parameters:
+    p_stopwatch: pointer to the stopwatch.
+
+Returns:
+    None
+
+Assumptions/Limitations:
+    None
+------------------------------------------------------------------------------*/
+void DWT_Start_Stopwatch(DWT_Stopwatch_t * p_stopwatch);
+
+/*------------------------------------------------------------------------------
+Function Name:
+    DWT_Get_Elapsed_Cycles
+
+Function Description:
+    Get the number of core clock cycles since the given stopwatch was started.
+
+Parameters:
+    p_stopwatch: pointer to the stopwatch.
+
+Returns:
+    uint64_t: the elapsed cycles.
+
+Assumptions/Limitations:
+    Assumes that the given stopwatch has been started.
+------------------------------------------------------------------------------*/
+uint64_t DWT_Get_Elapsed_Cycles(DWT_Stopwatch_t * p_stopwatch);
+
+/*------------------------------------------------------------------------------
+Function Name:
+    DWT_Get_Elapsed_uSec
+
+Function Description:
+    Get the number of microseconds since the given stopwatch was started.
+
+Parameters:
+    p_stopwatch: pointer to the stopwatch.
+
+Returns:
+    uint64_t: the elapsed microseconds.
+
+Assumptions/Limitations:
+    Assumes that the given stopwatch has been started.
+------------------------------------------------------------------------------*/
+uint64_t DWT_Get_Elapsed_uSec(DWT_Stopwatch_t * p_stopwatch);
+
+/*------------------------------------------------------------------------------
+Function Name:
+    DWT_Check_Cycle_Budget
+
+Function Description:
+    Check the cycles since the given stopwatch was started against a cycle
+    budget, updating its worst case and overrun count.
+
+Parameters:
+    p_budget: pointer to the cycle budget.
+    p_stopwatch: pointer to the stopwatch, started at the beginning of the
+    hot path.
+
+Returns:
+    true if the hot path was within its budget, false if it was over.
+
+Assumptions/Limitations:
+    Assumes that the given stopwatch has been started. Includes the cycles
+    of any interrupts taken during the hot path.
+------------------------------------------------------------------------------*/
+bool DWT_Check_Cycle_Budget(DWT_Cycle_Budget_t * p_budget, DWT_Stopwatch_t * p_stopwatch);
+
+/*------------------------------------------------------------------------------
+Function Name:
+    DWT_Cycle_Counter_Update
+
+Function Description:
+    Sample the 32 bit hardware cycle counter and account for any wrap around,
+    so that DWT_Get_Cycles can return a 64 bit count.
+
+Parameters:
+    None
+
+Returns:
+    None
+
+Assumptions/Limitations:
+    Called from the SysTick interrupt, not intended to be called by the user.
+------------------------------------------------------------------------------*/
+void DWT_Cycle_Counter_Update(void);
+
+/*------------------------------------------------------------------------------
+Function Name:
+    DWT_Cycle_Counter_Add
+
+Function Description:
+    Advance the cycle counter by cycles which passed while it was stopped,
+    such as while the core slept with HCLK gated.
+
+Parameters:
+    cycles: the cycles to add.
+
+Returns:
+    None
+
+Assumptions/Limitations:
+    Called with interrupts disabled, from SysTick_Tickless_Idle, not
+    intended to be called by the user. The cycles since the last
+    DWT_Cycle_Counter_Update plus those added must be below 2^32.
+------------------------------------------------------------------------------*/
+void DWT_Cycle_Counter_Add(uint32_t cycles);
+
+#endif
@@ -0,0 +1,255 @@
+/*
+--|----------------------------------------------------------------------------|
+--| FILE DESCRIPTION:
+--|   PSP_Memory_Pool.h provides types and interfaces for the fixed block
+--|   memory pools, carved from the memory pool region of RAM.
+--|
+--|----------------------------------------------------------------------------|
+--| REFERENCES:
+--|   PM0056 programming manual, page 40 (synchronization primitives)
+--|
+--|----------------------------------------------------------------------------|
+*/
+
+#ifndef PSP_MEMORY_POOL_H_INCLUDED
+#define PSP_MEMORY_POOL_H_INCLUDED
+
+/*
+--|----------------------------------------------------------------------------|
+--| INCLUDE FILES
+--|----------------------------------------------------------------------------|
+*/
+
+#include "Common_Typedefs.h"
+
+/*
+--|----------------------------------------------------------------------------|
+--| PUBLIC DEFINES
+--|----------------------------------------------------------------------------|
+*/
+
+/*
+--| NAME: MEMORY_POOL_BLOCK_ALIGNMENT
+--| DESCRIPTION: the alignment of every block, and the step block sizes are
+--|   rounded up to, in bytes
+--| TYPE: unsigned integer
+*/
+#define MEMORY_POOL_BLOCK_ALIGNMENT (4u)
+
+/*
+--|----------------------------------------------------------------------------|
+--| PUBLIC TYPES
+--|----------------------------------------------------------------------------|
+*/
+
+/*
+--| NAME: Memory_Pool_Variant_enum
+--| DESCRIPTION: how a pool tracks its free blocks
+*/
+typedef enum Memory_Pool_Variant_Enumeration
+{
+    MEMORY_POOL_VARIANT_FREE_LIST, // a list linked through the free blocks, O(1)
+    MEMORY_POOL_VARIANT_BITMAP,    // one bit per block, O(blocks / 32), catches double frees
+} Memory_Pool_Variant_enum;
+
+/*
+--| NAME: Memory_Pool_t
+--| DESCRIPTION: one pool of equal size blocks, owned by the caller. The
+--|   members are private to the memory pool.
+*/
+typedef struct Memory_Pool_Type
+{
+    Memory_Pool_Variant_enum variant;         // how free blocks are tracked
+    uint32_t                 block_size;      // bytes per block, a multiple of MEMORY_POOL_BLOCK_ALIGNMENT
+    uint32_t                 num_blocks;      // blocks in the pool
+    uint8_t *                p_storage;       // the first block
+    vuint32_t                free_head;       // address of the first free block, 0 if none [free list]
+    vuint32_t *              p_bitmap;        // 1 bit per block, set while allocated [bitmap]
+    vuint32_t                in_use;          // blocks allocated now
+    vuint32_t                high_water_mark; // most blocks ever allocated at once
+    vuint32_t                failed_allocs;   // allocations refused because the pool was empty
+} Memory_Pool_t;
+
+/*
+--| NAME: Memory_Pool_Stats_t
+--| DESCRIPTION: usage statistics of one pool
+*/
+typedef struct Memory_Pool_Stats_Type
+{
+    uint32_t block_size;      // bytes per block
+    uint32_t num_blocks;      // blocks in the pool
+    uint32_t in_use;          // blocks allocated now
+    uint32_t high_water_mark; // most blocks ever allocated at once
+    uint32_t failed_allocs;   // allocations refused because the pool was empty
+} Memory_Pool_Stats_t;
+
+/*
+--|----------------------------------------------------------------------------|
+--| PUBLIC CONSTANTS
+--|----------------------------------------------------------------------------|
+*/
+
+/* None */
+
+/*
+--|----------------------------------------------------------------------------|
+--| PUBLIC VARIABLES
+--|----------------------------------------------------------------------------|
+*/
+
+/* None */
+
+/*
+--|----------------------------------------------------------------------------|
+--| PUBLIC FUNCTION PROTOTYPES
+--|----------------------------------------------------------------------------|
+*/
+
+/*------------------------------------------------------------------------------
+Function Name:
+    Memory_Pool_Init
+
+Function Description:
+    Carve a pool of equal size blocks, and its bitmap if it has one, from
+    the memory pool region (_smemory_pool to _ememory_pool in the linker
+    script). All of the blocks start free.
+
+Parameters:
+    p_pool: pointer to the pool storage.
+    variant: how the pool tracks its free blocks.
+    block_size: bytes per block, rounded up to MEMORY_POOL_BLOCK_ALIGNMENT.
+    num_blocks: blocks in the pool [1 or more].
+
+Returns:
+    true if the pool was created, false if the region does not have room
+    for it.
+
+Assumptions/Limitations:
+    Must be called from thread context, before the pool is used by any
+    interrupt. The region is never given back, pools are meant to be made
+    once at startup.
+------------------------------------------------------------------------------*/
+bool Memory_Pool_Init(Memory_Pool_t * p_pool, Memory_Pool_Variant_enum variant, uint32_t block_size, uint32_t num_blocks);
+
+/*------------------------------------------------------------------------------
+Function Name:
+    Memory_Pool_Alloc
+
+Function Description:
+    Take a free block from a pool.
+
+Parameters:
+    p_pool: pointer to the pool.
+
+Returns:
+    void *: the block, or NULL if the pool is empty.
+
+Assumptions/Limitations:
+    Lock-free, safe to call from thread context and interrupts at once.
+------------------------------------------------------------------------------*/
+void * Memory_Pool_Alloc(Memory_Pool_t * p_pool);
+
+/*------------------------------------------------------------------------------
+Function Name:
+    Memory_Pool_Free
+
+Function Description:
+    Return a block to the pool it came from.
+
+Parameters:
+    p_pool: pointer to the pool.
+    p_block: a block returned by Memory_Pool_Alloc for this pool.
+
+Returns:
+    true if the block was freed, false if it is not a block of this pool
+    (NULL, outside the storage of the pool or not at the start of a
+    block), or, for a bitmap pool, is already free. Nothing is changed
+    when false is returned.
+
+Assumptions/Limitations:
+    Lock-free, safe to call from thread context and interrupts at once.
+    A free list pool cannot catch a double free.
+------------------------------------------------------------------------------*/
+bool Memory_Pool_Free(Memory_Pool_t * p_pool, void * p_block);
+
+/*------------------------------------------------------------------------------
+Function Name:
+    Memory_Pool_Alloc_Size
+
+Function Description:
+    Take a block of at least the given size from a set of pools of
+    different block sizes (size classes), trying the smallest fitting
+    pool first and the larger ones if it is empty.
+
+Parameters:
+    pp_pools: the pools, in order of increasing block size.
+    num_pools: the number of pools.
+    size: the bytes needed.
+
+Returns:
+    void *: the block, or NULL if no fitting pool has a free block.
+
+Assumptions/Limitations:
+    Lock-free, safe to call from thread context and interrupts at once.
+------------------------------------------------------------------------------*/
+void * Memory_Pool_Alloc_Size(Memory_Pool_t * const * pp_pools, uint32_t num_pools, uint32_t size);
+
+/*------------------------------------------------------------------------------
+Function Name:
+    Memory_Pool_Free_Any
+
+Function Description:
+    Return a block from Memory_Pool_Alloc_Size to the pool it came from.
+
+Parameters:
+    pp_pools: the pools given to Memory_Pool_Alloc_Size.
+    num_pools: the number of pools.
+    p_block: the block.
+
+Returns:
+    true if the block was freed, false if no pool owns it.
+
+Assumptions/Limitations:
+    Lock-free, safe to call from thread context and interrupts at once.
+------------------------------------------------------------------------------*/
+bool Memory_Pool_Free_Any(Memory_Pool_t * const * pp_pools, uint32_t num_pools, void * p_block);
+
+/*------------------------------------------------------------------------------
+Function Name:
+    Memory_Pool_Get_Stats
+
+Function Description:
+    Get the usage statistics of a pool.
+
+Parameters:
+    p_pool: pointer to the pool.
+    p_stats: filled in with the statistics.
+
+Returns:
+    None
+
+Assumptions/Limitations:
+    The members are read one at a time, so an allocation or free from an
+    interrupt during the call may leave them a block apart.
+------------------------------------------------------------------------------*/
+void Memory_Pool_Get_Stats(Memory_Pool_t * p_pool, Memory_Pool_Stats_t * p_stats);
+
+/*------------------------------------------------------------------------------
+Function Name:
+    Memory_Pool_Get_Region_Free
+
+Function Description:
+    Get the bytes of the memory pool region not yet carved into pools.
+
+Parameters:
+    None
+
+Returns:
+    uint32_t: the free bytes.
+
+Assumptions/Limitations:
+    None
+------------------------------------------------------------------------------*/
+uint32_t Memory_Pool_Get_Region_Free(void);
+
+#endif
@@ -22,6 +22,7 @@
 */
 
 #include "Common_Typedefs.h"
+#include "PSP_NVIC_Vectors.h"
 #include "PSP_Peripherals_Memory_Map.h"
 
 /*
@@ -37,6 +38,21 @@
 */
 #define NVIC ((volatile NVIC_t *)PSP_CORE_PERIPHERAL_NVIC_BASE)
 
+/*
+--| NAME: NVIC_PRIORITY_BITS
+--| DESCRIPTION: the number of priority bits implemented by the STM32F103,
+--|   the upper bits of each 8 bit priority register
+--| TYPE: unsigned integer
+*/
+#define NVIC_PRIORITY_BITS (4u)
+
+/*
+--| NAME: NVIC_LOWEST_PRIORITY
+--| DESCRIPTION: the lowest (numerically largest) priority value
+--| TYPE: unsigned integer
+*/
+#define NVIC_LOWEST_PRIORITY ((1u << NVIC_PRIORITY_BITS) - 1u)
+
 /*
 --|----------------------------------------------------------------------------|
 --| PUBLIC TYPES
@@ -127,6 +143,19 @@ typedef enum IRQn_Type
     OTG_FS_WKUP_IRQn   = 42, // USB On-The-Go FS Wakeup through EXTI line interrupt
 } IRQn_t;
 
+/*
+--| NAME: NVIC_Handler_t
+--| DESCRIPTION: an exception or interrupt handler
+*/
+typedef void (*NVIC_Handler_t)(void);
+
+/*
+--| NAME: NVIC_Dispatch_Handler_t
+--| DESCRIPTION: an interrupt handler which is passed the context it was
+--|   attached with, for example a driver handle
+*/
+typedef void (*NVIC_Dispatch_Handler_t)(void * p_context);
+
 /*
 --|----------------------------------------------------------------------------|
 --| PUBLIC CONSTANTS
@@ -149,6 +178,386 @@ typedef enum IRQn_Type
 --|----------------------------------------------------------------------------|
 */
 
-/* None */
+/*------------------------------------------------------------------------------
+Function Name:
+    NVIC_Enable_IRQ
+
+Function Description:
+    Enable an interrupt in the NVIC.
+
+Parameters:
+    IRQn: the interrupt number.
+
+Returns:
+    None
+
+Assumptions/Limitations:
+    Device interrupts only (IRQn >= 0).
+------------------------------------------------------------------------------*/
+void NVIC_Enable_IRQ(IRQn_t IRQn);
+
+/*------------------------------------------------------------------------------
+Function Name:
+    NVIC_Disable_IRQ
+
+Function Description:
+    Disable an interrupt in the NVIC. Barriers make sure the interrupt can
+    no longer be taken once this returns.
+
+Parameters:
+    IRQn: the interrupt number.
+
+Returns:
+    None
+
+Assumptions/Limitations:
+    Device interrupts only (IRQn >= 0).
+------------------------------------------------------------------------------*/
+void NVIC_Disable_IRQ(IRQn_t IRQn);
+
+/*------------------------------------------------------------------------------
+Function Name:
+    NVIC_Is_Enabled
+
+Function Description:
+    Check whether an interrupt is enabled in the NVIC.
+
+Parameters:
+    IRQn: the interrupt number.
+
+Returns:
+    true if enabled.
+
+Assumptions/Limitations:
+    Device interrupts only (IRQn >= 0).
+------------------------------------------------------------------------------*/
+bool NVIC_Is_Enabled(IRQn_t IRQn);
+
+/*------------------------------------------------------------------------------
+Function Name:
+    NVIC_Set_Pending
+
+Function Description:
+    Make an interrupt pending, so it is taken as if its peripheral had
+    requested it.
+
+Parameters:
+    IRQn: the interrupt number.
+
+Returns:
+    None
+
+Assumptions/Limitations:
+    Device interrupts only (IRQn >= 0).
+------------------------------------------------------------------------------*/
+void NVIC_Set_Pending(IRQn_t IRQn);
+
+/*------------------------------------------------------------------------------
+Function Name:
+    NVIC_Clear_Pending
+
+Function Description:
+    Remove the pending state of an interrupt.
+
+Parameters:
+    IRQn: the interrupt number.
+
+Returns:
+    None
+
+Assumptions/Limitations:
+    Device interrupts only (IRQn >= 0). A peripheral which still requests
+    the interrupt makes it pending again.
+------------------------------------------------------------------------------*/
+void NVIC_Clear_Pending(IRQn_t IRQn);
+
+/*------------------------------------------------------------------------------
+Function Name:
+    NVIC_Is_Pending
+
+Function Description:
+    Check whether an interrupt is pending.
+
+Parameters:
+    IRQn: the interrupt number.
+
+Returns:
+    true if pending.
+
+Assumptions/Limitations:
+    Device interrupts only (IRQn >= 0).
+------------------------------------------------------------------------------*/
+bool NVIC_Is_Pending(IRQn_t IRQn);
+
+/*------------------------------------------------------------------------------
+Function Name:
+    NVIC_Is_Active
+
+Function Description:
+    Check whether an interrupt's handler is running or preempted.
+
+Parameters:
+    IRQn: the interrupt number.
+
+Returns:
+    true if active.
+
+Assumptions/Limitations:
+    Device interrupts only (IRQn >= 0).
+------------------------------------------------------------------------------*/
+bool NVIC_Is_Active(IRQn_t IRQn);
+
+/*------------------------------------------------------------------------------
+Function Name:
+    NVIC_Set_Priority
+
+Function Description:
+    Set the priority of an interrupt or system exception. Lower values are
+    more urgent.
+
+Parameters:
+    IRQn: the interrupt number, or a negative system exception number
+        from MemManage_IRQn up.
+    priority: the priority [0 to NVIC_LOWEST_PRIORITY], for example from
+        NVIC_Encode_Priority.
+
+Returns:
+    None
+
+Assumptions/Limitations:
+    NMI and HardFault have fixed priorities and cannot be set.
+------------------------------------------------------------------------------*/
+void NVIC_Set_Priority(IRQn_t IRQn, uint32_t priority);
+
+/*------------------------------------------------------------------------------
+Function Name:
+    NVIC_Get_Priority
+
+Function Description:
+    Get the priority of an interrupt or system exception.
+
+Parameters:
+    IRQn: the interrupt number, or a negative system exception number
+        from MemManage_IRQn up.
+
+Returns:
+    uint32_t: the priority [0 to NVIC_LOWEST_PRIORITY].
+
+Assumptions/Limitations:
+    None
+------------------------------------------------------------------------------*/
+uint32_t NVIC_Get_Priority(IRQn_t IRQn);
+
+/*------------------------------------------------------------------------------
+Function Name:
+    NVIC_Set_Priority_Grouping
+
+Function Description:
+    Split the priority bits into preemption priority (group) bits, which
+    decide whether one interrupt can interrupt another, and subpriority
+    bits, which only order pending interrupts.
+
+Parameters:
+    preempt_bits: the number of preemption priority bits
+        [0 to NVIC_PRIORITY_BITS], the rest are subpriority.
+
+Returns:
+    None
+
+Assumptions/Limitations:
+    Set once at start up, before setting any priorities.
+------------------------------------------------------------------------------*/
+void NVIC_Set_Priority_Grouping(uint32_t preempt_bits);
+
+/*------------------------------------------------------------------------------
+Function Name:
+    NVIC_Get_Priority_Grouping
+
+Function Description:
+    Get the number of preemption priority bits.
+
+Parameters:
+    None
+
+Returns:
+    uint32_t: the number of preemption priority bits [0 to NVIC_PRIORITY_BITS].
+
+Assumptions/Limitations:
+    None
+------------------------------------------------------------------------------*/
+uint32_t NVIC_Get_Priority_Grouping(void);
+
+/*------------------------------------------------------------------------------
+Function Name:
+    NVIC_Encode_Priority
+
+Function Description:
+    Combine a preemption priority and a subpriority into a priority value,
+    using the current priority grouping.
+
+Parameters:
+    preempt_priority: the preemption priority.
+    sub_priority: the subpriority.
+
+Returns:
+    uint32_t: the priority value for NVIC_Set_Priority.
+
+Assumptions/Limitations:
+    Bits which do not fit in the current grouping are dropped.
+------------------------------------------------------------------------------*/
+uint32_t NVIC_Encode_Priority(uint32_t preempt_priority, uint32_t sub_priority);
+
+/*------------------------------------------------------------------------------
+Function Name:
+    NVIC_Critical_Section_Enter
+
+Function Description:
+    Mask interrupts with a priority value of mask_priority or greater (less
+    urgent) using BASEPRI, while more urgent interrupts keep running. This
+    protects data shared with low priority handlers without delaying high
+    rate timer and DMA handlers, which must not touch that data.
+
+Parameters:
+    mask_priority: the most urgent priority to mask [1 to
+        NVIC_LOWEST_PRIORITY], as a preemption priority value.
+
+Returns:
+    uint32_t: the previous masking level, for NVIC_Critical_Section_Exit.
+
+Assumptions/Limitations:
+    Sections nest: an inner section never lowers the masking level of an
+    outer one. Priority 0 interrupts cannot be masked by BASEPRI, use
+    Core_Disable_Interrupts for those.
+------------------------------------------------------------------------------*/
+uint32_t NVIC_Critical_Section_Enter(uint32_t mask_priority);
+
+/*------------------------------------------------------------------------------
+Function Name:
+    NVIC_Critical_Section_Exit
+
+Function Description:
+    Restore the masking level from before the matching
+    NVIC_Critical_Section_Enter.
+
+Parameters:
+    previous_mask: the value returned by NVIC_Critical_Section_Enter.
+
+Returns:
+    None
+
+Assumptions/Limitations:
+    None
+------------------------------------------------------------------------------*/
+void NVIC_Critical_Section_Exit(uint32_t previous_mask);
+
+/*------------------------------------------------------------------------------
+Function Name:
+    NVIC_Relocate_Vector_Table
+
+Function Description:
+    Copy the vector table from flash into SRAM and point VTOR at the copy.
+    Handlers can then be replaced at runtime with NVIC_Set_Vector, and
+    exception entry fetches the vector from SRAM with no flash wait states.
+
+Parameters:
+    None
+
+Returns:
+    None
+
+Assumptions/Limitations:
+    Call once at start up. Uses NVIC_NUM_VECTORS words of SRAM.
+------------------------------------------------------------------------------*/
+void NVIC_Relocate_Vector_Table(void);
+
+/*------------------------------------------------------------------------------
+Function Name:
+    NVIC_Set_Vector
+
+Function Description:
+    Replace the handler of an interrupt or system exception in the SRAM
+    vector table.
+
+Parameters:
+    IRQn: the interrupt number, or a negative system exception number.
+    handler: the new handler.
+
+Returns:
+    true if the handler was replaced, false if the vector table has not
+    been relocated to SRAM or IRQn is outside [NMI_IRQn to NVIC_NUM_IRQS - 1].
+
+Assumptions/Limitations:
+    The new handler is used from the next time the exception is taken.
+    Disable the interrupt first if the old and new handlers must not
+    overlap.
+------------------------------------------------------------------------------*/
+bool NVIC_Set_Vector(IRQn_t IRQn, NVIC_Handler_t handler);
+
+/*------------------------------------------------------------------------------
+Function Name:
+    NVIC_Get_Vector
+
+Function Description:
+    Get the handler of an interrupt or system exception from the active
+    vector table.
+
+Parameters:
+    IRQn: the interrupt number, or a negative system exception number.
+
+Returns:
+    NVIC_Handler_t: the handler.
+
+Assumptions/Limitations:
+    None
+------------------------------------------------------------------------------*/
+NVIC_Handler_t NVIC_Get_Vector(IRQn_t IRQn);
+
+/*------------------------------------------------------------------------------
+Function Name:
+    NVIC_Attach_IRQ
+
+Function Description:
+    Route a device interrupt to a handler with a context pointer, so one
+    driver function can serve several peripheral instances without a
+    hand-written handler for each. The vector is pointed at a shared
+    dispatcher which looks up the running IRQ and makes a single indirect
+    call, handler(p_context).
+
+Parameters:
+    IRQn: the interrupt number.
+    handler: the handler.
+    p_context: passed to the handler on every interrupt.
+
+Returns:
+    true if attached, false if the vector table has not been relocated to
+    SRAM or IRQn is outside [0 to NVIC_NUM_IRQS - 1], in which case nothing
+    is changed.
+
+Assumptions/Limitations:
+    Requires NVIC_Relocate_Vector_Table. Does not enable the interrupt.
+    Disable the interrupt before re-attaching it, so the handler and
+    context cannot be seen half updated.
+------------------------------------------------------------------------------*/
+bool NVIC_Attach_IRQ(IRQn_t IRQn, NVIC_Dispatch_Handler_t handler, void * p_context);
+
+/*------------------------------------------------------------------------------
+Function Name:
+    NVIC_Detach_IRQ
+
+Function Description:
+    Restore the vector of a device interrupt to its handler from the flash
+    vector table.
+
+Parameters:
+    IRQn: the interrupt number.
+
+Returns:
+    None
+
+Assumptions/Limitations:
+    Has no effect if the vector table has not been relocated to SRAM, or if
+    IRQn is outside [0 to NVIC_NUM_IRQS - 1].
+------------------------------------------------------------------------------*/
+void NVIC_Detach_IRQ(IRQn_t IRQn);
 
 #endif
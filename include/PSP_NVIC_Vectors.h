@@ -0,0 +1,47 @@
+/*
+--|----------------------------------------------------------------------------|
+--| FILE DESCRIPTION:
+--|   PSP_NVIC_Vectors.h provides the size of the vector table. It holds
+--|   defines only, so vector_table.S can include it through the C
+--|   preprocessor and check the table against the same count as the C code.
+--|
+--|----------------------------------------------------------------------------|
+--| REFERENCES:
+--|   stm32f10x reference manual, page 197
+--|
+--|----------------------------------------------------------------------------|
+*/
+
+#ifndef PSP_NVIC_VECTORS_H_INCLUDED
+#define PSP_NVIC_VECTORS_H_INCLUDED
+
+/*
+--|----------------------------------------------------------------------------|
+--| INCLUDE FILES
+--|----------------------------------------------------------------------------|
+*/
+
+/* None */
+
+/*
+--|----------------------------------------------------------------------------|
+--| PUBLIC DEFINES
+--|----------------------------------------------------------------------------|
+*/
+
+/*
+--| NAME: NVIC_NUM_IRQS
+--| DESCRIPTION: the number of device interrupts, IRQn 0 to OTG_FS_WKUP_IRQn
+--| TYPE: unsigned integer
+*/
+#define NVIC_NUM_IRQS (43u)
+
+/*
+--| NAME: NVIC_NUM_VECTORS
+--| DESCRIPTION: the number of vector table entries, the initial stack
+--|   pointer and 15 system exceptions then the device interrupts
+--| TYPE: unsigned integer
+*/
+#define NVIC_NUM_VECTORS (16u + NVIC_NUM_IRQS)
+
+#endif
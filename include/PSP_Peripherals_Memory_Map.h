@@ -84,10 +84,12 @@
 */
 #define PSP_CORE_PERIPHERAL_BASE      (0xE0000000u)
 
+#define PSP_CORE_PERIPHERAL_DWT_BASE  (PSP_CORE_PERIPHERAL_BASE | 0x00001000u)
 #define PSP_CORE_PERIPHERAL_STK_BASE  (PSP_CORE_PERIPHERAL_BASE | 0x0000E010u)
 #define PSP_CORE_PERIPHERAL_NVIC_BASE (PSP_CORE_PERIPHERAL_BASE | 0x0000E100u)
 #define PSP_CORE_PERIPHERAL_SCB_BASE  (PSP_CORE_PERIPHERAL_BASE | 0x0000ED00u)
 #define PSP_CORE_PERIPHERAL_MPU_BASE  (PSP_CORE_PERIPHERAL_BASE | 0x0000ED90u)
+#define PSP_CORE_PERIPHERAL_DCB_BASE  (PSP_CORE_PERIPHERAL_BASE | 0x0000EDF0u)
 
 /*
 --|----------------------------------------------------------------------------|
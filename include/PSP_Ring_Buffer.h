@@ -0,0 +1,295 @@
+/*
+--|----------------------------------------------------------------------------|
+--| FILE DESCRIPTION:
+--|   PSP_Ring_Buffer.h provides types and interfaces for a single producer,
+--|   single consumer byte ring buffer, for passing data between an
+--|   interrupt and thread context without masking interrupts.
+--|
+--|----------------------------------------------------------------------------|
+--| REFERENCES:
+--|   None.
+--|
+--|----------------------------------------------------------------------------|
+*/
+
+#ifndef PSP_RING_BUFFER_H_INCLUDED
+#define PSP_RING_BUFFER_H_INCLUDED
+
+/*
+--|----------------------------------------------------------------------------|
+--| INCLUDE FILES
+--|----------------------------------------------------------------------------|
+*/
+
+#include "Common_Typedefs.h"
+
+/*
+--|----------------------------------------------------------------------------|
+--| PUBLIC DEFINES
+--|----------------------------------------------------------------------------|
+*/
+
+/* None */
+
+/*
+--|----------------------------------------------------------------------------|
+--| PUBLIC TYPES
+--|----------------------------------------------------------------------------|
+*/
+
+/*
+--| NAME: Ring_Buffer_t
+--| DESCRIPTION: a ring buffer over caller owned storage. The head and tail
+--|   are free running byte counts, so the buffer can be completely full,
+--|   and each is only written by one side. The members are private to the
+--|   ring buffer.
+*/
+typedef struct Ring_Buffer_Type
+{
+    uint8_t *         p_buffer; // the storage
+    uint32_t          mask;     // the storage size - 1, the size is a power of 2
+    volatile uint32_t head;     // bytes written so far, only written by the producer
+    volatile uint32_t tail;     // bytes read so far, only written by the consumer
+} Ring_Buffer_t;
+
+/*
+--|----------------------------------------------------------------------------|
+--| PUBLIC CONSTANTS
+--|----------------------------------------------------------------------------|
+*/
+
+/* None */
+
+/*
+--|----------------------------------------------------------------------------|
+--| PUBLIC VARIABLES
+--|----------------------------------------------------------------------------|
+*/
+
+/* None */
+
+/*
+--|----------------------------------------------------------------------------|
+--| PUBLIC FUNCTION PROTOTYPES
+--|----------------------------------------------------------------------------|
+*/
+
+/*------------------------------------------------------------------------------
+Function Name:
+    Ring_Buffer_Init
+
+Function Description:
+    Set up an empty ring buffer over the given storage.
+
+Parameters:
+    p_ring: pointer to the ring buffer.
+    p_buffer: the storage.
+    size: the storage size in bytes, a power of 2.
+
+Returns:
+    true if the ring buffer was set up, false if size is not a power of 2.
+
+Assumptions/Limitations:
+    Must not be called while either side is using the ring buffer.
+------------------------------------------------------------------------------*/
+bool Ring_Buffer_Init(Ring_Buffer_t * p_ring, uint8_t * p_buffer, uint32_t size);
+
+/*------------------------------------------------------------------------------
+Function Name:
+    Ring_Buffer_Get_Count
+
+Function Description:
+    Get the number of bytes waiting to be read.
+
+Parameters:
+    p_ring: pointer to the ring buffer.
+
+Returns:
+    uint32_t: the bytes waiting. Only grows while the consumer is not
+    reading, so the consumer may rely on it.
+
+Assumptions/Limitations:
+    None
+------------------------------------------------------------------------------*/
+uint32_t Ring_Buffer_Get_Count(Ring_Buffer_t * p_ring);
+
+/*------------------------------------------------------------------------------
+Function Name:
+    Ring_Buffer_Get_Free
+
+Function Description:
+    Get the number of bytes which can be written.
+
+Parameters:
+    p_ring: pointer to the ring buffer.
+
+Returns:
+    uint32_t: the free bytes. Only grows while the producer is not
+    writing, so the producer may rely on it.
+
+Assumptions/Limitations:
+    None
+------------------------------------------------------------------------------*/
+uint32_t Ring_Buffer_Get_Free(Ring_Buffer_t * p_ring);
+
+/*------------------------------------------------------------------------------
+Function Name:
+    Ring_Buffer_Put
+
+Function Description:
+    Write one byte.
+
+Parameters:
+    p_ring: pointer to the ring buffer.
+    data: the byte.
+
+Returns:
+    true if the byte was written, false if the ring buffer is full.
+
+Assumptions/Limitations:
+    Producer only.
+------------------------------------------------------------------------------*/
+bool Ring_Buffer_Put(Ring_Buffer_t * p_ring, uint8_t data);
+
+/*------------------------------------------------------------------------------
+Function Name:
+    Ring_Buffer_Get
+
+Function Description:
+    Read one byte.
+
+Parameters:
+    p_ring: pointer to the ring buffer.
+    p_data: set to the byte.
+
+Returns:
+    true if a byte was read, false if the ring buffer is empty.
+
+Assumptions/Limitations:
+    Consumer only.
+------------------------------------------------------------------------------*/
+bool Ring_Buffer_Get(Ring_Buffer_t * p_ring, uint8_t * p_data);
+
+/*------------------------------------------------------------------------------
+Function Name:
+    Ring_Buffer_Write
+
+Function Description:
+    Write as many of the given bytes as fit.
+
+Parameters:
+    p_ring: pointer to the ring buffer.
+    p_data: the bytes.
+    length: the number of bytes.
+
+Returns:
+    uint32_t: the number of bytes written.
+
+Assumptions/Limitations:
+    Producer only.
+------------------------------------------------------------------------------*/
+uint32_t Ring_Buffer_Write(Ring_Buffer_t * p_ring, const uint8_t * p_data, uint32_t length);
+
+/*------------------------------------------------------------------------------
+Function Name:
+    Ring_Buffer_Read
+
+Function Description:
+    Read as many bytes as are waiting, up to the given number.
+
+Parameters:
+    p_ring: pointer to the ring buffer.
+    p_data: filled in with the bytes.
+    max_length: the most bytes to read.
+
+Returns:
+    uint32_t: the number of bytes read.
+
+Assumptions/Limitations:
+    Consumer only.
+------------------------------------------------------------------------------*/
+uint32_t Ring_Buffer_Read(Ring_Buffer_t * p_ring, uint8_t * p_data, uint32_t max_length);
+
+/*------------------------------------------------------------------------------
+Function Name:
+    Ring_Buffer_Get_Write_Span
+
+Function Description:
+    Get the free space after the head which is contiguous in memory, so
+    it can be filled in place, for instance by DMA, then committed with
+    Ring_Buffer_Commit_Write.
+
+Parameters:
+    p_ring: pointer to the ring buffer.
+    p_length: set to the length of the span, 0 if the ring buffer is full.
+
+Returns:
+    uint8_t *: the start of the span.
+
+Assumptions/Limitations:
+    Producer only. A second span may follow at the start of the storage
+    once the first is committed.
+------------------------------------------------------------------------------*/
+uint8_t * Ring_Buffer_Get_Write_Span(Ring_Buffer_t * p_ring, uint32_t * p_length);
+
+/*------------------------------------------------------------------------------
+Function Name:
+    Ring_Buffer_Commit_Write
+
+Function Description:
+    Make bytes filled in through a write span visible to the consumer.
+
+Parameters:
+    p_ring: pointer to the ring buffer.
+    length: the number of bytes filled in, at most the span length.
+
+Returns:
+    None
+
+Assumptions/Limitations:
+    Producer only.
+------------------------------------------------------------------------------*/
+void Ring_Buffer_Commit_Write(Ring_Buffer_t * p_ring, uint32_t length);
+
+/*------------------------------------------------------------------------------
+Function Name:
+    Ring_Buffer_Get_Read_Span
+
+Function Description:
+    Get the waiting bytes after the tail which are contiguous in memory, so
+    they can be used in place, for instance sent by DMA, then released
+    with Ring_Buffer_Commit_Read.
+
+Parameters:
+    p_ring: pointer to the ring buffer.
+    p_length: set to the length of the span, 0 if the ring buffer is empty.
+
+Returns:
+    const uint8_t *: the start of the span.
+
+Assumptions/Limitations:
+    Consumer only. A second span may follow at the start of the storage
+    once the first is committed.
+------------------------------------------------------------------------------*/
+const uint8_t * Ring_Buffer_Get_Read_Span(Ring_Buffer_t * p_ring, uint32_t * p_length);
+
+/*------------------------------------------------------------------------------
+Function Name:
+    Ring_Buffer_Commit_Read
+
+Function Description:
+    Release bytes used through a read span, so the producer can reuse them.
+
+Parameters:
+    p_ring: pointer to the ring buffer.
+    length: the number of bytes used, at most the span length.
+
+Returns:
+    None
+
+Assumptions/Limitations:
+    Consumer only.
+------------------------------------------------------------------------------*/
+void Ring_Buffer_Commit_Read(Ring_Buffer_t * p_ring, uint32_t length);
+
+#endif
@@ -0,0 +1,193 @@
+/*
+--|----------------------------------------------------------------------------|
+--| FILE DESCRIPTION:
+--|   PSP_SCB.h provides types for the System Control Block, which holds the
+--|   core's exception state, vector table offset, sleep and fault control.
+--|
+--|----------------------------------------------------------------------------|
+--| REFERENCES:
+--|   PM0056 programming manual, page 129 (SCB)
+--|
+--|----------------------------------------------------------------------------|
+*/
+
+#ifndef PSP_SCB_H_INCLUDED
+#define PSP_SCB_H_INCLUDED
+
+/*
+--|----------------------------------------------------------------------------|
+--| INCLUDE FILES
+--|----------------------------------------------------------------------------|
+*/
+
+#include "Common_Masks.h"
+#include "Common_Typedefs.h"
+#include "PSP_Peripherals_Memory_Map.h"
+
+/*
+--|----------------------------------------------------------------------------|
+--| PUBLIC DEFINES
+--|----------------------------------------------------------------------------|
+*/
+
+/*
+--| NAME: SCB
+--| DESCRIPTION: pointer to the System Control Block
+--| TYPE: SCB_t*
+*/
+#define SCB ((volatile SCB_t *)PSP_CORE_PERIPHERAL_SCB_BASE)
+
+/*
+--|----------------------------------------------------------------------------|
+--| PUBLIC TYPES
+--|----------------------------------------------------------------------------|
+*/
+
+/*
+--| NAME: SCB_t
+--| DESCRIPTION: System Control Block structure
+*/
+typedef struct SCB_Type
+{
+    vuint32_t CPUID; // CPUID base register [r]
+    vuint32_t ICSR;  // interrupt control and state register
+    vuint32_t VTOR;  // vector table offset register
+    vuint32_t AIRCR; // application interrupt and reset control register
+    vuint32_t SCR;   // system control register
+    vuint32_t CCR;   // configuration and control register
+    vuint32_t SHPR1; // system handler priority register 1 [MemManage, BusFault, UsageFault]
+    vuint32_t SHPR2; // system handler priority register 2 [SVCall]
+    vuint32_t SHPR3; // system handler priority register 3 [PendSV, SysTick]
+    vuint32_t SHCSR; // system handler control and state register
+    vuint32_t CFSR;  // configurable fault status register
+    vuint32_t HFSR;  // hard fault status register
+    vuint32_t DFSR;  // debug fault status register
+    vuint32_t MMFAR; // memory management fault address register
+    vuint32_t BFAR;  // bus fault address register
+    vuint32_t AFSR;  // auxiliary fault status register
+} SCB_t;
+
+/*
+--| NAME: SCB_ICSR_FLAGS_enum
+--| DESCRIPTION: interrupt control and state register flags
+*/
+typedef enum SCB_ICSR_FLAGS_Enumeration
+{
+    SCB_ICSR_NMIPENDSET_FLAG = (1u << 31u), // set NMI pending [rw]
+    SCB_ICSR_PENDSVSET_FLAG  = (1u << 28u), // set PendSV pending [rw]
+    SCB_ICSR_PENDSVCLR_FLAG  = (1u << 27u), // clear PendSV pending [w]
+    SCB_ICSR_PENDSTSET_FLAG  = (1u << 26u), // set SysTick pending, reads 1 if pending [rw]
+    SCB_ICSR_PENDSTCLR_FLAG  = (1u << 25u), // clear SysTick pending [w]
+    SCB_ICSR_ISRPENDING_FLAG = (1u << 22u), // an interrupt other than NMI or a fault is pending [r]
+    SCB_ICSR_RETTOBASE_FLAG  = (1u << 11u), // no other exceptions are active [r]
+} SCB_ICSR_FLAGS_enum;
+
+/*
+--| NAME: SCB_ICSR_MASKS_enum
+--| DESCRIPTION: interrupt control and state register masks
+*/
+typedef enum SCB_ICSR_MASKS_Enumeration
+{
+    SCB_ICSR_VECTPENDING_MASK      = 0x3FFu, // highest priority pending exception number [10 bits, r]
+    SCB_ICSR_VECTPENDING_SHIFT_AMT = 12u,    // position of VECTPENDING in ICSR
+    SCB_ICSR_VECTACTIVE_MASK       = 0x1FFu, // active exception number [9 bits, r]
+    SCB_ICSR_VECTACTIVE_SHIFT_AMT  = 0u,     // position of VECTACTIVE in ICSR
+} SCB_ICSR_MASKS_enum;
+
+/*
+--| NAME: SCB_AIRCR_FLAGS_enum
+--| DESCRIPTION: application interrupt and reset control register flags
+*/
+typedef enum SCB_AIRCR_FLAGS_Enumeration
+{
+    SCB_AIRCR_ENDIANESS_FLAG     = (1u << 15u), // 0: little endian, 1: big endian [r]
+    SCB_AIRCR_SYSRESETREQ_FLAG   = (1u << 2u),  // request a system reset [w]
+    SCB_AIRCR_VECTCLRACTIVE_FLAG = (1u << 1u),  // reserved for debug use [w]
+    SCB_AIRCR_VECTRESET_FLAG     = (1u << 0u),  // reserved for debug use [w]
+} SCB_AIRCR_FLAGS_enum;
+
+/*
+--| NAME: SCB_AIRCR_MASKS_enum
+--| DESCRIPTION: application interrupt and reset control register masks
+*/
+typedef enum SCB_AIRCR_MASKS_Enumeration
+{
+    SCB_AIRCR_VECTKEY            = 0x05FAu,        // key which must be written with any change
+    SCB_AIRCR_VECTKEY_MASK       = 0xFFFFu,        // register key [16 bits, rw]
+    SCB_AIRCR_VECTKEY_SHIFT_AMT  = 16u,            // position of VECTKEY in AIRCR
+    SCB_AIRCR_PRIGROUP_MASK      = THREE_BIT_MASK, // interrupt priority grouping [3 bits, rw]
+    SCB_AIRCR_PRIGROUP_SHIFT_AMT = 8u,             // position of PRIGROUP in AIRCR
+} SCB_AIRCR_MASKS_enum;
+
+/*
+--| NAME: SCB_SCR_FLAGS_enum
+--| DESCRIPTION: system control register flags
+*/
+typedef enum SCB_SCR_FLAGS_Enumeration
+{
+    SCB_SCR_SEVONPEND_FLAG   = (1u << 4u), // pending interrupts wake the core from WFE [rw]
+    SCB_SCR_SLEEPDEEP_FLAG   = (1u << 2u), // 0: sleep, 1: deep sleep [rw]
+    SCB_SCR_SLEEPONEXIT_FLAG = (1u << 1u), // sleep on return to thread mode [rw]
+} SCB_SCR_FLAGS_enum;
+
+/*
+--| NAME: SCB_CCR_FLAGS_enum
+--| DESCRIPTION: configuration and control register flags
+*/
+typedef enum SCB_CCR_FLAGS_Enumeration
+{
+    SCB_CCR_STKALIGN_FLAG       = (1u << 9u), // 8 byte stack alignment on exception entry [rw]
+    SCB_CCR_BFHFNMIGN_FLAG      = (1u << 8u), // ignore bus faults in HardFault and NMI handlers [rw]
+    SCB_CCR_DIV_0_TRP_FLAG      = (1u << 4u), // trap divide by 0 [rw]
+    SCB_CCR_UNALIGN_TRP_FLAG    = (1u << 3u), // trap unaligned accesses [rw]
+    SCB_CCR_USERSETMPEND_FLAG   = (1u << 1u), // allow unprivileged access to the STIR [rw]
+    SCB_CCR_NONBASETHRDENA_FLAG = (1u << 0u), // allow thread mode with exceptions active [rw]
+} SCB_CCR_FLAGS_enum;
+
+/*
+--| NAME: SCB_SHCSR_FLAGS_enum
+--| DESCRIPTION: system handler control and state register flags
+*/
+typedef enum SCB_SHCSR_FLAGS_Enumeration
+{
+    SCB_SHCSR_USGFAULTENA_FLAG    = (1u << 18u), // enable UsageFault [rw]
+    SCB_SHCSR_BUSFAULTENA_FLAG    = (1u << 17u), // enable BusFault [rw]
+    SCB_SHCSR_MEMFAULTENA_FLAG    = (1u << 16u), // enable MemManage fault [rw]
+    SCB_SHCSR_SVCALLPENDED_FLAG   = (1u << 15u), // SVCall is pending [rw]
+    SCB_SHCSR_BUSFAULTPENDED_FLAG = (1u << 14u), // BusFault is pending [rw]
+    SCB_SHCSR_MEMFAULTPENDED_FLAG = (1u << 13u), // MemManage fault is pending [rw]
+    SCB_SHCSR_USGFAULTPENDED_FLAG = (1u << 12u), // UsageFault is pending [rw]
+    SCB_SHCSR_SYSTICKACT_FLAG     = (1u << 11u), // SysTick is active [rw]
+    SCB_SHCSR_PENDSVACT_FLAG      = (1u << 10u), // PendSV is active [rw]
+    SCB_SHCSR_MONITORACT_FLAG     = (1u << 8u),  // debug monitor is active [rw]
+    SCB_SHCSR_SVCALLACT_FLAG      = (1u << 7u),  // SVCall is active [rw]
+    SCB_SHCSR_USGFAULTACT_FLAG    = (1u << 3u),  // UsageFault is active [rw]
+    SCB_SHCSR_BUSFAULTACT_FLAG    = (1u << 1u),  // BusFault is active [rw]
+    SCB_SHCSR_MEMFAULTACT_FLAG    = (1u << 0u),  // MemManage fault is active [rw]
+} SCB_SHCSR_FLAGS_enum;
+
+/*
+--|----------------------------------------------------------------------------|
+--| PUBLIC CONSTANTS
+--|----------------------------------------------------------------------------|
+*/
+
+/* None */
+
+/*
+--|----------------------------------------------------------------------------|
+--| PUBLIC VARIABLES
+--|----------------------------------------------------------------------------|
+*/
+
+/* None */
+
+/*
+--|----------------------------------------------------------------------------|
+--| PUBLIC FUNCTION PROTOTYPES
+--|----------------------------------------------------------------------------|
+*/
+
+/* None */
+
+#endif
@@ -0,0 +1,159 @@
+/*
+--|----------------------------------------------------------------------------|
+--| FILE DESCRIPTION:
+--|   PSP_Stack.h provides interfaces for measuring the main stack and
+--|   checking it for overflow.
+--|
+--|   The stack runs from _estack down to _sstack_limit in the linker
+--|   script, and its lowest _stack_guard_size bytes are a guard region.
+--|   reset_handler paints the whole stack with STACK_PAINT_PATTERN when
+--|   built with STACK_PAINT defined, or just the guard region when built
+--|   with STACK_GUARD_CHECK defined. With STACK_GUARD_CHECK the SysTick
+--|   interrupt checks the guard region every mSec.
+--|
+--|----------------------------------------------------------------------------|
+--| REFERENCES:
+--|   None.
+--|
+--|----------------------------------------------------------------------------|
+*/
+
+#ifndef PSP_STACK_H_INCLUDED
+#define PSP_STACK_H_INCLUDED
+
+/*
+--|----------------------------------------------------------------------------|
+--| INCLUDE FILES
+--|----------------------------------------------------------------------------|
+*/
+
+#include "Common_Typedefs.h"
+
+/*
+--|----------------------------------------------------------------------------|
+--| PUBLIC DEFINES
+--|----------------------------------------------------------------------------|
+*/
+
+/*
+--| NAME: STACK_PAINT_PATTERN
+--| DESCRIPTION: the word unused stack is painted with, must match
+--|   STACK_PAINT_PATTERN in asm_core.S
+--| TYPE: unsigned integer
+*/
+#define STACK_PAINT_PATTERN (0xDEADBEEFu)
+
+/*
+--|----------------------------------------------------------------------------|
+--| PUBLIC TYPES
+--|----------------------------------------------------------------------------|
+*/
+
+/* None */
+
+/*
+--|----------------------------------------------------------------------------|
+--| PUBLIC CONSTANTS
+--|----------------------------------------------------------------------------|
+*/
+
+/* None */
+
+/*
+--|----------------------------------------------------------------------------|
+--| PUBLIC VARIABLES
+--|----------------------------------------------------------------------------|
+*/
+
+/* None */
+
+/*
+--|----------------------------------------------------------------------------|
+--| PUBLIC FUNCTION PROTOTYPES
+--|----------------------------------------------------------------------------|
+*/
+
+/*------------------------------------------------------------------------------
+Function Name:
+    Stack_Get_Size
+
+Function Description:
+    Get the size of the stack, including the guard region.
+
+Parameters:
+    None
+
+Returns:
+    uint32_t: the size in bytes.
+
+Assumptions/Limitations:
+    None
+------------------------------------------------------------------------------*/
+uint32_t Stack_Get_Size(void);
+
+/*------------------------------------------------------------------------------
+Function Name:
+    Stack_Get_High_Water_Mark
+
+Function Description:
+    Get the most stack used since reset, by searching up from the bottom
+    of the stack for the first word which is no longer painted.
+
+Parameters:
+    None
+
+Returns:
+    uint32_t: the most bytes used.
+
+Assumptions/Limitations:
+    Only meaningful when built with STACK_PAINT defined. A frame which
+    happens to store STACK_PAINT_PATTERN at its deepest word is counted
+    a word short. Takes time proportional to the unused stack, so it is
+    meant for thread context, not interrupts.
+------------------------------------------------------------------------------*/
+uint32_t Stack_Get_High_Water_Mark(void);
+
+/*------------------------------------------------------------------------------
+Function Name:
+    Stack_Is_Guard_Intact
+
+Function Description:
+    Check that every word of the guard region still holds
+    STACK_PAINT_PATTERN, so the stack has not overflowed into it.
+
+Parameters:
+    None
+
+Returns:
+    true if the guard region is intact, else false.
+
+Assumptions/Limitations:
+    Only meaningful when built with STACK_PAINT or STACK_GUARD_CHECK
+    defined. This part has no MPU, so an overflow is caught after the
+    fact, and only if it wrote to the guard region.
+------------------------------------------------------------------------------*/
+bool Stack_Is_Guard_Intact(void);
+
+/*------------------------------------------------------------------------------
+Function Name:
+    Stack_Overflow_Handler
+
+Function Description:
+    Called from the SysTick interrupt when built with STACK_GUARD_CHECK
+    defined and the guard region has been overwritten. The default masks
+    interrupts and halts at a breakpoint. The application may replace it
+    by defining its own, for instance to log and reset.
+
+Parameters:
+    None
+
+Returns:
+    None
+
+Assumptions/Limitations:
+    Runs in interrupt context with the stack already overflowed, so it
+    should use as little stack as possible.
+------------------------------------------------------------------------------*/
+void Stack_Overflow_Handler(void);
+
+#endif
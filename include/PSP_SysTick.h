@@ -36,6 +36,13 @@
 */
 #define SysTick ((volatile SysTick_t *)PSP_CORE_PERIPHERAL_STK_BASE)
 
+/*
+--| NAME: SYSTICK_MAX_RELOAD
+--| DESCRIPTION: the largest value the 24 bit reload register can hold
+--| TYPE: unsigned integer
+*/
+#define SYSTICK_MAX_RELOAD (0x00FFFFFFu)
+
 /*
 --|----------------------------------------------------------------------------|
 --| PUBLIC TYPES
@@ -76,6 +83,15 @@ typedef struct SysTick_Timeout_Timer_Type
     uint32_t timeout_start_mSec;  // the time in mSec when the timer was started
 } SysTick_Timeout_Timer_t;
 
+/*
+--| NAME: SysTick_Deadline_t
+--| DESCRIPTION: structure for absolute deadline storage
+*/
+typedef struct SysTick_Deadline_Type
+{
+    uint64_t deadline_mSec; // the 64 bit time in mSec when the deadline passes
+} SysTick_Deadline_t;
+
 /*
 --|----------------------------------------------------------------------------|
 --| PUBLIC CONSTANTS
@@ -130,10 +146,74 @@ Returns:
     uint32_t: the number of milliseconds since reset.
 
 Assumptions/Limitations:
-    None
+    This is the low 32 bits of the count, which wraps after about 49.7 days.
+    The difference of two readings taken with unsigned subtraction is still
+    correct across a wrap, for intervals shorter than 2^32 mSec. Use
+    SysTick_Get_mSec_64 or a SysTick_Deadline_t for absolute times.
 ------------------------------------------------------------------------------*/
 uint32_t SysTick_Get_mSec(void);
 
+/*------------------------------------------------------------------------------
+Function Name:
+    SysTick_Get_mSec_64
+
+Function Description:
+    Get the number of milliseconds since the last power on/reset, as a 64 bit
+    count which never wraps.
+
+Parameters:
+    None
+
+Returns:
+    uint64_t: the number of milliseconds since reset.
+
+Assumptions/Limitations:
+    Lock free: the two halves are read high, low, high and read again if the
+    SysTick interrupt carried into the high word in between. Safe from
+    thread context and from any interrupt which can not preempt the SysTick
+    interrupt.
+------------------------------------------------------------------------------*/
+uint64_t SysTick_Get_mSec_64(void);
+
+/*------------------------------------------------------------------------------
+Function Name:
+    SysTick_Get_Cycles_64
+
+Function Description:
+    Get the number of core clock cycles since the last power on/reset, from
+    the 64 bit millisecond count and the SysTick current value register.
+
+Parameters:
+    None
+
+Returns:
+    uint64_t: the number of core clock cycles since reset.
+
+Assumptions/Limitations:
+    A tick which is pending but not yet handled (for instance while
+    interrupts are masked) is accounted for, so the result never goes
+    backwards. Same context limits as SysTick_Get_mSec_64.
+------------------------------------------------------------------------------*/
+uint64_t SysTick_Get_Cycles_64(void);
+
+/*------------------------------------------------------------------------------
+Function Name:
+    SysTick_Get_uSec_64
+
+Function Description:
+    Get the number of microseconds since the last power on/reset.
+
+Parameters:
+    None
+
+Returns:
+    uint64_t: the number of microseconds since reset.
+
+Assumptions/Limitations:
+    Same as SysTick_Get_Cycles_64.
+------------------------------------------------------------------------------*/
+uint64_t SysTick_Get_uSec_64(void);
+
 /*------------------------------------------------------------------------------
 Function Name:
     SysTick_Start_Timeout_Timer
@@ -168,6 +248,9 @@ Returns:
 
 Assumptions/Limitations:
     Assumes that the data in the given timeout timer is sensible.
+
+    The elapsed time is found by unsigned subtraction, so the timer works
+    across a wrap of the 32 bit mSec count.
 ------------------------------------------------------------------------------*/
 bool SysTick_Poll_One_Shot_Timer(SysTick_Timeout_Timer_t * p_timer);
 
@@ -193,4 +276,159 @@ Assumptions/Limitations:
 ------------------------------------------------------------------------------*/
 bool SysTick_Poll_Periodic_Timer(SysTick_Timeout_Timer_t * p_timer);
 
+/*------------------------------------------------------------------------------
+Function Name:
+    SysTick_Deadline_From_Now
+
+Function Description:
+    Set a deadline a given number of milliseconds from now.
+
+Parameters:
+    p_deadline: pointer to the deadline.
+    mSec: the time from now in mSec.
+
+Returns:
+    None
+
+Assumptions/Limitations:
+    None
+------------------------------------------------------------------------------*/
+void SysTick_Deadline_From_Now(SysTick_Deadline_t * p_deadline, uint32_t mSec);
+
+/*------------------------------------------------------------------------------
+Function Name:
+    SysTick_Deadline_Advance
+
+Function Description:
+    Move a deadline later by a given number of milliseconds. Advancing from
+    the previous deadline rather than from now gives periodic loops which do
+    not drift.
+
+Parameters:
+    p_deadline: pointer to the deadline.
+    mSec: the time to add in mSec.
+
+Returns:
+    None
+
+Assumptions/Limitations:
+    None
+------------------------------------------------------------------------------*/
+void SysTick_Deadline_Advance(SysTick_Deadline_t * p_deadline, uint32_t mSec);
+
+/*------------------------------------------------------------------------------
+Function Name:
+    SysTick_Deadline_Has_Passed
+
+Function Description:
+    Check if a deadline has been reached.
+
+Parameters:
+    p_deadline: pointer to the deadline.
+
+Returns:
+    true if the deadline has been reached, else false.
+
+Assumptions/Limitations:
+    None
+------------------------------------------------------------------------------*/
+bool SysTick_Deadline_Has_Passed(SysTick_Deadline_t * p_deadline);
+
+/*------------------------------------------------------------------------------
+Function Name:
+    SysTick_Deadline_Get_mSec_Remaining
+
+Function Description:
+    Get the time left until a deadline.
+
+Parameters:
+    p_deadline: pointer to the deadline.
+
+Returns:
+    uint64_t: the time left in mSec, 0 if the deadline has passed.
+
+Assumptions/Limitations:
+    None
+------------------------------------------------------------------------------*/
+uint64_t SysTick_Deadline_Get_mSec_Remaining(SysTick_Deadline_t * p_deadline);
+
+/*------------------------------------------------------------------------------
+Function Name:
+    SysTick_Sleep_Until
+
+Function Description:
+    Sleep with SysTick_Tickless_Idle until a deadline is reached. Returns
+    immediately if the deadline has already passed.
+
+    For a periodic loop without drift, set the deadline once and then call
+    SysTick_Sleep_Until and SysTick_Deadline_Advance each time around.
+
+Parameters:
+    p_deadline: pointer to the deadline.
+
+Returns:
+    None
+
+Assumptions/Limitations:
+    Same as SysTick_Tickless_Idle. Interrupts which wake the core early are
+    handled, and the sleep continues until the deadline.
+------------------------------------------------------------------------------*/
+void SysTick_Sleep_Until(SysTick_Deadline_t * p_deadline);
+
+/*------------------------------------------------------------------------------
+Function Name:
+    SysTick_Tickless_Idle
+
+Function Description:
+    Sleep for up to the given number of milliseconds without taking the
+    periodic SysTick interrupt. The SysTick reload is stretched to the
+    deadline, the core waits for an interrupt (WFI), and on wakeup the
+    millisecond count is corrected for the ticks which were skipped and the
+    normal 1 mSec tick is resumed in phase.
+
+    The sleep ends early if any other interrupt fires. Time spent idle is
+    accounted for either way, so callers should recompute their next
+    deadline afterwards.
+
+Parameters:
+    idle_mSec: the longest time to sleep in mSec. Values above
+        SysTick_Get_Max_Idle_mSec() are clamped. 0 returns immediately and
+        1 sleeps until the next normal tick.
+
+Returns:
+    None
+
+Assumptions/Limitations:
+    Must be called from thread context with interrupts enabled, typically
+    from the main loop with the result of
+    Timer_Wheel_Get_mSec_Until_Next_Expiry.
+
+    The counter is stopped for a few cycles while it is reprogrammed, so
+    each tickless sleep loses a few core clock cycles of SysTick time. The
+    DWT cycle counter is clocked by HCLK, which WFI gates, so it stops
+    while asleep. The cycles it missed, measured by SysTick, are added to
+    it on wakeup, so DWT_Get_Cycles stays in step with SysTick time to
+    within a few cycles per sleep.
+------------------------------------------------------------------------------*/
+void SysTick_Tickless_Idle(uint32_t idle_mSec);
+
+/*------------------------------------------------------------------------------
+Function Name:
+    SysTick_Get_Max_Idle_mSec
+
+Function Description:
+    Get the longest tickless sleep which fits in the 24 bit reload register
+    at the current core clock speed.
+
+Parameters:
+    None
+
+Returns:
+    uint32_t: the longest tickless sleep in mSec.
+
+Assumptions/Limitations:
+    None
+------------------------------------------------------------------------------*/
+uint32_t SysTick_Get_Max_Idle_mSec(void);
+
 #endif
@@ -1,8 +1,8 @@
 /*
 --|----------------------------------------------------------------------------|
 --| FILE DESCRIPTION:
---|   PSP_System_Clock_Init.h provides an interface for initializing the RCC
---|   and SysTick peripherals.
+--|   PSP_System_Clock_Init.h provides an interface for initializing the RCC,
+--|   DWT cycle counter and SysTick peripherals.
 --|  
 --|----------------------------------------------------------------------------|
 --| REFERENCES:
@@ -20,7 +20,7 @@
 --|----------------------------------------------------------------------------|
 */
 
-/* None */
+#include "PSP_Clock_Tree.h"
 
 /*
 --|----------------------------------------------------------------------------|
@@ -30,10 +30,10 @@
 
 /*
 --| NAME: SYSTEM_CLOCK_SPEED
---| DESCRIPTION: system clock speed is set to 32MHz
+--| DESCRIPTION: the core (HCLK) clock speed, as configured in PSP_Clock_Tree.h
 --| TYPE: unsigned integer
 */
-#define SYSTEM_CLOCK_SPEED (32000000u) // TODO: not so sure this is right...
+#define SYSTEM_CLOCK_SPEED (CLOCK_TREE_HCLK_HZ)
 
 /*
 --|----------------------------------------------------------------------------|
@@ -70,9 +70,12 @@ Function Name:
     System_Clock_Init
 
 Function Description:
-    Initialize the RCC and SysTick registers. 
+    Initialize the RCC, DWT cycle counter and SysTick registers. 
+
+    Configures the clock source, PLL, bus prescalers and flash wait states
+    as selected in PSP_Clock_Tree.h, giving a core clock of SYSTEM_CLOCK_SPEED.
 
-    Sets the system timer to the SYSTEM_CLOCK_SPEED.
+    Enables the DWT cycle counter for high resolution timing.
 
     Sets up the SysTick timer to count ticks in milliseconds.
 
@@ -21,6 +21,7 @@
 
 #include "Common_Masks.h"
 #include "Common_Typedefs.h"
+#include "PSP_DMA.h"
 #include "PSP_Peripherals_Memory_Map.h"
 
 /*
@@ -138,8 +139,17 @@ typedef enum TIMx_CR1_CMS_MASKS_Enumeration
 */
 typedef enum TIMx_CR2_FLAGS_Enumeration
 {
-    TIMx_CR2_TI1S_FLAGS = (1u << 7u), // TI1 selection [rw]
-    TIMx_CR2_CCDS_FLAGS = (1u << 3u), // Capture/compare DMA selection [rw]
+    TIMx_CR2_OIS4_FLAGS  = (1u << 14u), // Output idle state 4 (OC4 output) [rw, TIM1 only]
+    TIMx_CR2_OIS3N_FLAGS = (1u << 13u), // Output idle state 3 (OC3N output) [rw, TIM1 only]
+    TIMx_CR2_OIS3_FLAGS  = (1u << 12u), // Output idle state 3 (OC3 output) [rw, TIM1 only]
+    TIMx_CR2_OIS2N_FLAGS = (1u << 11u), // Output idle state 2 (OC2N output) [rw, TIM1 only]
+    TIMx_CR2_OIS2_FLAGS  = (1u << 10u), // Output idle state 2 (OC2 output) [rw, TIM1 only]
+    TIMx_CR2_OIS1N_FLAGS = (1u << 9u),  // Output idle state 1 (OC1N output) [rw, TIM1 only]
+    TIMx_CR2_OIS1_FLAGS  = (1u << 8u),  // Output idle state 1 (OC1 output) [rw, TIM1 only]
+    TIMx_CR2_TI1S_FLAGS  = (1u << 7u),  // TI1 selection [rw]
+    TIMx_CR2_CCDS_FLAGS  = (1u << 3u),  // Capture/compare DMA selection [rw]
+    TIMx_CR2_CCUS_FLAGS  = (1u << 2u),  // Capture/compare control update on COMG or TRGI [rw, TIM1 only]
+    TIMx_CR2_CCPC_FLAGS  = (1u << 0u),  // Capture/compare control bits preloaded until a COM event [rw, TIM1 only]
 } TIMx_CR2_FLAGS_enum;
 
 /*
@@ -249,12 +259,15 @@ typedef enum TIMx_SMCR_SMS_MASKS_Enumeration
 typedef enum TIMx_DIER_FLAGS_Enumeration
 {
     TIMx_DIER_TDE_FLAG   = (1u << 14u), // Trigger DMA request enable [rw]
+    TIMx_DIER_COMDE_FLAG = (1u << 13u), // COM DMA request enable [rw, TIM1 only]
     TIMx_DIER_CC4DE_FLAG = (1u << 12u), // Capture/Compare 4 DMA request enable [rw]
     TIMx_DIER_CC3DE_FLAG = (1u << 11u), // Capture/Compare 3 DMA request enable [rw]
     TIMx_DIER_CC2DE_FLAG = (1u << 10u), // Capture/Compare 2 DMA request enable [rw]
     TIMx_DIER_CC1DE_FLAG = (1u << 9u),  // Capture/Compare 1 DMA request enable [rw]
     TIMx_DIER_UDE_FLAG   = (1u << 8u),  // Update DMA request enable [rw]
+    TIMx_DIER_BIE_FLAG   = (1u << 7u),  // Break interrupt enable [rw, TIM1 only]
     TIMx_DIER_TIE_FLAG   = (1u << 6u),  // Trigger interrupt enable [rw]
+    TIMx_DIER_COMIE_FLAG = (1u << 5u),  // COM interrupt enable [rw, TIM1 only]
     TIMx_DIER_CC4IE_FLAG = (1u << 4u),  // Capture/Compare 4 interrupt enable [rw]
     TIMx_DIER_CC3IE_FLAG = (1u << 3u),  // Capture/Compare 3 interrupt enable [rw]
     TIMx_DIER_CC2IE_FLAG = (1u << 2u),  // Capture/Compare 2 interrupt enable [rw]
@@ -272,7 +285,9 @@ typedef enum TIMx_SR_FLAGS_Enumeration
     TIMx_SR_CC3OF_FLAG = (1u << 11u), // Capture/Compare 3 overcapture flag [rc_w0]
     TIMx_SR_CC2OF_FLAG = (1u << 10u), // Capture/Compare 2 overcapture flag [rc_w0]
     TIMx_SR_CC1OF_FLAG = (1u << 9u),  // Capture/Compare 1 overcapture flag [rc_w0]
+    TIMx_SR_BIF_FLAG   = (1u << 7u),  // Break interrupt flag [rc_w0, TIM1 only]
     TIMx_SR_TIF_FLAG   = (1u << 6u),  // Trigger interrupt flag [rc_w0]
+    TIMx_SR_COMIF_FLAG = (1u << 5u),  // COM interrupt flag [rc_w0, TIM1 only]
     TIMx_SR_CC4IF_FLAG = (1u << 4u),  // Capture/Compare 4 interrupt flag [rc_w0]
     TIMx_SR_CC3IF_FLAG = (1u << 3u),  // Capture/Compare 3 interrupt flag [rc_w0]
     TIMx_SR_CC2IF_FLAG = (1u << 2u),  // Capture/Compare 2 interrupt flag [rc_w0]
@@ -286,7 +301,9 @@ typedef enum TIMx_SR_FLAGS_Enumeration
 */
 typedef enum TIMx_EGR_FLAGS_Enumeration
 {
+    TIMx_EGR_BG_FLAG   = (1u << 7u), // Break generation [w, TIM1 only]
     TIMx_EGR_TG_FLAG   = (1u << 6u), // Trigger generation [w]
+    TIMx_EGR_COMG_FLAG = (1u << 5u), // Capture/compare control update generation [w, TIM1 only]
     TIMx_EGR_CC4G_FLAG = (1u << 4u), // Capture/compare 4 generation [w]
     TIMx_EGR_CC3G_FLAG = (1u << 3u), // Capture/compare 3 generation [w]
     TIMx_EGR_CC2G_FLAG = (1u << 2u), // Capture/compare 2 generation [w]
@@ -600,14 +617,20 @@ typedef enum TIMx_CCMR2_IC3PSC_MASKS_Enumeration
 */
 typedef enum TIMx_CCER_FLAGS_Enumeration
 {
-    TIMx_CCER_CC4P_FLAG = (1u << 13u), // Capture/Compare 4 output polarity [rw]
-    TIMx_CCER_CC4E_FLAG = (1u << 12u), // Capture/Compare 4 output enable [rw]
-    TIMx_CCER_CC3P_FLAG = (1u << 9u),  // Capture/Compare 3 output polarity [rw]
-    TIMx_CCER_CC3E_FLAG = (1u << 8u),  // Capture/Compare 3 output enable [rw]
-    TIMx_CCER_CC2P_FLAG = (1u << 5u),  // Capture/Compare 2 output polarity [rw]
-    TIMx_CCER_CC2E_FLAG = (1u << 4u),  // Capture/Compare 2 output enable [rw]
-    TIMx_CCER_CC1P_FLAG = (1u << 1u),  // Capture/Compare 1 output polarity [rw]
-    TIMx_CCER_CC1E_FLAG = (1u << 0u),  // Capture/Compare 1 output enable [rw]
+    TIMx_CCER_CC4P_FLAG  = (1u << 13u), // Capture/Compare 4 output polarity [rw]
+    TIMx_CCER_CC4E_FLAG  = (1u << 12u), // Capture/Compare 4 output enable [rw]
+    TIMx_CCER_CC3NP_FLAG = (1u << 11u), // Capture/Compare 3 complementary output polarity [rw, TIM1 only]
+    TIMx_CCER_CC3NE_FLAG = (1u << 10u), // Capture/Compare 3 complementary output enable [rw, TIM1 only]
+    TIMx_CCER_CC3P_FLAG  = (1u << 9u),  // Capture/Compare 3 output polarity [rw]
+    TIMx_CCER_CC3E_FLAG  = (1u << 8u),  // Capture/Compare 3 output enable [rw]
+    TIMx_CCER_CC2NP_FLAG = (1u << 7u),  // Capture/Compare 2 complementary output polarity [rw, TIM1 only]
+    TIMx_CCER_CC2NE_FLAG = (1u << 6u),  // Capture/Compare 2 complementary output enable [rw, TIM1 only]
+    TIMx_CCER_CC2P_FLAG  = (1u << 5u),  // Capture/Compare 2 output polarity [rw]
+    TIMx_CCER_CC2E_FLAG  = (1u << 4u),  // Capture/Compare 2 output enable [rw]
+    TIMx_CCER_CC1NP_FLAG = (1u << 3u),  // Capture/Compare 1 complementary output polarity [rw, TIM1 only]
+    TIMx_CCER_CC1NE_FLAG = (1u << 2u),  // Capture/Compare 1 complementary output enable [rw, TIM1 only]
+    TIMx_CCER_CC1P_FLAG  = (1u << 1u),  // Capture/Compare 1 output polarity [rw]
+    TIMx_CCER_CC1E_FLAG  = (1u << 0u),  // Capture/Compare 1 output enable [rw]
 } TIMx_CCER_FLAGS_enum;
 
 /*
@@ -630,6 +653,208 @@ typedef enum TIMx_DCR_DBA_MASKS_MASKS_Enumeration
     TIMx_DCR_DBA_SHIFT_AMT = 0u             // position of DBA in TIMx DCR
 } TIMx_DCR_DBA_MASKS_enum;
 
+/*
+--| NAME: TIMx_BDTR_FLAGS_enum
+--| DESCRIPTION: TIMx break and dead-time register flags [advanced-control timer only]
+*/
+typedef enum TIMx_BDTR_FLAGS_Enumeration
+{
+    TIMx_BDTR_MOE_FLAG  = (1u << 15u), // Main output enable [rw]
+    TIMx_BDTR_AOE_FLAG  = (1u << 14u), // Automatic output enable [rw]
+    TIMx_BDTR_BKP_FLAG  = (1u << 13u), // Break polarity [rw]
+    TIMx_BDTR_BKE_FLAG  = (1u << 12u), // Break enable [rw]
+    TIMx_BDTR_OSSR_FLAG = (1u << 11u), // Off-state selection for Run mode [rw]
+    TIMx_BDTR_OSSI_FLAG = (1u << 10u), // Off-state selection for Idle mode [rw]
+} TIMx_BDTR_FLAGS_enum;
+
+/*
+--| NAME: TIMx_BDTR_LOCK_MASKS_enum
+--| DESCRIPTION: TIMx BDTR lock configuration masks [2 bits, rw, write once]
+*/
+typedef enum TIMx_BDTR_LOCK_MASKS_Enumeration
+{
+    TIMx_BDTR_LOCK_OFF       = 0b00u, // no bits are write protected
+    TIMx_BDTR_LOCK_LEVEL_1   = 0b01u, // DTG, BKE, BKP, AOE and OISx are write protected
+    TIMx_BDTR_LOCK_LEVEL_2   = 0b10u, // level 1, plus CCxP, CCxNP, OSSR and OSSI
+    TIMx_BDTR_LOCK_LEVEL_3   = 0b11u, // level 2, plus OCxM and OCxPE
+    TIMx_BDTR_LOCK_SHIFT_AMT = 8u,    // position of LOCK in TIMx BDTR
+} TIMx_BDTR_LOCK_MASKS_enum;
+
+/*
+--| NAME: TIMx_BDTR_DTG_MASKS_enum
+--| DESCRIPTION: TIMx BDTR dead-time generator setup masks [8 bits, rw]
+*/
+typedef enum TIMx_BDTR_DTG_MASKS_Enumeration
+{
+    TIMx_BDTR_DTG_MASK      = EIGHT_BIT_MASK, // encoded dead time, in t_DTS steps
+    TIMx_BDTR_DTG_SHIFT_AMT = 0u,             // position of DTG in TIMx BDTR
+} TIMx_BDTR_DTG_MASKS_enum;
+
+/*
+--| NAME: TIMx_Channel_enum
+--| DESCRIPTION: enumeration for the capture/compare channels of a timer
+*/
+typedef enum TIMx_Channel_Enumeration
+{
+    TIMx_CHANNEL_1 = 0u,
+    TIMx_CHANNEL_2 = 1u,
+    TIMx_CHANNEL_3 = 2u,
+    TIMx_CHANNEL_4 = 3u,
+    TIMx_NUM_CHANNELS
+} TIMx_Channel_enum;
+
+/*
+--| NAME: TIMx_Output_Polarity_enum
+--| DESCRIPTION: enumeration for the level of an output while it is active
+*/
+typedef enum TIMx_Output_Polarity_Enumeration
+{
+    TIMx_OUTPUT_ACTIVE_HIGH,
+    TIMx_OUTPUT_ACTIVE_LOW
+} TIMx_Output_Polarity_enum;
+
+/*
+--| NAME: TIMx_PWM_Initialization_Data_t
+--| DESCRIPTION: structure for PWM time base initialization data
+*/
+typedef struct TIMx_PWM_Initialization_Data_Type
+{
+    uint32_t                frequency_Hz; // the PWM frequency [1 to timer clock / 2], 0 runs at 1 Hz
+    TIMx_CR1_CMS_MASKS_enum alignment;    // edge or center aligned counting
+} TIMx_PWM_Initialization_Data_t;
+
+/*
+--| NAME: TIMx_Capture_Edge_enum
+--| DESCRIPTION: enumeration for the input edge which triggers a capture
+*/
+typedef enum TIMx_Capture_Edge_Enumeration
+{
+    TIMx_CAPTURE_RISING_EDGE,
+    TIMx_CAPTURE_FALLING_EDGE
+} TIMx_Capture_Edge_enum;
+
+/*
+--| NAME: TIMx_Input_Capture_Initialization_Data_t
+--| DESCRIPTION: structure for input capture initialization data
+*/
+typedef struct TIMx_Input_Capture_Initialization_Data_Type
+{
+    uint32_t                     tick_Hz;   // the counter frequency, which sets the capture resolution
+    TIMx_CCMR1_IC1F_MASKS_enum   filter;    // digital filter on the input
+    TIMx_CCMR1_IC1PSC_MASKS_enum prescaler; // capture every 1, 2, 4 or 8 edges
+    TIMx_Capture_Edge_enum       edge;      // the edge to capture (the period start for PWM input)
+} TIMx_Input_Capture_Initialization_Data_t;
+
+/*
+--| NAME: TIMx_Capture_Handle_t
+--| DESCRIPTION: handle to an input capture channel. The members are updated
+--|   by the capture interrupt handler and read through the getters.
+*/
+typedef struct TIMx_Capture_Handle_Type
+{
+    volatile TIMx_t * p_TIMx;            // the timer
+    TIMx_Channel_enum channel;           // the capture channel, channel 1 for PWM input
+    uint32_t          tick_Hz;           // the actual counter frequency
+    volatile uint32_t overflow_count;    // counter overflows, the upper 16 bits of the extended count
+    volatile uint32_t last_capture;      // the 32 bit extended count at the last capture
+    volatile uint32_t period_ticks;      // ticks between the last two captures
+    volatile uint32_t pulse_ticks;       // ticks of the active part of the period [PWM input only]
+    volatile uint32_t capture_count;     // the number of captures so far
+} TIMx_Capture_Handle_t;
+
+/*
+--| NAME: TIMx_Encoder_Initialization_Data_t
+--| DESCRIPTION: structure for encoder interface initialization data
+*/
+typedef struct TIMx_Encoder_Initialization_Data_Type
+{
+    TIMx_SMCR_SMS_MASKS_enum   mode;                 // encoder mode 1 (TI2 edges), 2 (TI1 edges) or 3 (both, x4)
+    TIMx_CCMR1_IC1F_MASKS_enum filter;               // digital filter on both inputs
+    bool                       invert_direction;     // true to count the other way
+    uint32_t                   sample_period_mSec;   // the interval at which TIMx_Encoder_Sample is called
+} TIMx_Encoder_Initialization_Data_t;
+
+/*
+--| NAME: TIMx_Encoder_Handle_t
+--| DESCRIPTION: handle to an encoder interface. The wrap count is updated by
+--|   the update interrupt handler, the velocity by TIMx_Encoder_Sample.
+*/
+typedef struct TIMx_Encoder_Handle_Type
+{
+    volatile TIMx_t * p_TIMx;                  // the timer
+    uint32_t          sample_period_mSec;      // the velocity sampling interval
+    volatile int32_t  wrap_count;              // counter wraps, the upper 16 bits of the position
+    int32_t           last_position;           // the position at the last sample
+    volatile int32_t  velocity_counts_per_sec; // the velocity over the last sample period
+} TIMx_Encoder_Handle_t;
+
+/*
+--| NAME: TIMx_Cascade_Handle_t
+--| DESCRIPTION: handle to two timers chained into one 32 bit counter
+*/
+typedef struct TIMx_Cascade_Handle_Type
+{
+    volatile TIMx_t * p_TIMx_low;  // the timer counting the lower 16 bits, the master
+    volatile TIMx_t * p_TIMx_high; // the timer counting the upper 16 bits, the slave
+    uint32_t          tick_Hz;     // the actual count frequency
+} TIMx_Cascade_Handle_t;
+
+/*
+--| NAME: TIMx_Burst_Initialization_Data_t
+--| DESCRIPTION: structure for DMA burst playback initialization data. Each
+--|   entry of the table holds the registers written at one update event, in
+--|   register order: ARR and RCR if include_period is set, then CCR1 up to
+--|   CCR[num_channels].
+*/
+typedef struct TIMx_Burst_Initialization_Data_Type
+{
+    const uint16_t * p_table;        // the register values, entry after entry
+    uint32_t         num_entries;    // the number of entries in the table
+    bool             include_period; // true to reload ARR (and RCR) as well as the CCRs
+    uint32_t         num_channels;   // the number of CCRs per entry, from CCR1 [0 to 4]
+    bool             circular;       // true to repeat the table forever
+} TIMx_Burst_Initialization_Data_t;
+
+/*
+--| NAME: TIMx_One_Pulse_Trigger_enum
+--| DESCRIPTION: enumeration for what starts a one-pulse output
+*/
+typedef enum TIMx_One_Pulse_Trigger_Enumeration
+{
+    TIMx_ONE_PULSE_SOFTWARE_TRIGGER, // TIMx_One_Pulse_Trigger only
+    TIMx_ONE_PULSE_TI1_TRIGGER,      // an edge on the channel 1 input (TI1FP1)
+    TIMx_ONE_PULSE_TI2_TRIGGER       // an edge on the channel 2 input (TI2FP2)
+} TIMx_One_Pulse_Trigger_enum;
+
+/*
+--| NAME: TIMx_One_Pulse_Initialization_Data_t
+--| DESCRIPTION: structure for one-pulse initialization data
+*/
+typedef struct TIMx_One_Pulse_Initialization_Data_Type
+{
+    uint32_t                    delay_nSec;     // time from the trigger to the start of the pulse
+    uint32_t                    width_nSec;     // the pulse width
+    TIMx_Channel_enum           channel;        // the output channel
+    TIMx_Output_Polarity_enum   polarity;       // the level of the pulse
+    TIMx_One_Pulse_Trigger_enum trigger;        // what starts the pulse
+    TIMx_Capture_Edge_enum      trigger_edge;   // the trigger input edge [TI1/TI2 trigger only]
+    TIMx_CCMR1_IC1F_MASKS_enum  trigger_filter; // digital filter on the trigger input [TI1/TI2 trigger only]
+} TIMx_One_Pulse_Initialization_Data_t;
+
+/*
+--| NAME: TIMx_Three_Phase_Initialization_Data_t
+--| DESCRIPTION: structure for three-phase complementary PWM initialization
+--|   data, phases A, B and C on channels 1, 2 and 3 [TIM1 only]
+*/
+typedef struct TIMx_Three_Phase_Initialization_Data_Type
+{
+    uint32_t                  frequency_Hz;        // the PWM frequency [1 to timer clock / 2], 0 runs at 1 Hz
+    TIMx_CR1_CMS_MASKS_enum   alignment;           // center aligned for sinusoidal drive, either for six-step
+    uint32_t                  dead_time_nSec;      // the minimum time between one side turning off and the other on
+    TIMx_Output_Polarity_enum high_side_polarity;  // the level which turns on a high side switch (CHx)
+    TIMx_Output_Polarity_enum low_side_polarity;   // the level which turns on a low side switch (CHxN)
+} TIMx_Three_Phase_Initialization_Data_t;
+
 /*
 --|----------------------------------------------------------------------------|
 --| PUBLIC CONSTANTS
@@ -652,6 +877,958 @@ typedef enum TIMx_DCR_DBA_MASKS_MASKS_Enumeration
 --|----------------------------------------------------------------------------|
 */
 
-/* None */
+/*------------------------------------------------------------------------------
+Function Name:
+    TIMx_PWM_Init
+
+Function Description:
+    Set up the time base of a timer for PWM generation at a given frequency.
+    The prescaler is chosen as small as possible, to give the finest duty
+    resolution. The auto-reload register is preloaded, so later changes only
+    take effect at an update event.
+
+    For center-aligned modes the counter counts up and down once per PWM
+    period, so the resolution is halved.
+
+Parameters:
+    p_TIMx: pointer to the timer.
+    p_init_data: pointer to the PWM initialization data.
+
+Returns:
+    None
+
+Assumptions/Limitations:
+    Assumes that the timer's RCC clock is enabled. The counter is left
+    stopped, call TIMx_Start after setting up the channels.
+
+    A frequency of 0 is taken as 1 Hz rather than divided by. Above half the
+    timer clock the period is held at its 2 count minimum.
+------------------------------------------------------------------------------*/
+void TIMx_PWM_Init(volatile TIMx_t * p_TIMx, TIMx_PWM_Initialization_Data_t * p_init_data);
+
+/*------------------------------------------------------------------------------
+Function Name:
+    TIMx_PWM_Channel_Init
+
+Function Description:
+    Set up a channel for PWM output (PWM mode 1) with a preloaded compare
+    register, so that duty changes only take effect at the next update
+    event and never produce a glitched period.
+
+Parameters:
+    p_TIMx: pointer to the timer.
+    channel: the channel to set up.
+    polarity: the output level during the duty portion of the period.
+    duty_counts: the initial duty [0 to TIMx_PWM_Get_Period_Counts()].
+
+Returns:
+    None
+
+Assumptions/Limitations:
+    Assumes that TIMx_PWM_Init has been called, and that the GPIO pin for
+    the channel is set to alternate function output.
+------------------------------------------------------------------------------*/
+void TIMx_PWM_Channel_Init(volatile TIMx_t * p_TIMx, 
+                           TIMx_Channel_enum channel,
+                           TIMx_Output_Polarity_enum polarity,
+                           uint32_t duty_counts);
+
+/*------------------------------------------------------------------------------
+Function Name:
+    TIMx_PWM_Get_Period_Counts
+
+Function Description:
+    Get the number of counts in one PWM period, which is the compare value
+    for 100% duty.
+
+Parameters:
+    p_TIMx: pointer to the timer.
+
+Returns:
+    uint32_t: the counts per PWM period.
+
+Assumptions/Limitations:
+    Assumes that TIMx_PWM_Init has been called.
+------------------------------------------------------------------------------*/
+uint32_t TIMx_PWM_Get_Period_Counts(volatile TIMx_t * p_TIMx);
+
+/*------------------------------------------------------------------------------
+Function Name:
+    TIMx_PWM_Set_Duty
+
+Function Description:
+    Set the duty of a PWM channel in counts. This is a single write to the
+    channel's compare register, so it is safe from any context.
+
+Parameters:
+    p_TIMx: pointer to the timer.
+    channel: the channel to update.
+    duty_counts: the duty [0 to TIMx_PWM_Get_Period_Counts()].
+
+Returns:
+    None
+
+Assumptions/Limitations:
+    The new duty takes effect at the next update event.
+------------------------------------------------------------------------------*/
+void TIMx_PWM_Set_Duty(volatile TIMx_t * p_TIMx, TIMx_Channel_enum channel, uint32_t duty_counts);
+
+/*------------------------------------------------------------------------------
+Function Name:
+    TIMx_PWM_Set_Duty_Permille
+
+Function Description:
+    Set the duty of a PWM channel in tenths of a percent.
+
+Parameters:
+    p_TIMx: pointer to the timer.
+    channel: the channel to update.
+    duty_permille: the duty [0 to 1000].
+
+Returns:
+    None
+
+Assumptions/Limitations:
+    Same as TIMx_PWM_Set_Duty.
+------------------------------------------------------------------------------*/
+void TIMx_PWM_Set_Duty_Permille(volatile TIMx_t * p_TIMx, TIMx_Channel_enum channel, uint32_t duty_permille);
+
+/*------------------------------------------------------------------------------
+Function Name:
+    TIMx_Start
+
+Function Description:
+    Start the counter of a timer.
+
+Parameters:
+    p_TIMx: pointer to the timer.
+
+Returns:
+    None
+
+Assumptions/Limitations:
+    None
+------------------------------------------------------------------------------*/
+void TIMx_Start(volatile TIMx_t * p_TIMx);
+
+/*------------------------------------------------------------------------------
+Function Name:
+    TIMx_Stop
+
+Function Description:
+    Stop the counter of a timer. Outputs hold their current level.
+
+Parameters:
+    p_TIMx: pointer to the timer.
+
+Returns:
+    None
+
+Assumptions/Limitations:
+    None
+------------------------------------------------------------------------------*/
+void TIMx_Stop(volatile TIMx_t * p_TIMx);
+
+/*------------------------------------------------------------------------------
+Function Name:
+    TIMx_Input_Capture_Init
+
+Function Description:
+    Set up a timer channel to timestamp edges on its input. The counter is
+    extended to 32 bits by counting overflows, so long periods can be
+    measured at a fine resolution.
+
+Parameters:
+    p_handle: pointer to the capture handle, with p_TIMx and channel set.
+    p_init_data: pointer to the input capture initialization data.
+
+Returns:
+    None
+
+Assumptions/Limitations:
+    Assumes that the timer's RCC clock is enabled and the input pin is set
+    up as an input. The time base is shared, so only one capture handle
+    per timer is supported.
+
+    Enables the capture and update interrupts: enable the timer's IRQ in
+    the NVIC and call TIMx_Input_Capture_IRQ_Handler from its handler. The
+    handler must run within half a counter period (32768 ticks) of each
+    event to place captures correctly around an overflow. The counter is
+    left stopped, call TIMx_Start to begin.
+------------------------------------------------------------------------------*/
+void TIMx_Input_Capture_Init(TIMx_Capture_Handle_t * p_handle, 
+                             TIMx_Input_Capture_Initialization_Data_t * p_init_data);
+
+/*------------------------------------------------------------------------------
+Function Name:
+    TIMx_Input_Capture_IRQ_Handler
+
+Function Description:
+    Process capture and overflow events for an input capture channel.
+
+Parameters:
+    p_handle: pointer to the capture handle.
+
+Returns:
+    None
+
+Assumptions/Limitations:
+    Call from the timer's interrupt handler.
+------------------------------------------------------------------------------*/
+void TIMx_Input_Capture_IRQ_Handler(TIMx_Capture_Handle_t * p_handle);
+
+/*------------------------------------------------------------------------------
+Function Name:
+    TIMx_PWM_Input_Init
+
+Function Description:
+    Set up channels 1 and 2 of a timer in PWM input mode, to measure both
+    the period and the pulse width of a signal on TI1. Channel 1 captures
+    the period edge and resets the counter, channel 2 captures the opposite
+    edge on the same input.
+
+Parameters:
+    p_handle: pointer to the capture handle, with p_TIMx set.
+    p_init_data: pointer to the input capture initialization data.
+
+Returns:
+    None
+
+Assumptions/Limitations:
+    Same as TIMx_Input_Capture_Init, with TIMx_PWM_Input_IRQ_Handler as the
+    handler. Only channel 1 (TI1) can be used as the input.
+------------------------------------------------------------------------------*/
+void TIMx_PWM_Input_Init(TIMx_Capture_Handle_t * p_handle, 
+                         TIMx_Input_Capture_Initialization_Data_t * p_init_data);
+
+/*------------------------------------------------------------------------------
+Function Name:
+    TIMx_PWM_Input_IRQ_Handler
+
+Function Description:
+    Process capture and overflow events for PWM input mode.
+
+Parameters:
+    p_handle: pointer to the capture handle.
+
+Returns:
+    None
+
+Assumptions/Limitations:
+    Call from the timer's interrupt handler.
+------------------------------------------------------------------------------*/
+void TIMx_PWM_Input_IRQ_Handler(TIMx_Capture_Handle_t * p_handle);
+
+/*------------------------------------------------------------------------------
+Function Name:
+    TIMx_Capture_Get_Frequency_Hz
+
+Function Description:
+    Get the frequency of the measured signal from the last period.
+
+Parameters:
+    p_handle: pointer to the capture handle.
+
+Returns:
+    uint32_t: the frequency in Hz, or 0 if no period has been measured.
+
+Assumptions/Limitations:
+    With an input prescaler, the result is the frequency of the captured
+    edges, not of the signal.
+------------------------------------------------------------------------------*/
+uint32_t TIMx_Capture_Get_Frequency_Hz(TIMx_Capture_Handle_t * p_handle);
+
+/*------------------------------------------------------------------------------
+Function Name:
+    TIMx_Capture_Get_Duty_Permille
+
+Function Description:
+    Get the duty of the measured signal from the last period.
+
+Parameters:
+    p_handle: pointer to the capture handle.
+
+Returns:
+    uint32_t: the duty in tenths of a percent, or 0 if no period has been
+    measured.
+
+Assumptions/Limitations:
+    PWM input mode only.
+------------------------------------------------------------------------------*/
+uint32_t TIMx_Capture_Get_Duty_Permille(TIMx_Capture_Handle_t * p_handle);
+
+/*------------------------------------------------------------------------------
+Function Name:
+    TIMx_Input_Capture_Start_DMA
+
+Function Description:
+    Have DMA copy each raw 16 bit capture of a channel into a timestamp
+    buffer, so high rate signals can be measured without an interrupt per
+    edge. The period between two edges is the difference of consecutive
+    timestamps, in unsigned 16 bit arithmetic.
+
+    In circular mode the buffer is refilled forever, and
+    DMA_Channel_Get_Remaining gives the write position.
+
+Parameters:
+    p_handle: pointer to the capture handle, set up by
+        TIMx_Input_Capture_Init.
+    p_timestamps: the timestamp buffer.
+    num_timestamps: the length of the buffer [1 to 65535].
+    circular: true to refill the buffer forever, false to stop when full.
+
+Returns:
+    true if the DMA was started, false if the channel has no DMA request
+    (TIM3 channel 2 and TIM4 channel 4).
+
+Assumptions/Limitations:
+    Disables the capture interrupt for the channel, so the 32 bit extension
+    is not maintained: periods must be shorter than 65536 ticks.
+
+    Uses the DMA1 channel hard wired to the timer channel, which must not be
+    in use by another peripheral.
+------------------------------------------------------------------------------*/
+bool TIMx_Input_Capture_Start_DMA(TIMx_Capture_Handle_t * p_handle, 
+                                  uint16_t * p_timestamps,
+                                  uint32_t num_timestamps,
+                                  bool circular);
+
+/*------------------------------------------------------------------------------
+Function Name:
+    TIMx_Encoder_Init
+
+Function Description:
+    Set up a timer as a quadrature encoder interface. The counter is clocked
+    by the A (TI1) and B (TI2) inputs and counts up or down with the
+    direction of rotation, in hardware. Counter wraps are counted to extend
+    the position to 32 bits.
+
+Parameters:
+    p_handle: pointer to the encoder handle, with p_TIMx set.
+    p_init_data: pointer to the encoder initialization data.
+
+Returns:
+    None
+
+Assumptions/Limitations:
+    Assumes that the timer's RCC clock is enabled and the channel 1 and 2
+    pins are set up as inputs.
+
+    Enables the update interrupt: enable the timer's IRQ in the NVIC and
+    call TIMx_Encoder_IRQ_Handler from its handler. The handler must run
+    within 32768 counts of a wrap to tell its direction. The counter is
+    left stopped, call TIMx_Start to begin.
+------------------------------------------------------------------------------*/
+void TIMx_Encoder_Init(TIMx_Encoder_Handle_t * p_handle, 
+                       TIMx_Encoder_Initialization_Data_t * p_init_data);
+
+/*------------------------------------------------------------------------------
+Function Name:
+    TIMx_Encoder_IRQ_Handler
+
+Function Description:
+    Count a wrap of the encoder counter.
+
+Parameters:
+    p_handle: pointer to the encoder handle.
+
+Returns:
+    None
+
+Assumptions/Limitations:
+    None
+------------------------------------------------------------------------------*/
+void TIMx_Encoder_IRQ_Handler(TIMx_Encoder_Handle_t * p_handle);
+
+/*------------------------------------------------------------------------------
+Function Name:
+    TIMx_Encoder_Get_Position
+
+Function Description:
+    Get the 32 bit encoder position, combining the wrap count with the
+    hardware counter.
+
+Parameters:
+    p_handle: pointer to the encoder handle.
+
+Returns:
+    int32_t: the position in counts since the last reset.
+
+Assumptions/Limitations:
+    Safe to call from thread mode or from interrupts of any priority,
+    including with a wrap still pending.
+------------------------------------------------------------------------------*/
+int32_t TIMx_Encoder_Get_Position(TIMx_Encoder_Handle_t * p_handle);
+
+/*------------------------------------------------------------------------------
+Function Name:
+    TIMx_Encoder_Reset_Position
+
+Function Description:
+    Set the encoder position and the velocity to zero.
+
+Parameters:
+    p_handle: pointer to the encoder handle.
+
+Returns:
+    None
+
+Assumptions/Limitations:
+    Counts arriving during the reset may be lost.
+------------------------------------------------------------------------------*/
+void TIMx_Encoder_Reset_Position(TIMx_Encoder_Handle_t * p_handle);
+
+/*------------------------------------------------------------------------------
+Function Name:
+    TIMx_Encoder_Sample
+
+Function Description:
+    Estimate the velocity from the change in position since the last
+    sample. Call at the sample period given at initialization, for
+    example from a periodic timer.
+
+Parameters:
+    p_handle: pointer to the encoder handle.
+
+Returns:
+    int32_t: the velocity in counts per second, negative when counting down.
+
+Assumptions/Limitations:
+    The resolution is 1000 / sample_period_mSec counts per second; longer
+    periods give finer but slower estimates. The position must change by
+    less than 2^31 counts between samples.
+------------------------------------------------------------------------------*/
+int32_t TIMx_Encoder_Sample(TIMx_Encoder_Handle_t * p_handle);
+
+/*------------------------------------------------------------------------------
+Function Name:
+    TIMx_Encoder_Get_Velocity
+
+Function Description:
+    Get the velocity found by the last TIMx_Encoder_Sample.
+
+Parameters:
+    p_handle: pointer to the encoder handle.
+
+Returns:
+    int32_t: the velocity in counts per second.
+
+Assumptions/Limitations:
+    None
+------------------------------------------------------------------------------*/
+int32_t TIMx_Encoder_Get_Velocity(TIMx_Encoder_Handle_t * p_handle);
+
+/*------------------------------------------------------------------------------
+Function Name:
+    TIMx_Cascade_Init
+
+Function Description:
+    Chain two timers into a free running 32 bit counter. The low timer
+    counts at the requested frequency and its update event (TRGO) clocks the
+    high timer through the internal trigger connection, so the count is kept
+    in hardware without interrupts.
+
+Parameters:
+    p_handle: pointer to the cascade handle, with p_TIMx_low and
+        p_TIMx_high set to two different timers.
+    tick_Hz: the requested count frequency.
+
+Returns:
+    None
+
+Assumptions/Limitations:
+    Assumes that the RCC clocks of both timers are enabled. The counters are
+    cleared and left stopped, call TIMx_Cascade_Start to begin.
+------------------------------------------------------------------------------*/
+void TIMx_Cascade_Init(TIMx_Cascade_Handle_t * p_handle, uint32_t tick_Hz);
+
+/*------------------------------------------------------------------------------
+Function Name:
+    TIMx_Cascade_Start
+
+Function Description:
+    Start a 32 bit cascaded counter.
+
+Parameters:
+    p_handle: pointer to the cascade handle.
+
+Returns:
+    None
+
+Assumptions/Limitations:
+    None
+------------------------------------------------------------------------------*/
+void TIMx_Cascade_Start(TIMx_Cascade_Handle_t * p_handle);
+
+/*------------------------------------------------------------------------------
+Function Name:
+    TIMx_Cascade_Get_Count
+
+Function Description:
+    Read a 32 bit cascaded counter. The high half is read on both sides of
+    the low half and the read is repeated if it changed, so a carry between
+    the two reads cannot tear the result. The carry reaches the high timer
+    a few kernel clocks after the low half wraps (trigger resynchronization),
+    so when the low half is within a few counts of 0 the high half is read
+    again after that delay, rather than returning a count 2^16 ticks behind.
+
+Parameters:
+    p_handle: pointer to the cascade handle.
+
+Returns:
+    uint32_t: the count, which wraps after 2^32 ticks.
+
+Assumptions/Limitations:
+    Assumes that the carry delay is shorter than a few APB reads of the
+    high timer, as it is when both timers share a clock domain (TIM2 to
+    TIM4 on APB1).
+------------------------------------------------------------------------------*/
+uint32_t TIMx_Cascade_Get_Count(TIMx_Cascade_Handle_t * p_handle);
+
+/*------------------------------------------------------------------------------
+Function Name:
+    TIMx_Sync_Init
+
+Function Description:
+    Gate the counters of several timers from one master, so that they all
+    start and stop on the same clock edge. The master's counter enable is
+    its trigger output and each slave counts only while it is high, so
+    TIMx_Start and TIMx_Stop on the master start and stop every timer in
+    phase, with no software timing.
+
+Parameters:
+    p_master: pointer to the master timer.
+    pp_slaves: array of pointers to the slave timers.
+    num_slaves: the number of slave timers [1 to 3].
+
+Returns:
+    None
+
+Assumptions/Limitations:
+    Call after setting up each timer (for example with TIMx_PWM_Init), while
+    all are stopped. All counters are cleared. The slaves are enabled here
+    and must not be started or stopped individually afterwards.
+
+    The master is delayed to match the slaves' trigger synchronization, so
+    the counters stay exactly aligned when they run at the same rate.
+------------------------------------------------------------------------------*/
+void TIMx_Sync_Init(volatile TIMx_t * p_master, 
+                    volatile TIMx_t * const * pp_slaves, 
+                    uint32_t num_slaves);
+
+/*------------------------------------------------------------------------------
+Function Name:
+    TIMx_Burst_Start
+
+Function Description:
+    Play a table of register values into a timer with DMA bursts: at each
+    update event the next entry is written through DMAR to the period and
+    compare registers. Pulse trains, ramp profiles and bit encoded
+    waveforms are then generated with no CPU involvement.
+
+Parameters:
+    p_TIMx: pointer to the timer.
+    p_init_data: pointer to the burst initialization data.
+
+Returns:
+    true if the DMA was started, false if the table does not fit in one
+    DMA transfer (65535 registers) or has no registers per entry.
+
+Assumptions/Limitations:
+    Assumes that the timer is set up for PWM (for example with
+    TIMx_PWM_Init and TIMx_PWM_Channel_Init), so ARR and the CCRs are
+    preloaded: each entry is written at one update event and takes effect
+    at the next, one period later.
+
+    The RCR slot is only used by TIM1, it is ignored on TIM2 to TIM4.
+    Uses the DMA1 channel hard wired to the timer's update request, which
+    must not be in use by another peripheral.
+------------------------------------------------------------------------------*/
+bool TIMx_Burst_Start(volatile TIMx_t * p_TIMx, TIMx_Burst_Initialization_Data_t * p_init_data);
+
+/*------------------------------------------------------------------------------
+Function Name:
+    TIMx_Burst_Stop
+
+Function Description:
+    Stop DMA burst playback. The registers keep the last values written.
+
+Parameters:
+    p_TIMx: pointer to the timer.
+
+Returns:
+    None
+
+Assumptions/Limitations:
+    None
+------------------------------------------------------------------------------*/
+void TIMx_Burst_Stop(volatile TIMx_t * p_TIMx);
+
+/*------------------------------------------------------------------------------
+Function Name:
+    TIMx_Burst_Is_Done
+
+Function Description:
+    Check whether a non-circular burst playback has written the whole table.
+
+Parameters:
+    p_TIMx: pointer to the timer.
+
+Returns:
+    true if every entry has been written.
+
+Assumptions/Limitations:
+    The last entry takes effect one period after it is written.
+------------------------------------------------------------------------------*/
+bool TIMx_Burst_Is_Done(volatile TIMx_t * p_TIMx);
+
+/*------------------------------------------------------------------------------
+Function Name:
+    TIMx_One_Pulse_Init
+
+Function Description:
+    Set up a timer to output a single pulse of a given width, a given delay
+    after a trigger. The prescaler, period and compare values are computed
+    from the clock tree, with the finest resolution which fits the delay
+    plus width in the 16 bit counter. The counter stops by itself at the
+    end of the pulse (one-pulse mode).
+
+    With a TI1 or TI2 trigger the counter is started by the input edge in
+    hardware (trigger mode), so the delay has no software latency or jitter.
+
+Parameters:
+    p_TIMx: pointer to the timer.
+    p_init_data: pointer to the one-pulse initialization data.
+
+Returns:
+    true if the timing can be generated, false if the delay plus width is
+    too long for the timer clock.
+
+Assumptions/Limitations:
+    Assumes that the timer's RCC clock is enabled, the output pin is set up
+    as an alternate function output and any trigger pin as an input. The
+    trigger input channel cannot also be the output channel.
+
+    The delay is at least one timer tick, and with an input trigger is
+    lengthened by a few clock cycles of input synchronization. The
+    resolution is one tick, 1 / the timer clock for times up to 65536 ticks.
+------------------------------------------------------------------------------*/
+bool TIMx_One_Pulse_Init(volatile TIMx_t * p_TIMx, TIMx_One_Pulse_Initialization_Data_t * p_init_data);
+
+/*------------------------------------------------------------------------------
+Function Name:
+    TIMx_One_Pulse_Trigger
+
+Function Description:
+    Start a one-pulse output from software.
+
+Parameters:
+    p_TIMx: pointer to the timer.
+
+Returns:
+    None
+
+Assumptions/Limitations:
+    Has no effect while a pulse is in progress.
+------------------------------------------------------------------------------*/
+void TIMx_One_Pulse_Trigger(volatile TIMx_t * p_TIMx);
+
+/*------------------------------------------------------------------------------
+Function Name:
+    TIMx_One_Pulse_Is_Busy
+
+Function Description:
+    Check whether a one-pulse output is in its delay or pulse.
+
+Parameters:
+    p_TIMx: pointer to the timer.
+
+Returns:
+    true while the counter is running.
+
+Assumptions/Limitations:
+    None
+------------------------------------------------------------------------------*/
+bool TIMx_One_Pulse_Is_Busy(volatile TIMx_t * p_TIMx);
+
+/*------------------------------------------------------------------------------
+Function Name:
+    TIMx_Set_Dead_Time
+
+Function Description:
+    Set the dead time inserted between a complementary pair switching, so
+    the high and low side switches of a half bridge are never on together.
+    The time is rounded up to the next step the dead-time generator can
+    produce.
+
+Parameters:
+    p_TIMx: pointer to the timer.
+    dead_time_nSec: the minimum dead time.
+
+Returns:
+    true if the dead time was set, false if it is too long.
+
+Assumptions/Limitations:
+    TIM1 only. The dead time range is 1008 timer clocks; longer times use
+    the clock division, which also slows the input filters. Must not be
+    called with the BDTR lock at level 1 or above.
+------------------------------------------------------------------------------*/
+bool TIMx_Set_Dead_Time(volatile TIMx_t * p_TIMx, uint32_t dead_time_nSec);
+
+/*------------------------------------------------------------------------------
+Function Name:
+    TIMx_PWM_Complementary_Channel_Init
+
+Function Description:
+    Set up a PWM channel with its complementary output (CHxN), which is the
+    inverse of the main output with dead time inserted at each edge.
+
+Parameters:
+    p_TIMx: pointer to the timer.
+    channel: the channel [1 to 3].
+    polarity: the active level of the main output.
+    complementary_polarity: the active level of the complementary output.
+    duty_counts: the initial compare value.
+
+Returns:
+    None
+
+Assumptions/Limitations:
+    TIM1 only. Assumes that TIMx_PWM_Init has set up the time base. The
+    main output enable is not changed, turn the outputs on with
+    TIMx_Set_Main_Output_Enable. Disabled outputs are driven to their
+    inactive levels, rather than released.
+------------------------------------------------------------------------------*/
+void TIMx_PWM_Complementary_Channel_Init(volatile TIMx_t * p_TIMx,
+                                         TIMx_Channel_enum channel,
+                                         TIMx_Output_Polarity_enum polarity,
+                                         TIMx_Output_Polarity_enum complementary_polarity,
+                                         uint32_t duty_counts);
+
+/*------------------------------------------------------------------------------
+Function Name:
+    TIMx_Break_Init
+
+Function Description:
+    Enable the break input (BKIN). When it goes active the main output
+    enable is cleared in hardware, asynchronously to the clock, so all
+    outputs go to their safe idle levels with no software latency.
+
+Parameters:
+    p_TIMx: pointer to the timer.
+    break_polarity: the active level of the break input.
+    auto_restart: true to set the main output enable again automatically
+        at the next update event once the break input is inactive, false
+        to stay off until TIMx_Break_Clear.
+
+Returns:
+    None
+
+Assumptions/Limitations:
+    TIM1 only. Assumes that the break pin is set up as an input. Enables
+    the break interrupt: enable TIM1_BRK_IRQn in the NVIC to be notified.
+------------------------------------------------------------------------------*/
+void TIMx_Break_Init(volatile TIMx_t * p_TIMx, 
+                     TIMx_Output_Polarity_enum break_polarity, 
+                     bool auto_restart);
+
+/*------------------------------------------------------------------------------
+Function Name:
+    TIMx_Break_Is_Active
+
+Function Description:
+    Check whether a break has happened since the last TIMx_Break_Clear.
+
+Parameters:
+    p_TIMx: pointer to the timer.
+
+Returns:
+    true if the break flag is set.
+
+Assumptions/Limitations:
+    None
+------------------------------------------------------------------------------*/
+bool TIMx_Break_Is_Active(volatile TIMx_t * p_TIMx);
+
+/*------------------------------------------------------------------------------
+Function Name:
+    TIMx_Break_Clear
+
+Function Description:
+    Clear the break flag and turn the outputs back on.
+
+Parameters:
+    p_TIMx: pointer to the timer.
+
+Returns:
+    true if the outputs are on, false if the break input is still active.
+
+Assumptions/Limitations:
+    None
+------------------------------------------------------------------------------*/
+bool TIMx_Break_Clear(volatile TIMx_t * p_TIMx);
+
+/*------------------------------------------------------------------------------
+Function Name:
+    TIMx_Set_Main_Output_Enable
+
+Function Description:
+    Turn all outputs of an advanced-control timer on, or off to their idle
+    levels.
+
+Parameters:
+    p_TIMx: pointer to the timer.
+    enable: true to turn the outputs on.
+
+Returns:
+    None
+
+Assumptions/Limitations:
+    TIM1 only. The outputs cannot be turned on while the break input is
+    active.
+------------------------------------------------------------------------------*/
+void TIMx_Set_Main_Output_Enable(volatile TIMx_t * p_TIMx, bool enable);
+
+/*------------------------------------------------------------------------------
+Function Name:
+    TIMx_Set_Repetition_Count
+
+Function Description:
+    Set how many counter overflows/underflows make one update event, so
+    the update interrupt and preload transfers happen less often than the
+    PWM period.
+
+Parameters:
+    p_TIMx: pointer to the timer.
+    num_periods: the number of overflows/underflows per update [1 to 256].
+
+Returns:
+    None
+
+Assumptions/Limitations:
+    TIM1 only. In center-aligned modes there is one overflow and one
+    underflow per PWM period, so use 2 x PWM periods. An odd count in
+    center-aligned mode makes the update alternate between the top and
+    bottom of the count. Takes effect at the next update event.
+------------------------------------------------------------------------------*/
+void TIMx_Set_Repetition_Count(volatile TIMx_t * p_TIMx, uint32_t num_periods);
+
+/*------------------------------------------------------------------------------
+Function Name:
+    TIMx_Three_Phase_Init
+
+Function Description:
+    Set up three complementary PWM pairs with dead time for driving a
+    three-phase bridge, phases A, B and C on channels 1, 2 and 3. All
+    phases start at 50% duty.
+
+Parameters:
+    p_TIMx: pointer to the timer.
+    p_init_data: pointer to the three-phase initialization data.
+
+Returns:
+    true if the set up succeeded, false if the dead time is too long.
+
+Assumptions/Limitations:
+    TIM1 only. Assumes that the timer's RCC clock is enabled and the six
+    output pins are set up as alternate function outputs. The counter is
+    left stopped and the outputs off at their idle levels: call TIMx_Start,
+    then TIMx_Set_Main_Output_Enable to begin.
+------------------------------------------------------------------------------*/
+bool TIMx_Three_Phase_Init(volatile TIMx_t * p_TIMx, TIMx_Three_Phase_Initialization_Data_t * p_init_data);
+
+/*------------------------------------------------------------------------------
+Function Name:
+    TIMx_Three_Phase_Set_Duty
+
+Function Description:
+    Set the duty of the three phases. The compare registers are preloaded,
+    so the three values take effect together at the next update event.
+
+Parameters:
+    p_TIMx: pointer to the timer.
+    duty_a_counts: the compare value for phase A.
+    duty_b_counts: the compare value for phase B.
+    duty_c_counts: the compare value for phase C.
+
+Returns:
+    None
+
+Assumptions/Limitations:
+    The compare values are from 0 to TIMx_PWM_Get_Period_Counts.
+------------------------------------------------------------------------------*/
+void TIMx_Three_Phase_Set_Duty(volatile TIMx_t * p_TIMx, 
+                               uint32_t duty_a_counts, 
+                               uint32_t duty_b_counts, 
+                               uint32_t duty_c_counts);
+
+/*------------------------------------------------------------------------------
+Function Name:
+    TIMx_Six_Step_Init
+
+Function Description:
+    Set up a timer for six-step (trapezoidal) commutation. The channel
+    enables and modes are preloaded, so a whole step is staged in advance
+    and switched on every phase at once by a commutation event.
+
+Parameters:
+    p_TIMx: pointer to the timer.
+    p_init_data: pointer to the three-phase initialization data.
+
+Returns:
+    true if the set up succeeded, false if the dead time is too long.
+
+Assumptions/Limitations:
+    Same as TIMx_Three_Phase_Init. All phases start off; stage the first
+    step with TIMx_Six_Step_Set_Step and apply it with
+    TIMx_Six_Step_Commutate.
+------------------------------------------------------------------------------*/
+bool TIMx_Six_Step_Init(volatile TIMx_t * p_TIMx, TIMx_Three_Phase_Initialization_Data_t * p_init_data);
+
+/*------------------------------------------------------------------------------
+Function Name:
+    TIMx_Six_Step_Set_Step
+
+Function Description:
+    Stage a commutation step: one phase switching with PWM on its high
+    side (and synchronous rectification on its low side), one phase with
+    its low side on, and one phase off.
+
+      step:     0    1    2    3    4    5
+      PWM:      A    A    B    B    C    C
+      low:      B    C    C    A    A    B
+      off:      C    B    A    C    B    A
+
+Parameters:
+    p_TIMx: pointer to the timer.
+    step: the step [0 to 5].
+
+Returns:
+    None
+
+Assumptions/Limitations:
+    The step takes effect at the next commutation event, from
+    TIMx_Six_Step_Commutate or from TRGI if the CCUS bit is set. Reverse
+    rotation is the steps in the opposite order.
+------------------------------------------------------------------------------*/
+void TIMx_Six_Step_Set_Step(volatile TIMx_t * p_TIMx, uint32_t step);
+
+/*------------------------------------------------------------------------------
+Function Name:
+    TIMx_Six_Step_Commutate
+
+Function Description:
+    Apply the staged step with a commutation event.
+
+Parameters:
+    p_TIMx: pointer to the timer.
+
+Returns:
+    None
+
+Assumptions/Limitations:
+    None
+------------------------------------------------------------------------------*/
+void TIMx_Six_Step_Commutate(volatile TIMx_t * p_TIMx);
 
 #endif
@@ -0,0 +1,207 @@
+/*
+--|----------------------------------------------------------------------------|
+--| FILE DESCRIPTION:
+--|   PSP_Telemetry.h provides types and interfaces for streaming binary
+--|   telemetry records over a USART.
+--|
+--|   Each record is laid out, little endian, as:
+--|     type [1 byte] | payload length [1 byte] | sequence [2 bytes] |
+--|     payload [0 to TELEMETRY_MAX_PAYLOAD_LENGTH bytes] | CRC [4 bytes]
+--|   The CRC is the CRC unit's CRC-32 of the header and payload, padded with
+--|   zeros to whole words. Each record is COBS encoded and followed by a 0
+--|   byte, so a receiver can find the start of the next record after any
+--|   corruption. tools/telemetry_decode.c decodes the stream on a host.
+--|
+--|----------------------------------------------------------------------------|
+--| REFERENCES:
+--|   Consistent Overhead Byte Stuffing, S. Cheshire and M. Baker, 1999
+--|
+--|----------------------------------------------------------------------------|
+*/
+
+#ifndef PSP_TELEMETRY_H_INCLUDED
+#define PSP_TELEMETRY_H_INCLUDED
+
+/*
+--|----------------------------------------------------------------------------|
+--| INCLUDE FILES
+--|----------------------------------------------------------------------------|
+*/
+
+#include "Common_Typedefs.h"
+#include "PSP_Ring_Buffer.h"
+#include "PSP_USART.h"
+
+/*
+--|----------------------------------------------------------------------------|
+--| PUBLIC DEFINES
+--|----------------------------------------------------------------------------|
+*/
+
+/*
+--| NAME: TELEMETRY_MAX_PAYLOAD_LENGTH
+--| DESCRIPTION: the most payload bytes in one record
+--| TYPE: unsigned integer
+*/
+#define TELEMETRY_MAX_PAYLOAD_LENGTH (64u)
+
+/*
+--| NAME: TELEMETRY_HEADER_LENGTH
+--| DESCRIPTION: the bytes of a record before the payload
+--| TYPE: unsigned integer
+*/
+#define TELEMETRY_HEADER_LENGTH (4u)
+
+/*
+--| NAME: TELEMETRY_CRC_LENGTH
+--| DESCRIPTION: the bytes of a record after the payload
+--| TYPE: unsigned integer
+*/
+#define TELEMETRY_CRC_LENGTH (4u)
+
+/*
+--|----------------------------------------------------------------------------|
+--| PUBLIC TYPES
+--|----------------------------------------------------------------------------|
+*/
+
+/*
+--| NAME: Telemetry_Record_Type_enum
+--| DESCRIPTION: the layout of a record's payload
+*/
+typedef enum Telemetry_Record_Type_Enumeration
+{
+    TELEMETRY_RECORD_TYPE_TEXT       = 0x01u, // characters, not terminated
+    TELEMETRY_RECORD_TYPE_U8         = 0x02u, // array of uint8_t
+    TELEMETRY_RECORD_TYPE_U16        = 0x03u, // array of uint16_t
+    TELEMETRY_RECORD_TYPE_U32        = 0x04u, // array of uint32_t
+    TELEMETRY_RECORD_TYPE_I32        = 0x05u, // array of int32_t
+    TELEMETRY_RECORD_TYPE_F32        = 0x06u, // array of float32_t
+    TELEMETRY_RECORD_TYPE_USER_FIRST = 0x80u, // application defined, from here to 0xFF
+} Telemetry_Record_Type_enum;
+
+/*
+--| NAME: Telemetry_t
+--| DESCRIPTION: a telemetry stream. The members are private to the
+--|   telemetry module.
+*/
+typedef struct Telemetry_Type
+{
+    USART_Handle_t *  p_USART;        // the USART the stream is sent on
+    Ring_Buffer_t     frames;         // encoded records waiting to be sent
+    uint32_t          in_flight;      // bytes of frames being sent by DMA
+    uint16_t          sequence;       // sequence number of the next record
+    volatile uint32_t dropped_frames; // records dropped because frames was full
+} Telemetry_t;
+
+/*
+--|----------------------------------------------------------------------------|
+--| PUBLIC CONSTANTS
+--|----------------------------------------------------------------------------|
+*/
+
+/* None */
+
+/*
+--|----------------------------------------------------------------------------|
+--| PUBLIC VARIABLES
+--|----------------------------------------------------------------------------|
+*/
+
+/* None */
+
+/*
+--|----------------------------------------------------------------------------|
+--| PUBLIC FUNCTION PROTOTYPES
+--|----------------------------------------------------------------------------|
+*/
+
+/*------------------------------------------------------------------------------
+Function Name:
+    Telemetry_Init
+
+Function Description:
+    Set up a telemetry stream on an initialized USART.
+
+Parameters:
+    p_telemetry: pointer to the telemetry stream.
+    p_USART: the USART handle, after USART_Init.
+    p_buffer: storage for encoded records waiting to be sent.
+    buffer_size: the storage size in bytes, a power of 2.
+
+Returns:
+    true if the stream was set up, false if buffer_size is not a power
+    of 2.
+
+Assumptions/Limitations:
+    Assumes the CRC clock is enabled (RCC_AHBENR_CRCEN_FLAG). The stream
+    must be the only user of the USART's transmitter.
+------------------------------------------------------------------------------*/
+bool Telemetry_Init(Telemetry_t * p_telemetry, USART_Handle_t * p_USART, uint8_t * p_buffer, uint32_t buffer_size);
+
+/*------------------------------------------------------------------------------
+Function Name:
+    Telemetry_Send
+
+Function Description:
+    Encode a record and queue it to be sent by the next Telemetry_Flush.
+    Every record within the length limit takes a sequence number, even if
+    there is no room to queue it, so the receiver can count lost records.
+    A record which is too long is rejected without taking one.
+
+Parameters:
+    p_telemetry: pointer to the telemetry stream.
+    type: the record type, a Telemetry_Record_Type_enum or user type.
+    p_payload: the payload.
+    length: the payload length in bytes [0 to TELEMETRY_MAX_PAYLOAD_LENGTH].
+
+Returns:
+    true if the record was queued, false if it is too long or there is no
+    room for it.
+
+Assumptions/Limitations:
+    Must only be called from one context, which may be an interrupt. Uses
+    the CRC unit.
+------------------------------------------------------------------------------*/
+bool Telemetry_Send(Telemetry_t * p_telemetry, uint8_t type, const void * p_payload, uint32_t length);
+
+/*------------------------------------------------------------------------------
+Function Name:
+    Telemetry_Flush
+
+Function Description:
+    Once the last transfer is done, start DMA on the queued records which
+    are contiguous in the buffer. Call often, for instance from the main
+    loop, to keep the USART busy.
+
+Parameters:
+    p_telemetry: pointer to the telemetry stream.
+
+Returns:
+    None
+
+Assumptions/Limitations:
+    Must only be called from one context, which may differ from the one
+    calling Telemetry_Send.
+------------------------------------------------------------------------------*/
+void Telemetry_Flush(Telemetry_t * p_telemetry);
+
+/*------------------------------------------------------------------------------
+Function Name:
+    Telemetry_Get_Dropped
+
+Function Description:
+    Get the number of records dropped because the buffer was full.
+
+Parameters:
+    p_telemetry: pointer to the telemetry stream.
+
+Returns:
+    uint32_t: the dropped records.
+
+Assumptions/Limitations:
+    None
+------------------------------------------------------------------------------*/
+uint32_t Telemetry_Get_Dropped(Telemetry_t * p_telemetry);
+
+#endif
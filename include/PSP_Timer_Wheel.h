@@ -0,0 +1,251 @@
+/*
+--|----------------------------------------------------------------------------|
+--| FILE DESCRIPTION:
+--|   PSP_Timer_Wheel.h provides a hierarchical timer wheel for software
+--|   timeouts driven by the SysTick millisecond count.
+--|
+--|   Starting and cancelling a timer is O(1), and timers cost nothing until
+--|   they expire, no matter how many are running. The wheel is serviced in
+--|   thread context, not in the SysTick handler, which only counts mSec: call
+--|   Timer_Wheel_Service from the main loop to advance the wheel and run the
+--|   callbacks of expired timers.
+--|
+--|----------------------------------------------------------------------------|
+--| REFERENCES:
+--|   Varghese & Lauck, "Hashed and Hierarchical Timing Wheels", 1987
+--|
+--|----------------------------------------------------------------------------|
+*/
+
+#ifndef PSP_TIMER_WHEEL_H_INCLUDED
+#define PSP_TIMER_WHEEL_H_INCLUDED
+
+/*
+--|----------------------------------------------------------------------------|
+--| INCLUDE FILES
+--|----------------------------------------------------------------------------|
+*/
+
+#include "Common_Typedefs.h"
+
+/*
+--|----------------------------------------------------------------------------|
+--| PUBLIC DEFINES
+--|----------------------------------------------------------------------------|
+*/
+
+/*
+--| NAME: TIMER_WHEEL_SLOT_BITS
+--| DESCRIPTION: log2 of the number of slots in each level of the wheel
+--| TYPE: unsigned integer
+*/
+#define TIMER_WHEEL_SLOT_BITS (6u)
+
+/*
+--| NAME: TIMER_WHEEL_NUM_SLOTS
+--| DESCRIPTION: the number of slots in each level of the wheel
+--| TYPE: unsigned integer
+*/
+#define TIMER_WHEEL_NUM_SLOTS (1u << TIMER_WHEEL_SLOT_BITS)
+
+/*
+--| NAME: TIMER_WHEEL_NUM_LEVELS
+--| DESCRIPTION: the number of levels, giving 2^24 mSec (about 4.6 hours) of
+--|   range before long timeouts need an extra cascade
+--| TYPE: unsigned integer
+*/
+#define TIMER_WHEEL_NUM_LEVELS (4u)
+
+/*
+--|----------------------------------------------------------------------------|
+--| PUBLIC TYPES
+--|----------------------------------------------------------------------------|
+*/
+
+/*
+--| NAME: Timer_Wheel_Callback_t
+--| DESCRIPTION: function called in thread context when a timer expires
+*/
+typedef void (*Timer_Wheel_Callback_t)(void * p_context);
+
+/*
+--| NAME: Timer_Wheel_Timer_t
+--| DESCRIPTION: storage for one timer, owned by the caller. The members are
+--|   private to the timer wheel.
+*/
+typedef struct Timer_Wheel_Timer_Type
+{
+    struct Timer_Wheel_Timer_Type *  p_next;       // next timer in the same list
+    struct Timer_Wheel_Timer_Type ** pp_prev_next; // the link pointing at this timer, NULL if inactive
+    Timer_Wheel_Callback_t           callback;     // called on expiry
+    void *                           p_context;    // passed to the callback
+    uint32_t                         expiry_mSec;  // absolute expiry time
+    uint32_t                         period_mSec;  // reload period, 0 for one-shot timers
+    uint8_t                          level;        // wheel level holding the timer
+    uint8_t                          slot;         // slot within the level
+} Timer_Wheel_Timer_t;
+
+/*
+--|----------------------------------------------------------------------------|
+--| PUBLIC CONSTANTS
+--|----------------------------------------------------------------------------|
+*/
+
+/* None */
+
+/*
+--|----------------------------------------------------------------------------|
+--| PUBLIC VARIABLES
+--|----------------------------------------------------------------------------|
+*/
+
+/* None */
+
+/*
+--|----------------------------------------------------------------------------|
+--| PUBLIC FUNCTION PROTOTYPES
+--|----------------------------------------------------------------------------|
+*/
+
+/*------------------------------------------------------------------------------
+Function Name:
+    Timer_Wheel_Start_One_Shot
+
+Function Description:
+    Start a timer which calls the given callback once, after the given delay.
+    If the timer is already running it is restarted.
+
+Parameters:
+    p_timer: pointer to the timer storage.
+    delay_mSec: the delay before expiry in mSec [0 to 2^31 - 1].
+    callback: the function to call on expiry.
+    p_context: passed to the callback.
+
+Returns:
+    None
+
+Assumptions/Limitations:
+    Must be called from thread context, not from an interrupt.
+
+    The timer storage must be zero-initialized (static storage, or memset)
+    before its first use.
+------------------------------------------------------------------------------*/
+void Timer_Wheel_Start_One_Shot(Timer_Wheel_Timer_t * p_timer,
+                                uint32_t delay_mSec,
+                                Timer_Wheel_Callback_t callback,
+                                void * p_context);
+
+/*------------------------------------------------------------------------------
+Function Name:
+    Timer_Wheel_Start_Periodic
+
+Function Description:
+    Start a timer which calls the given callback every period. Expiry times
+    are advanced by exactly one period, so the timer does not drift even if
+    Timer_Wheel_Service is called late. If the timer is already running it is
+    restarted.
+
+Parameters:
+    p_timer: pointer to the timer storage.
+    period_mSec: the period in mSec [1 to 2^31 - 1].
+    callback: the function to call on expiry.
+    p_context: passed to the callback.
+
+Returns:
+    None
+
+Assumptions/Limitations:
+    Must be called from thread context, not from an interrupt.
+
+    The timer storage must be zero-initialized (static storage, or memset)
+    before its first use.
+------------------------------------------------------------------------------*/
+void Timer_Wheel_Start_Periodic(Timer_Wheel_Timer_t * p_timer,
+                                uint32_t period_mSec,
+                                Timer_Wheel_Callback_t callback,
+                                void * p_context);
+
+/*------------------------------------------------------------------------------
+Function Name:
+    Timer_Wheel_Cancel
+
+Function Description:
+    Stop a timer. Cancelling a timer which is not running has no effect.
+
+Parameters:
+    p_timer: pointer to the timer storage.
+
+Returns:
+    None
+
+Assumptions/Limitations:
+    Must be called from thread context, not from an interrupt. May be called
+    from within a timer callback.
+------------------------------------------------------------------------------*/
+void Timer_Wheel_Cancel(Timer_Wheel_Timer_t * p_timer);
+
+/*------------------------------------------------------------------------------
+Function Name:
+    Timer_Wheel_Is_Active
+
+Function Description:
+    Check if a timer is running.
+
+Parameters:
+    p_timer: pointer to the timer storage.
+
+Returns:
+    true if the timer is running or has expired and is waiting to be
+    serviced, else false.
+
+Assumptions/Limitations:
+    None
+------------------------------------------------------------------------------*/
+bool Timer_Wheel_Is_Active(Timer_Wheel_Timer_t * p_timer);
+
+/*------------------------------------------------------------------------------
+Function Name:
+    Timer_Wheel_Service
+
+Function Description:
+    Advance the wheel up to the current SysTick time and call the callbacks
+    of every timer which has expired. The wheel jumps from one occupied slot
+    or cascade to the next, so catching up after a long gap, such as a
+    tickless sleep, costs per event rather than per mSec.
+
+Parameters:
+    None
+
+Returns:
+    None
+
+Assumptions/Limitations:
+    Must be called regularly from the main loop, not from an interrupt or
+    the SysTick handler. Timers can not expire with better precision than
+    the interval between calls.
+------------------------------------------------------------------------------*/
+void Timer_Wheel_Service(void);
+
+/*------------------------------------------------------------------------------
+Function Name:
+    Timer_Wheel_Get_mSec_Until_Next_Expiry
+
+Function Description:
+    Get how long the wheel can be left alone before Timer_Wheel_Service
+    needs to be called again, for sleeping with SysTick_Tickless_Idle.
+
+Parameters:
+    None
+
+Returns:
+    uint32_t: the time in mSec until the earliest timer expiry or cascade,
+    0 if servicing is already due, or UINT32_MAX if no timers are running.
+
+Assumptions/Limitations:
+    Must be called from thread context, not from an interrupt. The result
+    may be earlier than the real next expiry, since timers in higher levels
+    are only known to the resolution of their slot.
+------------------------------------------------------------------------------*/
+uint32_t Timer_Wheel_Get_mSec_Until_Next_Expiry(void);
+
+#endif
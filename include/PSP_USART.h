@@ -0,0 +1,321 @@
+/*
+--|----------------------------------------------------------------------------|
+--| FILE DESCRIPTION:
+--|   PSP_USART.h provides types and interfaces for USART1, USART2 and
+--|   USART3, with DMA transmit and receive.
+--|
+--|----------------------------------------------------------------------------|
+--| REFERENCES:
+--|   stm32f10x reference manual, page 771
+--|
+--|----------------------------------------------------------------------------|
+*/
+
+#ifndef PSP_USART_H_INCLUDED
+#define PSP_USART_H_INCLUDED
+
+/*
+--|----------------------------------------------------------------------------|
+--| INCLUDE FILES
+--|----------------------------------------------------------------------------|
+*/
+
+#include "Common_Masks.h"
+#include "Common_Typedefs.h"
+#include "PSP_DMA.h"
+#include "PSP_Peripherals_Memory_Map.h"
+
+/*
+--|----------------------------------------------------------------------------|
+--| PUBLIC DEFINES
+--|----------------------------------------------------------------------------|
+*/
+
+/*
+--| NAME: USART1
+--| DESCRIPTION: pointer to USART 1
+--| TYPE: USART_t*
+*/
+#define USART1 ((volatile USART_t *)PSP_PERIPHERAL_USART1_BASE)
+
+/*
+--| NAME: USART2
+--| DESCRIPTION: pointer to USART 2
+--| TYPE: USART_t*
+*/
+#define USART2 ((volatile USART_t *)PSP_PERIPHERAL_USART2_BASE)
+
+/*
+--| NAME: USART3
+--| DESCRIPTION: pointer to USART 3
+--| TYPE: USART_t*
+*/
+#define USART3 ((volatile USART_t *)PSP_PERIPHERAL_USART3_BASE)
+
+/*
+--| NAME: USART_TX_QUEUE_LENGTH
+--| DESCRIPTION: the number of writes which can wait to be sent, a power of 2
+--| TYPE: unsigned integer
+*/
+#define USART_TX_QUEUE_LENGTH (8u)
+
+/*
+--|----------------------------------------------------------------------------|
+--| PUBLIC TYPES
+--|----------------------------------------------------------------------------|
+*/
+
+/*
+--| NAME: USART_t
+--| DESCRIPTION: USARTn register structure
+*/
+typedef struct USART_Type
+{
+    vuint32_t SR;   // status register
+    vuint32_t DR;   // data register
+    vuint32_t BRR;  // baud rate register
+    vuint32_t CR1;  // control register 1
+    vuint32_t CR2;  // control register 2
+    vuint32_t CR3;  // control register 3
+    vuint32_t GTPR; // guard time and prescaler register
+} USART_t;
+
+/*
+--| NAME: USART_SR_FLAGS_enum
+--| DESCRIPTION: USART status register flags
+*/
+typedef enum USART_SR_FLAGS_Enumeration
+{
+    USART_SR_CTS_FLAG  = (1u << 9u), // CTS flag [rc_w0]
+    USART_SR_LBD_FLAG  = (1u << 8u), // LIN break detection flag [rc_w0]
+    USART_SR_TXE_FLAG  = (1u << 7u), // transmit data register empty [r]
+    USART_SR_TC_FLAG   = (1u << 6u), // transmission complete [rc_w0]
+    USART_SR_RXNE_FLAG = (1u << 5u), // read data register not empty [rc_w0]
+    USART_SR_IDLE_FLAG = (1u << 4u), // idle line detected, cleared by reading SR then DR [r]
+    USART_SR_ORE_FLAG  = (1u << 3u), // overrun error [r]
+    USART_SR_NE_FLAG   = (1u << 2u), // noise error [r]
+    USART_SR_FE_FLAG   = (1u << 1u), // framing error [r]
+    USART_SR_PE_FLAG   = (1u << 0u), // parity error [r]
+} USART_SR_FLAGS_enum;
+
+/*
+--| NAME: USART_CR1_FLAGS_enum
+--| DESCRIPTION: USART control register 1 flags
+*/
+typedef enum USART_CR1_FLAGS_Enumeration
+{
+    USART_CR1_UE_FLAG     = (1u << 13u), // USART enable [rw]
+    USART_CR1_M_FLAG      = (1u << 12u), // 0: 8 data bits, 1: 9 data bits [rw]
+    USART_CR1_WAKE_FLAG   = (1u << 11u), // wakeup method [rw]
+    USART_CR1_PCE_FLAG    = (1u << 10u), // parity control enable [rw]
+    USART_CR1_PS_FLAG     = (1u << 9u),  // 0: even parity, 1: odd parity [rw]
+    USART_CR1_PEIE_FLAG   = (1u << 8u),  // parity error interrupt enable [rw]
+    USART_CR1_TXEIE_FLAG  = (1u << 7u),  // TXE interrupt enable [rw]
+    USART_CR1_TCIE_FLAG   = (1u << 6u),  // transmission complete interrupt enable [rw]
+    USART_CR1_RXNEIE_FLAG = (1u << 5u),  // RXNE interrupt enable [rw]
+    USART_CR1_IDLEIE_FLAG = (1u << 4u),  // IDLE interrupt enable [rw]
+    USART_CR1_TE_FLAG     = (1u << 3u),  // transmitter enable [rw]
+    USART_CR1_RE_FLAG     = (1u << 2u),  // receiver enable [rw]
+    USART_CR1_RWU_FLAG    = (1u << 1u),  // receiver wakeup [rw]
+    USART_CR1_SBK_FLAG    = (1u << 0u),  // send break [rw]
+} USART_CR1_FLAGS_enum;
+
+/*
+--| NAME: USART_CR2_STOP_MASKS_enum
+--| DESCRIPTION: USART CR2 stop bits masks [2 bits, rw]
+*/
+typedef enum USART_CR2_STOP_MASKS_Enumeration
+{
+    USART_CR2_STOP_1_BIT          = 0b00u, // 1 stop bit
+    USART_CR2_STOP_HALF_BIT       = 0b01u, // 0.5 stop bit
+    USART_CR2_STOP_2_BITS         = 0b10u, // 2 stop bits
+    USART_CR2_STOP_1_AND_HALF_BIT = 0b11u, // 1.5 stop bits
+    USART_CR2_STOP_SHIFT_AMT      = 12u,   // position of STOP in USART CR2
+} USART_CR2_STOP_MASKS_enum;
+
+/*
+--| NAME: USART_CR3_FLAGS_enum
+--| DESCRIPTION: USART control register 3 flags
+*/
+typedef enum USART_CR3_FLAGS_Enumeration
+{
+    USART_CR3_CTSIE_FLAG = (1u << 10u), // CTS interrupt enable [rw]
+    USART_CR3_CTSE_FLAG  = (1u << 9u),  // CTS enable [rw]
+    USART_CR3_RTSE_FLAG  = (1u << 8u),  // RTS enable [rw]
+    USART_CR3_DMAT_FLAG  = (1u << 7u),  // DMA enable transmitter [rw]
+    USART_CR3_DMAR_FLAG  = (1u << 6u),  // DMA enable receiver [rw]
+    USART_CR3_SCEN_FLAG  = (1u << 5u),  // smartcard mode enable [rw]
+    USART_CR3_NACK_FLAG  = (1u << 4u),  // smartcard NACK enable [rw]
+    USART_CR3_HDSEL_FLAG = (1u << 3u),  // half-duplex selection [rw]
+    USART_CR3_IRLP_FLAG  = (1u << 2u),  // IrDA low-power [rw]
+    USART_CR3_IREN_FLAG  = (1u << 1u),  // IrDA mode enable [rw]
+    USART_CR3_EIE_FLAG   = (1u << 0u),  // error interrupt enable [rw]
+} USART_CR3_FLAGS_enum;
+
+/*
+--| NAME: USART_RX_Callback_t
+--| DESCRIPTION: function called from the interrupt handler with received
+--|   data, in place in the receive buffer. A frame may arrive over several
+--|   calls, the last with frame_end set, which may have a length of 0.
+*/
+typedef void (*USART_RX_Callback_t)(void * p_context, const uint8_t * p_data, uint32_t length, bool frame_end);
+
+/*
+--| NAME: USART_TX_Descriptor_t
+--| DESCRIPTION: one write waiting to be sent
+*/
+typedef struct USART_TX_Descriptor_Type
+{
+    const uint8_t * p_data; // the data, which must stay unchanged until sent
+    uint32_t        length; // the number of bytes
+} USART_TX_Descriptor_t;
+
+/*
+--| NAME: USART_Initialization_Data_t
+--| DESCRIPTION: structure for USART initialization data
+*/
+typedef struct USART_Initialization_Data_Type
+{
+    uint32_t            baud_rate;      // bits per second, up to the bus clock / 16
+    uint8_t *           p_rx_buffer;    // the circular receive buffer, NULL for transmit only
+    uint32_t            rx_buffer_size; // the receive buffer size in bytes [2 to 65535]
+    USART_RX_Callback_t rx_callback;    // called with received data
+    void *              p_context;      // passed to the callback
+} USART_Initialization_Data_t;
+
+/*
+--| NAME: USART_Handle_t
+--| DESCRIPTION: handle to a USART. The members are private to the USART
+--|   driver, except p_USART, which is set before USART_Init.
+*/
+typedef struct USART_Handle_Type
+{
+    volatile USART_t *             p_USART;                         // the USART
+    DMA_Channel_enum               tx_channel;                      // DMA channel of the transmitter
+    DMA_Channel_enum               rx_channel;                      // DMA channel of the receiver
+    uint32_t                       baud_rate;                       // the actual baud rate
+    uint8_t *                      p_rx_buffer;                     // the circular receive buffer
+    uint32_t                       rx_buffer_size;                  // the receive buffer size in bytes
+    uint32_t                       rx_read_index;                   // the first byte not yet given to the callback
+    USART_RX_Callback_t            rx_callback;                     // called with received data
+    void *                         p_context;                       // passed to the callback
+    volatile USART_TX_Descriptor_t tx_queue[USART_TX_QUEUE_LENGTH]; // writes waiting to be sent
+    volatile uint32_t              tx_head;                         // count of writes queued, written by USART_Write
+    volatile uint32_t              tx_tail;                         // count of writes sent, written by the interrupt handler
+    volatile bool                  tx_busy;                         // true while the transmit DMA channel runs
+} USART_Handle_t;
+
+/*
+--|----------------------------------------------------------------------------|
+--| PUBLIC CONSTANTS
+--|----------------------------------------------------------------------------|
+*/
+
+/* None */
+
+/*
+--|----------------------------------------------------------------------------|
+--| PUBLIC VARIABLES
+--|----------------------------------------------------------------------------|
+*/
+
+/* None */
+
+/*
+--|----------------------------------------------------------------------------|
+--| PUBLIC FUNCTION PROTOTYPES
+--|----------------------------------------------------------------------------|
+*/
+
+/*------------------------------------------------------------------------------
+Function Name:
+    USART_Init
+
+Function Description:
+    Set up a USART for 8 data bits, no parity and 1 stop bit, with DMA
+    transmit and, if a receive buffer is given, circular DMA receive.
+    Received data is given to the callback in place when the line goes
+    idle after a frame, and each time DMA fills half of the buffer, so no
+    interrupt is taken per byte.
+
+Parameters:
+    p_handle: pointer to the USART handle, with p_USART set.
+    p_init_data: pointer to the USART initialization data.
+
+Returns:
+    uint32_t: the actual baud rate.
+
+Assumptions/Limitations:
+    Assumes that the USART's RCC clock is enabled and its TX and RX pins
+    are set up. Uses the USART's DMA1 channels: USART1 TX 4, RX 5,
+    USART2 TX 7, RX 6, USART3 TX 2, RX 3.
+
+    Enable the USART's IRQ and both DMA channels' IRQs in the NVIC at the
+    same priority, and call USART_IRQ_Handler from each handler.
+
+    The callback must keep up with the line: it is given at most half of
+    the buffer at a time, and that data is overwritten once DMA has
+    received another half buffer.
+------------------------------------------------------------------------------*/
+uint32_t USART_Init(USART_Handle_t * p_handle, USART_Initialization_Data_t * p_init_data);
+
+/*------------------------------------------------------------------------------
+Function Name:
+    USART_IRQ_Handler
+
+Function Description:
+    Process the idle line, receive DMA half and full, and transmit DMA
+    complete events of a USART.
+
+Parameters:
+    p_handle: pointer to the USART handle.
+
+Returns:
+    None
+
+Assumptions/Limitations:
+    Call from the USART's and both its DMA channels' interrupt handlers,
+    which must not preempt each other.
+------------------------------------------------------------------------------*/
+void USART_IRQ_Handler(USART_Handle_t * p_handle);
+
+/*------------------------------------------------------------------------------
+Function Name:
+    USART_Write
+
+Function Description:
+    Queue data to be sent by DMA. The data is not copied.
+
+Parameters:
+    p_handle: pointer to the USART handle.
+    p_data: the data, which must stay unchanged until it has been sent.
+    length: the number of bytes [1 to 65535].
+
+Returns:
+    true if the data was queued, false if the queue is full.
+
+Assumptions/Limitations:
+    Only one context, thread or interrupt, may write to a USART.
+------------------------------------------------------------------------------*/
+bool USART_Write(USART_Handle_t * p_handle, const uint8_t * p_data, uint32_t length);
+
+/*------------------------------------------------------------------------------
+Function Name:
+    USART_Is_TX_Idle
+
+Function Description:
+    Check whether every queued write has been handed to the transmitter.
+
+Parameters:
+    p_handle: pointer to the USART handle.
+
+Returns:
+    true if nothing is queued or being sent by DMA, else false.
+
+Assumptions/Limitations:
+    The last byte may still be shifting out, check USART_SR_TC_FLAG before
+    turning the USART off.
+------------------------------------------------------------------------------*/
+bool USART_Is_TX_Idle(USART_Handle_t * p_handle);
+
+#endif
@@ -0,0 +1,337 @@
+/*
+--|----------------------------------------------------------------------------|
+--| FILE DESCRIPTION:
+--|   PSP_ADC.c provides the implementation for ADC1.
+--|
+--|   Each trigger event makes the ADC convert the whole scan sequence, and
+--|   DMA1 channel 1 moves every result to the double buffer, so the CPU
+--|   does no work per sample. The DMA half and full interrupts hand each
+--|   half of the buffer to the callback while DMA fills the other half.
+--|
+--|----------------------------------------------------------------------------|
+--| REFERENCES:
+--|   stm32f10x reference manual, page 215
+--|
+--|----------------------------------------------------------------------------|
+*/
+
+/*
+--|----------------------------------------------------------------------------|
+--| INCLUDE FILES
+--|----------------------------------------------------------------------------|
+*/
+
+#include <stddef.h>
+
+#include "PSP_ADC.h"
+#include "PSP_Clock_Tree.h"
+#include "PSP_DMA.h"
+
+/*
+--|----------------------------------------------------------------------------|
+--| PRIVATE DEFINES
+--|----------------------------------------------------------------------------|
+*/
+
+/*
+--| NAME: ADC_DMA_CHANNEL
+--| DESCRIPTION: the DMA1 channel hard wired to ADC1
+--| TYPE: DMA_Channel_enum
+*/
+#define ADC_DMA_CHANNEL (DMA_CHANNEL_1)
+
+/*
+--| NAME: ADC_STABILIZATION_READS
+--| DESCRIPTION: register reads to wait out the 1 uSec power up time
+--|   (tSTAB), each takes at least one HCLK cycle
+--| TYPE: unsigned integer
+*/
+#define ADC_STABILIZATION_READS (CLOCK_TREE_HCLK_HZ / 1000000u)
+
+/*
+--| NAME: ADC_CONVERSION_HALF_CYCLES
+--| DESCRIPTION: the ADC clock half cycles of a conversion after sampling
+--|   (12.5 cycles)
+--| TYPE: unsigned integer
+*/
+#define ADC_CONVERSION_HALF_CYCLES (25u)
+
+/*
+--| NAME: ADC_SMPR1_FIRST_CHANNEL
+--| DESCRIPTION: the first channel whose sample time is in SMPR1
+--| TYPE: unsigned integer
+*/
+#define ADC_SMPR1_FIRST_CHANNEL (10u)
+
+/*
+--|----------------------------------------------------------------------------|
+--| PRIVATE TYPES
+--|----------------------------------------------------------------------------|
+*/
+
+/* None */
+
+/*
+--|----------------------------------------------------------------------------|
+--| PRIVATE CONSTANTS
+--|----------------------------------------------------------------------------|
+*/
+
+/*
+--| NAME: ADC_sample_half_cycles
+--| DESCRIPTION: the ADC clock half cycles of each sample time, indexed by
+--|   ADC_SMPR_MASKS_enum
+--| TYPE: uint32_t
+*/
+static const uint32_t ADC_sample_half_cycles[] =
+{
+    3u,   // 1.5 cycles
+    15u,  // 7.5 cycles
+    27u,  // 13.5 cycles
+    57u,  // 28.5 cycles
+    83u,  // 41.5 cycles
+    111u, // 55.5 cycles
+    143u, // 71.5 cycles
+    479u, // 239.5 cycles
+};
+
+/*
+--|----------------------------------------------------------------------------|
+--| PRIVATE VARIABLES
+--|----------------------------------------------------------------------------|
+*/
+
+/* None */
+
+/*
+--|----------------------------------------------------------------------------|
+--| PRIVATE HELPER FUNCTION PROTOTYPES
+--|----------------------------------------------------------------------------|
+*/
+
+/*------------------------------------------------------------------------------
+Function Name:
+    ADC_Calibrate
+
+Function Description:
+    Power up ADC1 and run its self calibration.
+
+Parameters:
+    None
+
+Returns:
+    None
+
+Assumptions/Limitations:
+    Assumes ADC1 is powered down, the calibration needs 2 ADC clock cycles
+    after power up, which the stabilization time covers.
+------------------------------------------------------------------------------*/
+static void ADC_Calibrate(void);
+
+/*------------------------------------------------------------------------------
+Function Name:
+    ADC_Set_Sequence
+
+Function Description:
+    Program the scan sequence and the sample time of each channel in it.
+
+Parameters:
+    p_sequence: the conversions of one scan.
+    sequence_length: the number of conversions.
+
+Returns:
+    uint32_t: the ADC clock half cycles one scan takes.
+
+Assumptions/Limitations:
+    Assumes the sequence has been checked.
+------------------------------------------------------------------------------*/
+static uint32_t ADC_Set_Sequence(const ADC_Sequence_Entry_t * p_sequence, uint32_t sequence_length);
+
+/*
+--|----------------------------------------------------------------------------|
+--| PUBLIC FUNCTION DEFINITIONS
+--|----------------------------------------------------------------------------|
+*/
+
+bool ADC_Init(ADC_Handle_t * p_handle, ADC_Initialization_Data_t * p_init_data)
+{
+    const uint32_t half_length = p_init_data->scans_per_half * p_init_data->sequence_length;
+    uint32_t       cr2         = ADC_CR2_ADON_FLAG | ADC_CR2_DMA_FLAG;
+    uint32_t       scan_half_cycles;
+    uint32_t       i;
+
+    DMA_Channel_Initialization_Data_t dma_init_data =
+    {
+        &ADC1->DR,
+        p_init_data->p_buffer,
+        2u * half_length,
+        DMA_CCR_SIZE_16_BITS,
+        DMA_CCR_PL_VERY_HIGH,
+        DMA_CCR_MINC_FLAG | DMA_CCR_CIRC_FLAG | DMA_CCR_HTIE_FLAG | DMA_CCR_TCIE_FLAG
+    };
+
+    if ((p_init_data->sequence_length == 0u) || (p_init_data->sequence_length > ADC_MAX_SEQUENCE_LENGTH) ||
+        (p_init_data->scans_per_half == 0u) || ((2u * half_length) > 0xFFFFu))
+    {
+        return false;
+    }
+
+    for (i = 0u; i < p_init_data->sequence_length; i++)
+    {
+        if ((p_init_data->p_sequence[i].channel > ADC_MAX_CHANNEL) ||
+            (p_init_data->p_sequence[i].sample_time > ADC_SMPR_239_5_CYCLES))
+        {
+            return false;
+        }
+
+        // the temperature sensor and internal reference are powered separately
+        if (p_init_data->p_sequence[i].channel >= 16u)
+        {
+            cr2 |= ADC_CR2_TSVREFE_FLAG;
+        }
+    }
+
+    ADC1->CR2 = 0u;
+    ADC_Calibrate();
+
+    scan_half_cycles = ADC_Set_Sequence(p_init_data->p_sequence, p_init_data->sequence_length);
+
+    p_handle->trigger        = p_init_data->trigger;
+    p_handle->p_buffer       = p_init_data->p_buffer;
+    p_handle->half_length    = half_length;
+    p_handle->scans_per_half = p_init_data->scans_per_half;
+    p_handle->scan_rate_max  = (2u * CLOCK_TREE_ADC_CLK_HZ) / scan_half_cycles;
+    p_handle->half_callback  = p_init_data->half_callback;
+    p_handle->p_context      = p_init_data->p_context;
+    p_handle->overruns       = 0u;
+
+    DMA_Channel_Init(ADC_DMA_CHANNEL, &dma_init_data);
+
+    // scan the whole sequence per trigger, right aligned, with triggers ignored until ADC_Start
+    ADC1->CR1 = ADC_CR1_SCAN_FLAG;
+    ADC1->CR2 = cr2 | (p_init_data->trigger << ADC_CR2_EXTSEL_SHIFT_AMT);
+
+    return true;
+}
+
+void ADC_Start(ADC_Handle_t * p_handle)
+{
+    if (p_handle->trigger == ADC_CR2_EXTSEL_SWSTART)
+    {
+        ADC1->CR2 |= ADC_CR2_CONT_FLAG | ADC_CR2_EXTTRIG_FLAG;
+        ADC1->CR2 |= ADC_CR2_SWSTART_FLAG;
+    }
+    else
+    {
+        ADC1->CR2 |= ADC_CR2_EXTTRIG_FLAG;
+    }
+}
+
+void ADC_Stop(ADC_Handle_t * p_handle)
+{
+    (void)p_handle;
+
+    ADC1->CR2 &= ~(ADC_CR2_CONT_FLAG | ADC_CR2_EXTTRIG_FLAG);
+}
+
+void ADC_DMA_IRQ_Handler(ADC_Handle_t * p_handle)
+{
+    const uint32_t flags = DMA_Channel_Get_Flags(ADC_DMA_CHANNEL) & (DMA_ISR_HTIF_FLAG | DMA_ISR_TCIF_FLAG);
+    bool           first_half_done;
+
+    if (flags == 0u)
+    {
+        return;
+    }
+
+    DMA_Channel_Clear_Flags(ADC_DMA_CHANNEL, flags | DMA_ISR_GIF_FLAG);
+
+    // both halves filled since the last interrupt, so DMA is already overwriting one
+    if (flags == (DMA_ISR_HTIF_FLAG | DMA_ISR_TCIF_FLAG))
+    {
+        p_handle->overruns++;
+    }
+
+    // hand over whichever half DMA is not writing now, rather than trusting the flags
+    first_half_done = DMA_Channel_Get_Remaining(ADC_DMA_CHANNEL) <= p_handle->half_length;
+
+    if (p_handle->half_callback != NULL)
+    {
+        p_handle->half_callback(p_handle->p_context,
+                                first_half_done ? p_handle->p_buffer : &p_handle->p_buffer[p_handle->half_length],
+                                p_handle->scans_per_half);
+    }
+}
+
+uint32_t ADC_Get_Max_Scan_Rate_Hz(ADC_Handle_t * p_handle)
+{
+    return p_handle->scan_rate_max;
+}
+
+uint32_t ADC_Get_Overruns(ADC_Handle_t * p_handle)
+{
+    return p_handle->overruns;
+}
+
+/*
+--|----------------------------------------------------------------------------|
+--| PRIVATE HELPER FUNCTION DEFINITIONS
+--|----------------------------------------------------------------------------|
+*/
+
+static void ADC_Calibrate(void)
+{
+    uint32_t i;
+
+    ADC1->CR2 = ADC_CR2_ADON_FLAG;
+
+    for (i = 0u; i < ADC_STABILIZATION_READS; i++)
+    {
+        (void)ADC1->SR;
+    }
+
+    ADC1->CR2 |= ADC_CR2_RSTCAL_FLAG;
+    while ((ADC1->CR2 & ADC_CR2_RSTCAL_FLAG) != 0u)
+    {
+        // wait for the calibration registers to reset
+    }
+
+    ADC1->CR2 |= ADC_CR2_CAL_FLAG;
+    while ((ADC1->CR2 & ADC_CR2_CAL_FLAG) != 0u)
+    {
+        // wait for the calibration to finish
+    }
+}
+
+static uint32_t ADC_Set_Sequence(const ADC_Sequence_Entry_t * p_sequence, uint32_t sequence_length)
+{
+    uint32_t smpr[2]          = {0u, 0u};
+    uint32_t sqr[3]           = {0u, 0u, 0u};
+    uint32_t scan_half_cycles = 0u;
+    uint32_t i;
+
+    for (i = 0u; i < sequence_length; i++)
+    {
+        const uint32_t channel        = p_sequence[i].channel;
+        const uint32_t register_index = i / ADC_SQR_SQ_PER_REG;
+        const uint32_t smpr_index     = (channel >= ADC_SMPR1_FIRST_CHANNEL) ? 0u : 1u;
+        const uint32_t smpr_shift     = (channel % ADC_SMPR1_FIRST_CHANNEL) * ADC_SMPR_WIDTH;
+
+        // SMPR1 holds channels 10 to 17, SMPR2 channels 0 to 9, a repeated channel keeps its last sample time
+        smpr[smpr_index] &= ~(ADC_SMPR_239_5_CYCLES << smpr_shift);
+        smpr[smpr_index] |= p_sequence[i].sample_time << smpr_shift;
+
+        // SQR3 holds conversions 1 to 6, SQR2 7 to 12 and SQR1 13 to 16
+        sqr[2u - register_index] |= channel << ((i % ADC_SQR_SQ_PER_REG) * ADC_SQR_SQ_WIDTH);
+
+        scan_half_cycles += ADC_sample_half_cycles[p_sequence[i].sample_time] + ADC_CONVERSION_HALF_CYCLES;
+    }
+
+    ADC1->SMPR1 = smpr[0];
+    ADC1->SMPR2 = smpr[1];
+    ADC1->SQR1  = sqr[0] | ((sequence_length - 1u) << ADC_SQR1_L_SHIFT_AMT);
+    ADC1->SQR2  = sqr[1];
+    ADC1->SQR3  = sqr[2];
+
+    return scan_half_cycles;
+}
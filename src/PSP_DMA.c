@@ -0,0 +1,123 @@
+/*
+--|----------------------------------------------------------------------------|
+--| FILE DESCRIPTION:
+--|   PSP_DMA.c provides the implementation for the DMA1 controller.
+--|
+--|----------------------------------------------------------------------------|
+--| REFERENCES:
+--|   stm32f10x reference manual, page 273
+--|
+--|----------------------------------------------------------------------------|
+*/
+
+/*
+--|----------------------------------------------------------------------------|
+--| INCLUDE FILES
+--|----------------------------------------------------------------------------|
+*/
+
+#include "PSP_DMA.h"
+#include "PSP_RCC.h"
+
+/*
+--|----------------------------------------------------------------------------|
+--| PRIVATE DEFINES
+--|----------------------------------------------------------------------------|
+*/
+
+/*
+--| NAME: DMA_ISR_CHANNEL_FLAGS
+--| DESCRIPTION: all of the flags for one channel, at the channel 1 position
+--| TYPE: unsigned integer
+*/
+#define DMA_ISR_CHANNEL_FLAGS (FOUR_BIT_MASK)
+
+/*
+--|----------------------------------------------------------------------------|
+--| PRIVATE TYPES
+--|----------------------------------------------------------------------------|
+*/
+
+/* None */
+
+/*
+--|----------------------------------------------------------------------------|
+--| PRIVATE CONSTANTS
+--|----------------------------------------------------------------------------|
+*/
+
+/* None */
+
+/*
+--|----------------------------------------------------------------------------|
+--| PRIVATE VARIABLES
+--|----------------------------------------------------------------------------|
+*/
+
+/* None */
+
+/*
+--|----------------------------------------------------------------------------|
+--| PRIVATE HELPER FUNCTION PROTOTYPES
+--|----------------------------------------------------------------------------|
+*/
+
+/* None */
+
+/*
+--|----------------------------------------------------------------------------|
+--| PUBLIC FUNCTION DEFINITIONS
+--|----------------------------------------------------------------------------|
+*/
+
+void DMA_Channel_Init(DMA_Channel_enum channel, DMA_Channel_Initialization_Data_t * p_init_data)
+{
+    volatile DMA_Channel_t * p_channel = &DMA1->CHANNEL[channel];
+
+    RCC->AHBENR |= RCC_AHBENR_DMA1EN_FLAG;
+
+    // the channel registers can only be written while it is disabled
+    p_channel->CCR &= ~DMA_CCR_EN_FLAG;
+
+    DMA_Channel_Clear_Flags(channel, DMA_ISR_CHANNEL_FLAGS);
+
+    p_channel->CPAR  = (uint32_t)(uintptr_t)p_init_data->p_peripheral;
+    p_channel->CMAR  = (uint32_t)(uintptr_t)p_init_data->p_memory;
+    p_channel->CNDTR = p_init_data->num_transfers;
+
+    p_channel->CCR = (p_init_data->ccr_flags & ~DMA_CCR_EN_FLAG)               |
+                     (p_init_data->priority << DMA_CCR_PL_SHIFT_AMT)           |
+                     (p_init_data->transfer_size << DMA_CCR_MSIZE_SHIFT_AMT)   |
+                     (p_init_data->transfer_size << DMA_CCR_PSIZE_SHIFT_AMT);
+
+    p_channel->CCR |= DMA_CCR_EN_FLAG;
+}
+
+void DMA_Channel_Disable(DMA_Channel_enum channel)
+{
+    DMA1->CHANNEL[channel].CCR &= ~DMA_CCR_EN_FLAG;
+}
+
+uint32_t DMA_Channel_Get_Remaining(DMA_Channel_enum channel)
+{
+    return DMA1->CHANNEL[channel].CNDTR;
+}
+
+uint32_t DMA_Channel_Get_Flags(DMA_Channel_enum channel)
+{
+    return (DMA1->ISR >> (channel * DMA_ISR_CHANNEL_WIDTH)) & DMA_ISR_CHANNEL_FLAGS;
+}
+
+void DMA_Channel_Clear_Flags(DMA_Channel_enum channel, uint32_t flags)
+{
+    // IFCR is write 1 to clear, so no read-modify-write is needed
+    DMA1->IFCR = (flags & DMA_ISR_CHANNEL_FLAGS) << (channel * DMA_ISR_CHANNEL_WIDTH);
+}
+
+/*
+--|----------------------------------------------------------------------------|
+--| PRIVATE HELPER FUNCTION DEFINITIONS
+--|----------------------------------------------------------------------------|
+*/
+
+/* None */
@@ -0,0 +1,249 @@
+/*
+--|----------------------------------------------------------------------------|
+--| FILE DESCRIPTION:
+--|   PSP_DWT.c provides the implementation for the high resolution cycle
+--|   counter timebase.
+--|
+--|----------------------------------------------------------------------------|
+--| REFERENCES:
+--|   cortex_m3 technical reference manual, chapter 11 (DWT)
+--|   PM0056 programming manual, page 150 (SysTick fallback)
+--|
+--|----------------------------------------------------------------------------|
+*/
+
+/*
+--|----------------------------------------------------------------------------|
+--| INCLUDE FILES
+--|----------------------------------------------------------------------------|
+*/
+
+#include "PSP_DWT.h"
+#include "PSP_SysTick.h"
+#include "PSP_System_Clock_Init.h"
+
+/*
+--|----------------------------------------------------------------------------|
+--| PRIVATE DEFINES
+--|----------------------------------------------------------------------------|
+*/
+
+/*
+--| NAME: DWT_CYCLES_PER_USEC
+--| DESCRIPTION: the number of core clock cycles in one microsecond
+--| TYPE: unsigned integer
+*/
+#define DWT_CYCLES_PER_USEC (SYSTEM_CLOCK_SPEED / 1000000u)
+
+/*
+--|----------------------------------------------------------------------------|
+--| PRIVATE TYPES
+--|----------------------------------------------------------------------------|
+*/
+
+/* None */
+
+/*
+--|----------------------------------------------------------------------------|
+--| PRIVATE CONSTANTS
+--|----------------------------------------------------------------------------|
+*/
+
+_Static_assert((SYSTEM_CLOCK_SPEED % 1000000u) == 0u,
+               "the core clock must be a whole number of MHz for microsecond conversion");
+
+/*
+--|----------------------------------------------------------------------------|
+--| PRIVATE VARIABLES
+--|----------------------------------------------------------------------------|
+*/
+
+/*
+--| NAME: cycle_counter_available
+--| DESCRIPTION: true if the core implements the DWT cycle counter
+--| TYPE: bool
+*/
+static bool cycle_counter_available = false;
+
+/*
+--| NAME: cycle_count_high_word
+--| DESCRIPTION: the upper 32 bits of the extended cycle counter
+--| TYPE: uint32_t
+*/
+static volatile uint32_t cycle_count_high_word = 0u;
+
+/*
+--| NAME: cycle_count_last_sample
+--| DESCRIPTION: the hardware cycle counter at the last update
+--| TYPE: uint32_t
+*/
+static volatile uint32_t cycle_count_last_sample = 0u;
+
+/*
+--|----------------------------------------------------------------------------|
+--| PRIVATE HELPER FUNCTION PROTOTYPES
+--|----------------------------------------------------------------------------|
+*/
+
+/* None */
+
+/*
+--|----------------------------------------------------------------------------|
+--| PUBLIC FUNCTION DEFINITIONS
+--|----------------------------------------------------------------------------|
+*/
+
+void DWT_Init(void)
+{
+    // the DWT is only accessible once trace is enabled
+    DCB->DEMCR |= DCB_DEMCR_TRCENA_FLAG;
+
+    cycle_counter_available = !(DWT->CTRL & DWT_CTRL_NOCYCCNT_FLAG);
+
+    if (cycle_counter_available)
+    {
+        DWT->CYCCNT = 0u;
+        DWT->CTRL |= DWT_CTRL_CYCCNTENA_FLAG;
+    }
+
+    cycle_count_high_word   = 0u;
+    cycle_count_last_sample = 0u;
+}
+
+uint64_t DWT_Get_Cycles(void)
+{
+    if (!cycle_counter_available)
+    {
+        return SysTick_Get_Cycles_64();
+    }
+
+    uint32_t high_word;
+    uint32_t last_sample;
+    uint32_t now;
+
+    /*
+    The SysTick interrupt may update the high word and last sample at any
+    time. If the high word changed while reading, the pair may be torn, so
+    try again. The sample is never more than one SysTick period old, so the
+    difference from it can not wrap.
+    */
+    do
+    {
+        high_word   = cycle_count_high_word;
+        last_sample = cycle_count_last_sample;
+        now         = DWT->CYCCNT;
+    } while (high_word != cycle_count_high_word);
+
+    return (((uint64_t)high_word << 32u) | last_sample) + (uint32_t)(now - last_sample);
+}
+
+uint64_t DWT_Get_uSec(void)
+{
+    return DWT_Get_Cycles() / DWT_CYCLES_PER_USEC;
+}
+
+void DWT_Delay_Cycles(uint32_t cycles)
+{
+    if (cycle_counter_available)
+    {
+        const uint32_t start_cycles = DWT->CYCCNT;
+
+        while ((DWT->CYCCNT - start_cycles) < cycles)
+        {
+            // wait
+        }
+    }
+    else
+    {
+        const uint64_t start_cycles = SysTick_Get_Cycles_64();
+
+        while ((SysTick_Get_Cycles_64() - start_cycles) < cycles)
+        {
+            // wait
+        }
+    }
+}
+
+void DWT_Delay_uSec(uint32_t uSec)
+{
+    if (uSec <= (UINT32_MAX / DWT_CYCLES_PER_USEC))
+    {
+        DWT_Delay_Cycles(uSec * DWT_CYCLES_PER_USEC);
+    }
+    else
+    {
+        const uint64_t start_cycles = DWT_Get_Cycles();
+        const uint64_t cycles = (uint64_t)uSec * DWT_CYCLES_PER_USEC;
+
+        while ((DWT_Get_Cycles() - start_cycles) < cycles)
+        {
+            // wait
+        }
+    }
+}
+
+void DWT_Start_Stopwatch(DWT_Stopwatch_t * p_stopwatch)
+{
+    p_stopwatch->start_cycles = DWT_Get_Cycles();
+}
+
+uint64_t DWT_Get_Elapsed_Cycles(DWT_Stopwatch_t * p_stopwatch)
+{
+    return DWT_Get_Cycles() - p_stopwatch->start_cycles;
+}
+
+uint64_t DWT_Get_Elapsed_uSec(DWT_Stopwatch_t * p_stopwatch)
+{
+    return DWT_Get_Elapsed_Cycles(p_stopwatch) / DWT_CYCLES_PER_USEC;
+}
+
+bool DWT_Check_Cycle_Budget(DWT_Cycle_Budget_t * p_budget, DWT_Stopwatch_t * p_stopwatch)
+{
+    const uint64_t elapsed = DWT_Get_Elapsed_Cycles(p_stopwatch);
+    const uint32_t cycles  = (elapsed > UINT32_MAX) ? UINT32_MAX : (uint32_t)elapsed;
+
+    if (cycles > p_budget->worst_cycles)
+    {
+        p_budget->worst_cycles = cycles;
+    }
+
+    if (cycles > p_budget->budget_cycles)
+    {
+        p_budget->overruns++;
+        return false;
+    }
+
+    return true;
+}
+
+void DWT_Cycle_Counter_Update(void)
+{
+    if (cycle_counter_available)
+    {
+        const uint32_t now = DWT->CYCCNT;
+
+        if (now < cycle_count_last_sample)
+        {
+            cycle_count_high_word++;
+        }
+
+        cycle_count_last_sample = now;
+    }
+}
+
+void DWT_Cycle_Counter_Add(uint32_t cycles)
+{
+    if (cycle_counter_available)
+    {
+        // a wrap caused by this is counted by the next DWT_Cycle_Counter_Update
+        DWT->CYCCNT += cycles;
+    }
+}
+
+/*
+--|----------------------------------------------------------------------------|
+--| PRIVATE HELPER FUNCTION DEFINITIONS
+--|----------------------------------------------------------------------------|
+*/
+
+/* None */
@@ -0,0 +1,498 @@
+/*
+--|----------------------------------------------------------------------------|
+--| FILE DESCRIPTION:
+--|   PSP_Memory_Pool.c provides the implementation for the fixed block
+--|   memory pools.
+--|
+--|   Every block of a pool is the same size, so allocation never
+--|   fragments the pool and takes a bounded time. The free list and the
+--|   bitmap words are updated with LDREX/STREX. Exception entry and return
+--|   clear the exclusive monitor, so an interrupt which touches the same
+--|   pool in the middle of an update makes the interrupted update retry,
+--|   and no interrupt masking is needed.
+--|
+--|----------------------------------------------------------------------------|
+--| REFERENCES:
+--|   PM0056 programming manual, page 40 (synchronization primitives)
+--|
+--|----------------------------------------------------------------------------|
+*/
+
+/*
+--|----------------------------------------------------------------------------|
+--| INCLUDE FILES
+--|----------------------------------------------------------------------------|
+*/
+
+#include <stddef.h>
+
+#include "PSP_Core_Instructions.h"
+#include "PSP_Memory_Pool.h"
+
+/*
+--|----------------------------------------------------------------------------|
+--| PRIVATE DEFINES
+--|----------------------------------------------------------------------------|
+*/
+
+/*
+--| NAME: MEMORY_POOL_BITS_PER_WORD
+--| DESCRIPTION: the number of blocks tracked by one bitmap word
+--| TYPE: unsigned integer
+*/
+#define MEMORY_POOL_BITS_PER_WORD (32u)
+
+/*
+--| NAME: MEMORY_POOL_ALL_ALLOCATED
+--| DESCRIPTION: a bitmap word with every block allocated
+--| TYPE: unsigned integer
+*/
+#define MEMORY_POOL_ALL_ALLOCATED (0xFFFFFFFFu)
+
+/*
+--|----------------------------------------------------------------------------|
+--| PRIVATE TYPES
+--|----------------------------------------------------------------------------|
+*/
+
+/* None */
+
+/*
+--|----------------------------------------------------------------------------|
+--| PRIVATE CONSTANTS
+--|----------------------------------------------------------------------------|
+*/
+
+/* None */
+
+/*
+--|----------------------------------------------------------------------------|
+--| PRIVATE VARIABLES
+--|----------------------------------------------------------------------------|
+*/
+
+/*
+--| NAME: _smemory_pool, _ememory_pool
+--| DESCRIPTION: the memory pool region, from the linker script
+--| TYPE: uint8_t[]
+*/
+extern uint8_t _smemory_pool[];
+extern uint8_t _ememory_pool[];
+
+/*
+--| NAME: p_region_next
+--| DESCRIPTION: the start of the part of the region not yet given to a pool
+--| TYPE: uint8_t*
+*/
+static uint8_t * p_region_next = _smemory_pool;
+
+/*
+--|----------------------------------------------------------------------------|
+--| PRIVATE HELPER FUNCTION PROTOTYPES
+--|----------------------------------------------------------------------------|
+*/
+
+/*------------------------------------------------------------------------------
+Function Name:
+    Memory_Pool_Take
+
+Function Description:
+    Take a free block from a pool and count it in the usage statistics.
+
+Parameters:
+    p_pool: pointer to the pool.
+
+Returns:
+    void *: the block, or NULL if the pool is empty.
+
+Assumptions/Limitations:
+    Does not count a failed allocation.
+------------------------------------------------------------------------------*/
+static void * Memory_Pool_Take(Memory_Pool_t * p_pool);
+
+/*------------------------------------------------------------------------------
+Function Name:
+    Memory_Pool_Bitmap_Take
+
+Function Description:
+    Find a clear bit in the bitmap of a pool and set it.
+
+Parameters:
+    p_pool: pointer to the pool.
+
+Returns:
+    void *: the block of the bit, or NULL if every bit is set.
+
+Assumptions/Limitations:
+    None
+------------------------------------------------------------------------------*/
+static void * Memory_Pool_Bitmap_Take(Memory_Pool_t * p_pool);
+
+/*------------------------------------------------------------------------------
+Function Name:
+    Memory_Pool_Get_Block_Index
+
+Function Description:
+    Find the index of a block within a pool, checking that the pointer is
+    inside the storage of the pool and on a block boundary.
+
+Parameters:
+    p_pool: pointer to the pool.
+    p_block: the block.
+    p_index: set to the index of the block, only if true is returned.
+
+Returns:
+    true if p_block is the start of a block of the pool, else false.
+
+Assumptions/Limitations:
+    None
+------------------------------------------------------------------------------*/
+static bool Memory_Pool_Get_Block_Index(Memory_Pool_t * p_pool, void * p_block, uint32_t * p_index);
+
+/*------------------------------------------------------------------------------
+Function Name:
+    Memory_Pool_Atomic_Add
+
+Function Description:
+    Add to a word, atomically with respect to interrupts.
+
+Parameters:
+    p_word: the word.
+    delta: the amount to add, wrapping, so UINT32_MAX subtracts 1.
+
+Returns:
+    uint32_t: the new value of the word.
+
+Assumptions/Limitations:
+    None
+------------------------------------------------------------------------------*/
+static uint32_t Memory_Pool_Atomic_Add(vuint32_t * p_word, uint32_t delta);
+
+/*------------------------------------------------------------------------------
+Function Name:
+    Memory_Pool_Atomic_Max
+
+Function Description:
+    Raise a word to a value if it is lower, atomically with respect to
+    interrupts.
+
+Parameters:
+    p_word: the word.
+    value: the value.
+
+Returns:
+    None
+
+Assumptions/Limitations:
+    None
+------------------------------------------------------------------------------*/
+static void Memory_Pool_Atomic_Max(vuint32_t * p_word, uint32_t value);
+
+/*
+--|----------------------------------------------------------------------------|
+--| PUBLIC FUNCTION DEFINITIONS
+--|----------------------------------------------------------------------------|
+*/
+
+bool Memory_Pool_Init(Memory_Pool_t * p_pool, Memory_Pool_Variant_enum variant, uint32_t block_size, uint32_t num_blocks)
+{
+    uint32_t region_free = (uint32_t)(_ememory_pool - p_region_next);
+    uint32_t num_words   = 0u;
+
+    block_size = (block_size + MEMORY_POOL_BLOCK_ALIGNMENT - 1u) & ~(MEMORY_POOL_BLOCK_ALIGNMENT - 1u);
+
+    if ((block_size == 0u) || (num_blocks == 0u) || (num_blocks > (region_free / block_size)))
+    {
+        return false;
+    }
+
+    if (variant == MEMORY_POOL_VARIANT_BITMAP)
+    {
+        num_words = (num_blocks + MEMORY_POOL_BITS_PER_WORD - 1u) / MEMORY_POOL_BITS_PER_WORD;
+    }
+
+    if (((block_size * num_blocks) + (num_words * sizeof(uint32_t))) > region_free)
+    {
+        return false;
+    }
+
+    p_pool->variant         = variant;
+    p_pool->block_size      = block_size;
+    p_pool->num_blocks      = num_blocks;
+    p_pool->p_bitmap        = (vuint32_t *)p_region_next;
+    p_pool->p_storage       = p_region_next + (num_words * sizeof(uint32_t));
+    p_pool->free_head       = 0u;
+    p_pool->in_use          = 0u;
+    p_pool->high_water_mark = 0u;
+    p_pool->failed_allocs   = 0u;
+
+    p_region_next = p_pool->p_storage + (block_size * num_blocks);
+
+    if (variant == MEMORY_POOL_VARIANT_BITMAP)
+    {
+        for (uint32_t word = 0u; word < num_words; ++word)
+        {
+            p_pool->p_bitmap[word] = 0u;
+        }
+
+        // the bits past the last block are marked allocated, so they are never handed out
+        if ((num_blocks % MEMORY_POOL_BITS_PER_WORD) != 0u)
+        {
+            p_pool->p_bitmap[num_words - 1u] = MEMORY_POOL_ALL_ALLOCATED << (num_blocks % MEMORY_POOL_BITS_PER_WORD);
+        }
+    }
+    else
+    {
+        // link the blocks from the last to the first, so they are handed out in address order
+        for (uint32_t block = num_blocks; block > 0u; --block)
+        {
+            uint32_t * p_block = (uint32_t *)(p_pool->p_storage + ((block - 1u) * block_size));
+
+            *p_block          = p_pool->free_head;
+            p_pool->free_head = (uint32_t)(uintptr_t)p_block;
+        }
+    }
+
+    return true;
+}
+
+void * Memory_Pool_Alloc(Memory_Pool_t * p_pool)
+{
+    void * p_block = Memory_Pool_Take(p_pool);
+
+    if (p_block == NULL)
+    {
+        (void)Memory_Pool_Atomic_Add(&p_pool->failed_allocs, 1u);
+    }
+
+    return p_block;
+}
+
+bool Memory_Pool_Free(Memory_Pool_t * p_pool, void * p_block)
+{
+    uint32_t index;
+
+    // for both variants, nothing is written unless p_block is a block of this pool:
+    // the free list variant links through the block itself, so a stray pointer
+    // would otherwise corrupt whatever it points at
+    if (!Memory_Pool_Get_Block_Index(p_pool, p_block, &index))
+    {
+        return false;
+    }
+
+    if (p_pool->variant == MEMORY_POOL_VARIANT_BITMAP)
+    {
+        vuint32_t * p_word = &p_pool->p_bitmap[index / MEMORY_POOL_BITS_PER_WORD];
+        uint32_t    mask   = 1u << (index % MEMORY_POOL_BITS_PER_WORD);
+        uint32_t    bits;
+
+        do
+        {
+            bits = Core_Load_Exclusive(p_word);
+
+            if ((bits & mask) == 0u)
+            {
+                Core_Clear_Exclusive();
+                return false;
+            }
+        } while (Core_Store_Exclusive(bits & ~mask, p_word) != 0u);
+    }
+    else
+    {
+        uint32_t * p_link = (uint32_t *)p_block;
+
+        do
+        {
+            *p_link = Core_Load_Exclusive(&p_pool->free_head);
+        } while (Core_Store_Exclusive((uint32_t)(uintptr_t)p_block, &p_pool->free_head) != 0u);
+    }
+
+    (void)Memory_Pool_Atomic_Add(&p_pool->in_use, UINT32_MAX);
+
+    return true;
+}
+
+void * Memory_Pool_Alloc_Size(Memory_Pool_t * const * pp_pools, uint32_t num_pools, uint32_t size)
+{
+    Memory_Pool_t * p_first_fit = NULL;
+
+    for (uint32_t pool = 0u; pool < num_pools; ++pool)
+    {
+        if (pp_pools[pool]->block_size >= size)
+        {
+            void * p_block = Memory_Pool_Take(pp_pools[pool]);
+
+            if (p_block != NULL)
+            {
+                return p_block;
+            }
+
+            if (p_first_fit == NULL)
+            {
+                p_first_fit = pp_pools[pool];
+            }
+        }
+    }
+
+    // the failure is counted against the size class which should have served it
+    if (p_first_fit != NULL)
+    {
+        (void)Memory_Pool_Atomic_Add(&p_first_fit->failed_allocs, 1u);
+    }
+
+    return NULL;
+}
+
+bool Memory_Pool_Free_Any(Memory_Pool_t * const * pp_pools, uint32_t num_pools, void * p_block)
+{
+    uint8_t * p_byte = (uint8_t *)p_block;
+
+    for (uint32_t pool = 0u; pool < num_pools; ++pool)
+    {
+        Memory_Pool_t * p_pool = pp_pools[pool];
+
+        if ((p_byte >= p_pool->p_storage) &&
+            (p_byte <  (p_pool->p_storage + (p_pool->block_size * p_pool->num_blocks))))
+        {
+            return Memory_Pool_Free(p_pool, p_block);
+        }
+    }
+
+    return false;
+}
+
+void Memory_Pool_Get_Stats(Memory_Pool_t * p_pool, Memory_Pool_Stats_t * p_stats)
+{
+    p_stats->block_size      = p_pool->block_size;
+    p_stats->num_blocks      = p_pool->num_blocks;
+    p_stats->in_use          = p_pool->in_use;
+    p_stats->high_water_mark = p_pool->high_water_mark;
+    p_stats->failed_allocs   = p_pool->failed_allocs;
+}
+
+uint32_t Memory_Pool_Get_Region_Free(void)
+{
+    return (uint32_t)(_ememory_pool - p_region_next);
+}
+
+/*
+--|----------------------------------------------------------------------------|
+--| PRIVATE HELPER FUNCTION DEFINITIONS
+--|----------------------------------------------------------------------------|
+*/
+
+static void * Memory_Pool_Take(Memory_Pool_t * p_pool)
+{
+    void * p_block = NULL;
+
+    if (p_pool->variant == MEMORY_POOL_VARIANT_BITMAP)
+    {
+        p_block = Memory_Pool_Bitmap_Take(p_pool);
+    }
+    else
+    {
+        uint32_t head;
+
+        do
+        {
+            head = Core_Load_Exclusive(&p_pool->free_head);
+
+            if (head == 0u)
+            {
+                Core_Clear_Exclusive();
+                break;
+            }
+        } while (Core_Store_Exclusive(*(uint32_t *)(uintptr_t)head, &p_pool->free_head) != 0u);
+
+        p_block = (void *)(uintptr_t)head;
+    }
+
+    if (p_block != NULL)
+    {
+        Memory_Pool_Atomic_Max(&p_pool->high_water_mark, Memory_Pool_Atomic_Add(&p_pool->in_use, 1u));
+    }
+
+    return p_block;
+}
+
+static void * Memory_Pool_Bitmap_Take(Memory_Pool_t * p_pool)
+{
+    uint32_t num_words = (p_pool->num_blocks + MEMORY_POOL_BITS_PER_WORD - 1u) / MEMORY_POOL_BITS_PER_WORD;
+
+    for (uint32_t word = 0u; word < num_words; ++word)
+    {
+        vuint32_t * p_word = &p_pool->p_bitmap[word];
+        uint32_t    bits;
+        uint32_t    bit = 0u;
+
+        do
+        {
+            bits = Core_Load_Exclusive(p_word);
+
+            if (bits == MEMORY_POOL_ALL_ALLOCATED)
+            {
+                Core_Clear_Exclusive();
+                break;
+            }
+
+            // the lowest clear bit, RBIT and CLZ on the Cortex-M3
+            bit = (uint32_t)__builtin_ctz(~bits);
+        } while (Core_Store_Exclusive(bits | (1u << bit), p_word) != 0u);
+
+        if (bits != MEMORY_POOL_ALL_ALLOCATED)
+        {
+            return p_pool->p_storage + (((word * MEMORY_POOL_BITS_PER_WORD) + bit) * p_pool->block_size);
+        }
+    }
+
+    return NULL;
+}
+
+static bool Memory_Pool_Get_Block_Index(Memory_Pool_t * p_pool, void * p_block, uint32_t * p_index)
+{
+    const uint8_t * p_byte = (const uint8_t *)p_block;
+    const uint8_t * p_end  = p_pool->p_storage + (p_pool->block_size * p_pool->num_blocks);
+    uint32_t        offset;
+
+    // range: within the storage of this pool
+    if ((p_block == NULL) || (p_byte < p_pool->p_storage) || (p_byte >= p_end))
+    {
+        return false;
+    }
+
+    offset = (uint32_t)(p_byte - p_pool->p_storage);
+
+    // alignment: at the start of a block, not inside one
+    if ((offset % p_pool->block_size) != 0u)
+    {
+        return false;
+    }
+
+    *p_index = offset / p_pool->block_size;
+
+    return true;
+}
+
+static uint32_t Memory_Pool_Atomic_Add(vuint32_t * p_word, uint32_t delta)
+{
+    uint32_t value;
+
+    do
+    {
+        value = Core_Load_Exclusive(p_word) + delta;
+    } while (Core_Store_Exclusive(value, p_word) != 0u);
+
+    return value;
+}
+
+static void Memory_Pool_Atomic_Max(vuint32_t * p_word, uint32_t value)
+{
+    do
+    {
+        if (Core_Load_Exclusive(p_word) >= value)
+        {
+            Core_Clear_Exclusive();
+            break;
+        }
+    } while (Core_Store_Exclusive(value, p_word) != 0u);
+}
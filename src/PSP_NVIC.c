@@ -0,0 +1,393 @@
+/*
+--|----------------------------------------------------------------------------|
+--| FILE DESCRIPTION:
+--|   PSP_NVIC.c provides the implementation for the Nested Vector Interrupt
+--|   Controller interface and the BASEPRI critical sections.
+--|  
+--|----------------------------------------------------------------------------|
+--| REFERENCES:
+--|   PM0056 programming manual, page 118 (NVIC), page 134 (AIRCR)
+--|
+--|----------------------------------------------------------------------------|
+*/
+
+/*
+--|----------------------------------------------------------------------------|
+--| INCLUDE FILES
+--|----------------------------------------------------------------------------|
+*/
+
+#include "Common_Attributes.h"
+#include "PSP_Core_Instructions.h"
+#include "PSP_NVIC.h"
+#include "PSP_SCB.h"
+
+/*
+--|----------------------------------------------------------------------------|
+--| PRIVATE DEFINES
+--|----------------------------------------------------------------------------|
+*/
+
+/*
+--| NAME: NVIC_PRIORITY_SHIFT_AMT
+--| DESCRIPTION: position of the implemented bits in an 8 bit priority register
+--| TYPE: unsigned integer
+*/
+#define NVIC_PRIORITY_SHIFT_AMT (8u - NVIC_PRIORITY_BITS)
+
+/*
+--| NAME: NVIC_IRQS_PER_REGISTER
+--| DESCRIPTION: the number of interrupts per enable/pending/active register
+--| TYPE: unsigned integer
+*/
+#define NVIC_IRQS_PER_REGISTER (32u)
+
+/*
+--| NAME: NVIC_MAX_PRIGROUP
+--| DESCRIPTION: the AIRCR PRIGROUP value with no preemption priority bits
+--| TYPE: unsigned integer
+*/
+#define NVIC_MAX_PRIGROUP (7u)
+
+/*
+--| NAME: NVIC_FIRST_SHPR_EXCEPTION
+--| DESCRIPTION: the exception number of the first byte of SHPR1, MemManage
+--| TYPE: unsigned integer
+*/
+#define NVIC_FIRST_SHPR_EXCEPTION (4u)
+
+/*
+--| NAME: NVIC_EXCEPTION_NUMBER_OFFSET
+--| DESCRIPTION: the exception number of IRQ 0, the offset from IRQn_t
+--| TYPE: integer
+*/
+#define NVIC_EXCEPTION_NUMBER_OFFSET (16)
+
+/*
+--| NAME: NVIC_VECTOR_TABLE_ALIGNMENT
+--| DESCRIPTION: VTOR requires the table to be aligned to its size rounded
+--|   up to a power of 2, 59 words rounds up to 256 bytes
+--| TYPE: unsigned integer
+*/
+#define NVIC_VECTOR_TABLE_ALIGNMENT (256u)
+
+/*
+--|----------------------------------------------------------------------------|
+--| PRIVATE TYPES
+--|----------------------------------------------------------------------------|
+*/
+
+/*
+--| NAME: NVIC_Dispatch_Entry_t
+--| DESCRIPTION: a handler and its context, for one device interrupt
+*/
+typedef struct NVIC_Dispatch_Entry_Type
+{
+    NVIC_Dispatch_Handler_t handler;   // called on the interrupt
+    void *                  p_context; // passed to the handler
+} NVIC_Dispatch_Entry_t;
+
+/*
+--|----------------------------------------------------------------------------|
+--| PRIVATE CONSTANTS
+--|----------------------------------------------------------------------------|
+*/
+
+// vector_table.S is checked against NVIC_NUM_VECTORS, this ties that count to IRQn_t
+_Static_assert((OTG_FS_WKUP_IRQn + 1) == (int)NVIC_NUM_IRQS, "NVIC_NUM_IRQS does not match IRQn_t");
+
+/*
+--|----------------------------------------------------------------------------|
+--| PRIVATE VARIABLES
+--|----------------------------------------------------------------------------|
+*/
+
+/*
+--| NAME: vtable
+--| DESCRIPTION: the vector table in flash, defined in vector_table.S
+--| TYPE: uint32_t[]
+*/
+extern const uint32_t vtable[NVIC_NUM_VECTORS];
+
+/*
+--| NAME: RAM_vector_table
+--| DESCRIPTION: the SRAM copy of the vector table
+--| TYPE: uint32_t[]
+*/
+static uint32_t RAM_vector_table[NVIC_NUM_VECTORS] __attribute__((aligned(NVIC_VECTOR_TABLE_ALIGNMENT)));
+
+/*
+--| NAME: dispatch_table
+--| DESCRIPTION: the handler and context attached to each device interrupt
+--| TYPE: NVIC_Dispatch_Entry_t[]
+*/
+static NVIC_Dispatch_Entry_t dispatch_table[NVIC_NUM_IRQS];
+
+/*
+--|----------------------------------------------------------------------------|
+--| PRIVATE HELPER FUNCTION PROTOTYPES
+--|----------------------------------------------------------------------------|
+*/
+
+/*------------------------------------------------------------------------------
+Function Name:
+    NVIC_Get_Priority_Register
+
+Function Description:
+    Get the 8 bit priority register of an interrupt or system exception.
+
+Parameters:
+    IRQn: the interrupt number, or a negative system exception number.
+
+Returns:
+    vuint8_t*: pointer to the priority register.
+
+Assumptions/Limitations:
+    System exceptions are in the SCB SHPR registers, which are byte
+    accessible like the NVIC IP registers.
+------------------------------------------------------------------------------*/
+static vuint8_t * NVIC_Get_Priority_Register(IRQn_t IRQn);
+
+/*------------------------------------------------------------------------------
+Function Name:
+    NVIC_Dispatch
+
+Function Description:
+    The vector of every attached interrupt. Reads the running exception
+    number from IPSR and calls the attached handler with its context, as a
+    tail call, so the only overhead is an IPSR read, two loads and an
+    indirect branch. Runs from RAM, so it adds no flash wait states.
+
+Parameters:
+    None
+
+Returns:
+    None
+
+Assumptions/Limitations:
+    Only runs as the handler of an attached device interrupt.
+------------------------------------------------------------------------------*/
+static RAMFUNC void NVIC_Dispatch(void);
+
+/*
+--|----------------------------------------------------------------------------|
+--| PUBLIC FUNCTION DEFINITIONS
+--|----------------------------------------------------------------------------|
+*/
+
+void NVIC_Enable_IRQ(IRQn_t IRQn)
+{
+    // the set-enable registers ignore 0 bits, so no read-modify-write
+    NVIC->ISER[(uint32_t)IRQn / NVIC_IRQS_PER_REGISTER] = 1u << ((uint32_t)IRQn % NVIC_IRQS_PER_REGISTER);
+}
+
+void NVIC_Disable_IRQ(IRQn_t IRQn)
+{
+    NVIC->ICER[(uint32_t)IRQn / NVIC_IRQS_PER_REGISTER] = 1u << ((uint32_t)IRQn % NVIC_IRQS_PER_REGISTER);
+
+    // make sure the write has reached the NVIC before returning
+    Core_Data_Sync_Barrier();
+    Core_Instruction_Sync_Barrier();
+}
+
+bool NVIC_Is_Enabled(IRQn_t IRQn)
+{
+    return ((NVIC->ISER[(uint32_t)IRQn / NVIC_IRQS_PER_REGISTER] >> ((uint32_t)IRQn % NVIC_IRQS_PER_REGISTER)) & 1u);
+}
+
+void NVIC_Set_Pending(IRQn_t IRQn)
+{
+    NVIC->ISPR[(uint32_t)IRQn / NVIC_IRQS_PER_REGISTER] = 1u << ((uint32_t)IRQn % NVIC_IRQS_PER_REGISTER);
+}
+
+void NVIC_Clear_Pending(IRQn_t IRQn)
+{
+    NVIC->ICPR[(uint32_t)IRQn / NVIC_IRQS_PER_REGISTER] = 1u << ((uint32_t)IRQn % NVIC_IRQS_PER_REGISTER);
+}
+
+bool NVIC_Is_Pending(IRQn_t IRQn)
+{
+    return ((NVIC->ISPR[(uint32_t)IRQn / NVIC_IRQS_PER_REGISTER] >> ((uint32_t)IRQn % NVIC_IRQS_PER_REGISTER)) & 1u);
+}
+
+bool NVIC_Is_Active(IRQn_t IRQn)
+{
+    return ((NVIC->IABR[(uint32_t)IRQn / NVIC_IRQS_PER_REGISTER] >> ((uint32_t)IRQn % NVIC_IRQS_PER_REGISTER)) & 1u);
+}
+
+void NVIC_Set_Priority(IRQn_t IRQn, uint32_t priority)
+{
+    *NVIC_Get_Priority_Register(IRQn) = (uint8_t)((priority & NVIC_LOWEST_PRIORITY) << NVIC_PRIORITY_SHIFT_AMT);
+}
+
+uint32_t NVIC_Get_Priority(IRQn_t IRQn)
+{
+    return (uint32_t)*NVIC_Get_Priority_Register(IRQn) >> NVIC_PRIORITY_SHIFT_AMT;
+}
+
+void NVIC_Set_Priority_Grouping(uint32_t preempt_bits)
+{
+    if (preempt_bits > NVIC_PRIORITY_BITS)
+    {
+        preempt_bits = NVIC_PRIORITY_BITS;
+    }
+
+    // PRIGROUP is the position of the highest subpriority bit in the 8 bit
+    // priority, so fewer preemption bits is a larger value
+    const uint32_t prigroup = NVIC_MAX_PRIGROUP - preempt_bits;
+
+    uint32_t aircr = SCB->AIRCR;
+
+    // the key reads back as its complement, so always write it
+    aircr &= ~((SCB_AIRCR_VECTKEY_MASK << SCB_AIRCR_VECTKEY_SHIFT_AMT) | 
+               (SCB_AIRCR_PRIGROUP_MASK << SCB_AIRCR_PRIGROUP_SHIFT_AMT));
+    aircr |= (SCB_AIRCR_VECTKEY << SCB_AIRCR_VECTKEY_SHIFT_AMT) | 
+             (prigroup << SCB_AIRCR_PRIGROUP_SHIFT_AMT);
+
+    SCB->AIRCR = aircr;
+}
+
+uint32_t NVIC_Get_Priority_Grouping(void)
+{
+    const uint32_t prigroup = (SCB->AIRCR >> SCB_AIRCR_PRIGROUP_SHIFT_AMT) & SCB_AIRCR_PRIGROUP_MASK;
+    const uint32_t preempt_bits = NVIC_MAX_PRIGROUP - prigroup;
+
+    // values below 3 still split the unimplemented bits, all 4 are preemption
+    return (preempt_bits > NVIC_PRIORITY_BITS) ? NVIC_PRIORITY_BITS : preempt_bits;
+}
+
+uint32_t NVIC_Encode_Priority(uint32_t preempt_priority, uint32_t sub_priority)
+{
+    const uint32_t preempt_bits = NVIC_Get_Priority_Grouping();
+    const uint32_t sub_bits = NVIC_PRIORITY_BITS - preempt_bits;
+
+    return ((preempt_priority & ((1u << preempt_bits) - 1u)) << sub_bits) | 
+           (sub_priority & ((1u << sub_bits) - 1u));
+}
+
+uint32_t NVIC_Critical_Section_Enter(uint32_t mask_priority)
+{
+    const uint32_t previous_mask = Core_Get_BASEPRI();
+
+    Core_Raise_BASEPRI((mask_priority & NVIC_LOWEST_PRIORITY) << NVIC_PRIORITY_SHIFT_AMT);
+
+    return previous_mask;
+}
+
+void NVIC_Critical_Section_Exit(uint32_t previous_mask)
+{
+    Core_Set_BASEPRI(previous_mask);
+}
+
+void NVIC_Relocate_Vector_Table(void)
+{
+    const uint32_t primask = Core_Get_PRIMASK();
+
+    // no exception may be taken while the table is half copied
+    Core_Disable_Interrupts();
+
+    for (uint32_t i = 0u; i < NVIC_NUM_VECTORS; i++)
+    {
+        RAM_vector_table[i] = vtable[i];
+    }
+
+    // the copy must be complete before the core fetches from it
+    Core_Data_Sync_Barrier();
+
+    SCB->VTOR = (uint32_t)(uintptr_t)RAM_vector_table;
+
+    Core_Data_Sync_Barrier();
+    Core_Instruction_Sync_Barrier();
+
+    Core_Set_PRIMASK(primask);
+}
+
+bool NVIC_Set_Vector(IRQn_t IRQn, NVIC_Handler_t handler)
+{
+    if ((IRQn < NMI_IRQn) || (IRQn >= (IRQn_t)NVIC_NUM_IRQS))
+    {
+        return false;
+    }
+
+    if (SCB->VTOR != (uint32_t)(uintptr_t)RAM_vector_table)
+    {
+        return false;
+    }
+
+    RAM_vector_table[(int32_t)IRQn + NVIC_EXCEPTION_NUMBER_OFFSET] = (uint32_t)(uintptr_t)handler;
+
+    // make sure the next exception entry sees the new handler
+    Core_Data_Sync_Barrier();
+
+    return true;
+}
+
+NVIC_Handler_t NVIC_Get_Vector(IRQn_t IRQn)
+{
+    const uint32_t * p_table = (const uint32_t *)(uintptr_t)SCB->VTOR;
+
+    // VTOR is 0 at reset, where flash is aliased, so read the flash table
+    if (p_table != RAM_vector_table)
+    {
+        p_table = vtable;
+    }
+
+    return (NVIC_Handler_t)(uintptr_t)p_table[(int32_t)IRQn + NVIC_EXCEPTION_NUMBER_OFFSET];
+}
+
+bool NVIC_Attach_IRQ(IRQn_t IRQn, NVIC_Dispatch_Handler_t handler, void * p_context)
+{
+    if ((IRQn < 0) || (IRQn >= (IRQn_t)NVIC_NUM_IRQS))
+    {
+        return false;
+    }
+
+    // check before writing the entry, so that a false return changes nothing
+    if (SCB->VTOR != (uint32_t)(uintptr_t)RAM_vector_table)
+    {
+        return false;
+    }
+
+    dispatch_table[IRQn].handler   = handler;
+    dispatch_table[IRQn].p_context = p_context;
+
+    // the entry must be written before the vector can point at the dispatcher
+    Core_Data_Sync_Barrier();
+
+    return NVIC_Set_Vector(IRQn, NVIC_Dispatch);
+}
+
+void NVIC_Detach_IRQ(IRQn_t IRQn)
+{
+    if ((IRQn < 0) || (IRQn >= (IRQn_t)NVIC_NUM_IRQS))
+    {
+        return;
+    }
+
+    (void)NVIC_Set_Vector(IRQn, (NVIC_Handler_t)(uintptr_t)vtable[(int32_t)IRQn + NVIC_EXCEPTION_NUMBER_OFFSET]);
+}
+
+/*
+--|----------------------------------------------------------------------------|
+--| PRIVATE HELPER FUNCTION DEFINITIONS
+--|----------------------------------------------------------------------------|
+*/
+
+static RAMFUNC void NVIC_Dispatch(void)
+{
+    const NVIC_Dispatch_Entry_t * p_entry = &dispatch_table[Core_Get_IPSR() - NVIC_EXCEPTION_NUMBER_OFFSET];
+
+    p_entry->handler(p_entry->p_context);
+}
+
+static vuint8_t * NVIC_Get_Priority_Register(IRQn_t IRQn)
+{
+    if (IRQn < 0)
+    {
+        const uint32_t exception_number = (uint32_t)(IRQn + NVIC_EXCEPTION_NUMBER_OFFSET);
+
+        return &((vuint8_t *)&SCB->SHPR1)[exception_number - NVIC_FIRST_SHPR_EXCEPTION];
+    }
+
+    return &NVIC->IP[IRQn];
+}
@@ -0,0 +1,257 @@
+/*
+--|----------------------------------------------------------------------------|
+--| FILE DESCRIPTION:
+--|   PSP_Ring_Buffer.c provides the implementation for the single producer,
+--|   single consumer byte ring buffer.
+--|
+--|   The head is only written by the producer and the tail only by the
+--|   consumer, and both are single aligned words, so every load and store
+--|   of them is atomic and neither side needs a critical section or an
+--|   exclusive access. A data memory barrier orders the bytes against the
+--|   index which publishes them.
+--|
+--|----------------------------------------------------------------------------|
+--| REFERENCES:
+--|   PM0056 programming manual, page 38 (memory barriers)
+--|
+--|----------------------------------------------------------------------------|
+*/
+
+/*
+--|----------------------------------------------------------------------------|
+--| INCLUDE FILES
+--|----------------------------------------------------------------------------|
+*/
+
+#include "PSP_Core_Instructions.h"
+#include "PSP_Ring_Buffer.h"
+
+/*
+--|----------------------------------------------------------------------------|
+--| PRIVATE DEFINES
+--|----------------------------------------------------------------------------|
+*/
+
+/* None */
+
+/*
+--|----------------------------------------------------------------------------|
+--| PRIVATE TYPES
+--|----------------------------------------------------------------------------|
+*/
+
+/* None */
+
+/*
+--|----------------------------------------------------------------------------|
+--| PRIVATE CONSTANTS
+--|----------------------------------------------------------------------------|
+*/
+
+/* None */
+
+/*
+--|----------------------------------------------------------------------------|
+--| PRIVATE VARIABLES
+--|----------------------------------------------------------------------------|
+*/
+
+/* None */
+
+/*
+--|----------------------------------------------------------------------------|
+--| PRIVATE HELPER FUNCTION PROTOTYPES
+--|----------------------------------------------------------------------------|
+*/
+
+/*------------------------------------------------------------------------------
+Function Name:
+    Ring_Buffer_Copy
+
+Function Description:
+    Copy bytes between non-overlapping buffers.
+
+Parameters:
+    p_destination: the bytes to write.
+    p_source: the bytes to read.
+    length: the number of bytes.
+
+Returns:
+    None
+
+Assumptions/Limitations:
+    Stands in for memcpy, which is not available with -nostdlib.
+------------------------------------------------------------------------------*/
+static void Ring_Buffer_Copy(uint8_t * p_destination, const uint8_t * p_source, uint32_t length);
+
+/*
+--|----------------------------------------------------------------------------|
+--| PUBLIC FUNCTION DEFINITIONS
+--|----------------------------------------------------------------------------|
+*/
+
+bool Ring_Buffer_Init(Ring_Buffer_t * p_ring, uint8_t * p_buffer, uint32_t size)
+{
+    if ((size == 0u) || ((size & (size - 1u)) != 0u))
+    {
+        return false;
+    }
+
+    p_ring->p_buffer = p_buffer;
+    p_ring->mask     = size - 1u;
+    p_ring->head     = 0u;
+    p_ring->tail     = 0u;
+
+    return true;
+}
+
+uint32_t Ring_Buffer_Get_Count(Ring_Buffer_t * p_ring)
+{
+    // the counts are free running, so the difference is right across wrap around
+    return p_ring->head - p_ring->tail;
+}
+
+uint32_t Ring_Buffer_Get_Free(Ring_Buffer_t * p_ring)
+{
+    return (p_ring->mask + 1u) - (p_ring->head - p_ring->tail);
+}
+
+bool Ring_Buffer_Put(Ring_Buffer_t * p_ring, uint8_t data)
+{
+    const uint32_t head = p_ring->head;
+
+    if ((head - p_ring->tail) > p_ring->mask)
+    {
+        return false;
+    }
+
+    p_ring->p_buffer[head & p_ring->mask] = data;
+
+    // the byte must be in the buffer before the consumer can see it
+    Core_Data_Memory_Barrier();
+    p_ring->head = head + 1u;
+
+    return true;
+}
+
+bool Ring_Buffer_Get(Ring_Buffer_t * p_ring, uint8_t * p_data)
+{
+    const uint32_t tail = p_ring->tail;
+
+    if (tail == p_ring->head)
+    {
+        return false;
+    }
+
+    // the byte must not be read before the head which published it
+    Core_Data_Memory_Barrier();
+    *p_data = p_ring->p_buffer[tail & p_ring->mask];
+
+    // and must be read before the producer can overwrite it
+    Core_Data_Memory_Barrier();
+    p_ring->tail = tail + 1u;
+
+    return true;
+}
+
+uint32_t Ring_Buffer_Write(Ring_Buffer_t * p_ring, const uint8_t * p_data, uint32_t length)
+{
+    uint32_t  span_length;
+    uint32_t  written = 0u;
+    uint8_t * p_span  = Ring_Buffer_Get_Write_Span(p_ring, &span_length);
+
+    // at most two spans, the one up to the end of the storage and the one from its start
+    while ((written < length) && (span_length != 0u))
+    {
+        if (span_length > (length - written))
+        {
+            span_length = length - written;
+        }
+
+        Ring_Buffer_Copy(p_span, &p_data[written], span_length);
+        Ring_Buffer_Commit_Write(p_ring, span_length);
+        written += span_length;
+
+        p_span = Ring_Buffer_Get_Write_Span(p_ring, &span_length);
+    }
+
+    return written;
+}
+
+uint32_t Ring_Buffer_Read(Ring_Buffer_t * p_ring, uint8_t * p_data, uint32_t max_length)
+{
+    uint32_t        span_length;
+    uint32_t        read   = 0u;
+    const uint8_t * p_span = Ring_Buffer_Get_Read_Span(p_ring, &span_length);
+
+    while ((read < max_length) && (span_length != 0u))
+    {
+        if (span_length > (max_length - read))
+        {
+            span_length = max_length - read;
+        }
+
+        Ring_Buffer_Copy(&p_data[read], p_span, span_length);
+        Ring_Buffer_Commit_Read(p_ring, span_length);
+        read += span_length;
+
+        p_span = Ring_Buffer_Get_Read_Span(p_ring, &span_length);
+    }
+
+    return read;
+}
+
+uint8_t * Ring_Buffer_Get_Write_Span(Ring_Buffer_t * p_ring, uint32_t * p_length)
+{
+    const uint32_t head       = p_ring->head;
+    const uint32_t index      = head & p_ring->mask;
+    const uint32_t free       = (p_ring->mask + 1u) - (head - p_ring->tail);
+    const uint32_t to_the_end = (p_ring->mask + 1u) - index;
+
+    *p_length = (free < to_the_end) ? free : to_the_end;
+
+    return &p_ring->p_buffer[index];
+}
+
+void Ring_Buffer_Commit_Write(Ring_Buffer_t * p_ring, uint32_t length)
+{
+    Core_Data_Memory_Barrier();
+    p_ring->head += length;
+}
+
+const uint8_t * Ring_Buffer_Get_Read_Span(Ring_Buffer_t * p_ring, uint32_t * p_length)
+{
+    const uint32_t tail       = p_ring->tail;
+    const uint32_t index      = tail & p_ring->mask;
+    const uint32_t count      = p_ring->head - tail;
+    const uint32_t to_the_end = (p_ring->mask + 1u) - index;
+
+    *p_length = (count < to_the_end) ? count : to_the_end;
+
+    // the span must not be read before the head which published it
+    Core_Data_Memory_Barrier();
+
+    return &p_ring->p_buffer[index];
+}
+
+void Ring_Buffer_Commit_Read(Ring_Buffer_t * p_ring, uint32_t length)
+{
+    Core_Data_Memory_Barrier();
+    p_ring->tail += length;
+}
+
+/*
+--|----------------------------------------------------------------------------|
+--| PRIVATE HELPER FUNCTION DEFINITIONS
+--|----------------------------------------------------------------------------|
+*/
+
+static void Ring_Buffer_Copy(uint8_t * p_destination, const uint8_t * p_source, uint32_t length)
+{
+    uint32_t i;
+
+    for (i = 0u; i < length; i++)
+    {
+        p_destination[i] = p_source[i];
+    }
+}
@@ -0,0 +1,133 @@
+/*
+--|----------------------------------------------------------------------------|
+--| FILE DESCRIPTION:
+--|   PSP_Stack.c provides the implementation for measuring the main stack
+--|   and checking it for overflow.
+--|
+--|----------------------------------------------------------------------------|
+--| REFERENCES:
+--|   None.
+--|
+--|----------------------------------------------------------------------------|
+*/
+
+/*
+--|----------------------------------------------------------------------------|
+--| INCLUDE FILES
+--|----------------------------------------------------------------------------|
+*/
+
+#include "Common_Attributes.h"
+#include "PSP_Core_Instructions.h"
+#include "PSP_Stack.h"
+
+/*
+--|----------------------------------------------------------------------------|
+--| PRIVATE DEFINES
+--|----------------------------------------------------------------------------|
+*/
+
+/* None */
+
+/*
+--|----------------------------------------------------------------------------|
+--| PRIVATE TYPES
+--|----------------------------------------------------------------------------|
+*/
+
+/* None */
+
+/*
+--|----------------------------------------------------------------------------|
+--| PRIVATE CONSTANTS
+--|----------------------------------------------------------------------------|
+*/
+
+/* None */
+
+/*
+--|----------------------------------------------------------------------------|
+--| PRIVATE VARIABLES
+--|----------------------------------------------------------------------------|
+*/
+
+/*
+--| NAME: _sstack_limit, _estack
+--| DESCRIPTION: the bottom and top of the stack, from the linker script
+--| TYPE: uint32_t[]
+*/
+extern uint32_t _sstack_limit[];
+extern uint32_t _estack[];
+
+/*
+--| NAME: _stack_guard_size
+--| DESCRIPTION: the size of the guard region in bytes, from the linker
+--|   script, given by the address of the symbol
+--| TYPE: uint8_t[]
+*/
+extern uint8_t _stack_guard_size[];
+
+/*
+--|----------------------------------------------------------------------------|
+--| PRIVATE HELPER FUNCTION PROTOTYPES
+--|----------------------------------------------------------------------------|
+*/
+
+/* None */
+
+/*
+--|----------------------------------------------------------------------------|
+--| PUBLIC FUNCTION DEFINITIONS
+--|----------------------------------------------------------------------------|
+*/
+
+uint32_t Stack_Get_Size(void)
+{
+    return (uint32_t)((uintptr_t)_estack - (uintptr_t)_sstack_limit);
+}
+
+uint32_t Stack_Get_High_Water_Mark(void)
+{
+    const vuint32_t * p_word = _sstack_limit;
+
+    while ((p_word < _estack) && (*p_word == STACK_PAINT_PATTERN))
+    {
+        ++p_word;
+    }
+
+    return (uint32_t)((uintptr_t)_estack - (uintptr_t)p_word);
+}
+
+bool Stack_Is_Guard_Intact(void)
+{
+    const vuint32_t * p_word = _sstack_limit;
+    const vuint32_t * p_end  = _sstack_limit + ((uintptr_t)_stack_guard_size / sizeof(uint32_t));
+
+    for (; p_word < p_end; ++p_word)
+    {
+        if (*p_word != STACK_PAINT_PATTERN)
+        {
+            return false;
+        }
+    }
+
+    return true;
+}
+
+WEAK void Stack_Overflow_Handler(void)
+{
+    Core_Disable_Interrupts();
+
+    for (;;)
+    {
+        __asm volatile ("bkpt #0");
+    }
+}
+
+/*
+--|----------------------------------------------------------------------------|
+--| PRIVATE HELPER FUNCTION DEFINITIONS
+--|----------------------------------------------------------------------------|
+*/
+
+/* None */
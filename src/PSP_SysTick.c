@@ -17,7 +17,12 @@
 --|----------------------------------------------------------------------------|
 */
 
+#include "PSP_Core_Instructions.h"
+#include "PSP_DWT.h"
+#include "PSP_SCB.h"
+#include "PSP_Stack.h"
 #include "PSP_SysTick.h"
+#include "PSP_System_Clock_Init.h"
 
 /*
 --|----------------------------------------------------------------------------|
@@ -25,7 +30,26 @@
 --|----------------------------------------------------------------------------|
 */
 
-/* None */
+/*
+--| NAME: SYSTICK_CYCLES_PER_MSEC
+--| DESCRIPTION: the number of SysTick counts in one normal tick
+--| TYPE: unsigned integer
+*/
+#define SYSTICK_CYCLES_PER_MSEC (SYSTEM_CLOCK_SPEED / 1000u)
+
+/*
+--| NAME: SYSTICK_CYCLES_PER_USEC
+--| DESCRIPTION: the number of core clock cycles in one microsecond
+--| TYPE: unsigned integer
+*/
+#define SYSTICK_CYCLES_PER_USEC (SYSTEM_CLOCK_SPEED / 1000000u)
+
+/*
+--| NAME: SYSTICK_MAX_IDLE_mSec
+--| DESCRIPTION: the longest tickless sleep which fits in the reload register
+--| TYPE: unsigned integer
+*/
+#define SYSTICK_MAX_IDLE_mSec ((SYSTICK_MAX_RELOAD + 1u) / SYSTICK_CYCLES_PER_MSEC)
 
 /*
 --|----------------------------------------------------------------------------|
@@ -56,19 +80,72 @@
 */
 static volatile uint32_t mSec_since_reset = 0u;
 
+/*
+--| NAME: mSec_since_reset_high_word
+--| DESCRIPTION: the upper 32 bits of the 64 bit millisecond count,
+--|   incremented each time mSec_since_reset wraps.
+--| TYPE: uint32_t
+*/
+static volatile uint32_t mSec_since_reset_high_word = 0u;
+
 /*
 --|----------------------------------------------------------------------------|
 --| PRIVATE HELPER FUNCTION PROTOTYPES
 --|----------------------------------------------------------------------------|
 */
 
+/*------------------------------------------------------------------------------
+Function Name:
+    SysTick_Stop
+
+Function Description:
+    Stop the counter without losing the count flag.
+
+Parameters:
+    None
+
+Returns:
+    uint32_t: the control register value, with the count flag set if the
+    counter reached 0 since the control register was last read.
+
+Assumptions/Limitations:
+    None
+------------------------------------------------------------------------------*/
+static uint32_t SysTick_Stop(void);
+
+/*------------------------------------------------------------------------------
+Function Name:
+    SysTick_Resume_Ticks
+
+Function Description:
+    Restart the counter so that the next tick fires after the remainder of
+    the current tick, then continues with the normal 1 mSec period.
+
+Parameters:
+    cycles_into_tick: the number of counts already elapsed in the current
+        tick [0 to SYSTICK_CYCLES_PER_MSEC - 1].
+
+Returns:
+    None
+
+Assumptions/Limitations:
+    Assumes that the counter is stopped and interrupts are masked.
+------------------------------------------------------------------------------*/
+static void SysTick_Resume_Ticks(uint32_t cycles_into_tick);
+
 /*------------------------------------------------------------------------------
 Function Name:
     Systick_handler
 
 Function Description:
-    Interrupt routine for periodic Systick interrupts. Simply increments the
-    mSec_since_reset variable.
+    Interrupt routine for periodic Systick interrupts. Increments the 64 bit
+    millisecond count and extends the DWT cycle counter.
+
+    The control register is read to clear the count flag, so that
+    SysTick_Tickless_Idle can tell whether a tick is waiting to be handled.
+
+    When built with STACK_GUARD_CHECK defined, also checks the stack guard
+    region and calls Stack_Overflow_Handler if it has been overwritten.
 
 Parameters:
     None
@@ -102,6 +179,51 @@ uint32_t SysTick_Get_mSec(void)
     return mSec_since_reset;
 }
 
+uint64_t SysTick_Get_mSec_64(void)
+{
+    uint32_t high_word;
+    uint32_t low_word;
+
+    // if the low word wrapped while reading the pair, try again
+    do
+    {
+        high_word = mSec_since_reset_high_word;
+        low_word  = mSec_since_reset;
+    } while (high_word != mSec_since_reset_high_word);
+
+    return ((uint64_t)high_word << 32u) | low_word;
+}
+
+uint64_t SysTick_Get_Cycles_64(void)
+{
+    uint64_t mSec;
+    uint32_t count_down;
+    bool     tick_pending;
+
+    // if a tick was handled while reading, try again
+    do
+    {
+        mSec         = SysTick_Get_mSec_64();
+        count_down   = SysTick->VAL;
+        tick_pending = (SCB->ICSR & SCB_ICSR_PENDSTSET_FLAG) != 0u;
+    } while (mSec != SysTick_Get_mSec_64());
+
+    if (tick_pending)
+    {
+        // the counter has reloaded but the handler has not counted it yet,
+        // read again in case the reload came after the first read
+        count_down = SysTick->VAL;
+        mSec++;
+    }
+
+    return (mSec * SYSTICK_CYCLES_PER_MSEC) + ((SYSTICK_CYCLES_PER_MSEC - 1u) - count_down);
+}
+
+uint64_t SysTick_Get_uSec_64(void)
+{
+    return SysTick_Get_Cycles_64() / SYSTICK_CYCLES_PER_USEC;
+}
+
 void SysTick_Start_Timeout_Timer(SysTick_Timeout_Timer_t * p_timer)
 {
     p_timer->timeout_start_mSec = SysTick_Get_mSec();
@@ -125,13 +247,202 @@ bool SysTick_Poll_Periodic_Timer(SysTick_Timeout_Timer_t * p_timer)
     return timeout_occured;
 }
 
+void SysTick_Tickless_Idle(uint32_t idle_mSec)
+{
+    if (idle_mSec == 0u)
+    {
+        return;
+    }
+
+    if (idle_mSec > SYSTICK_MAX_IDLE_mSec)
+    {
+        idle_mSec = SYSTICK_MAX_IDLE_mSec;
+    }
+
+    Core_Disable_Interrupts();
+
+    // the control register is only read here and in the handler, so a set
+    // count flag means a tick happened after interrupts were masked
+    if (SysTick_Stop() & SysTick_CTRL_COUNT_FLAG)
+    {
+        // let the pending tick be handled normally instead of sleeping
+        SysTick->CTRL |= SysTick_CTRL_ENABLE_FLAG;
+        Core_Enable_Interrupts();
+        return;
+    }
+
+    const uint32_t cycles_left_in_tick = SysTick->VAL;
+    const uint32_t cycles_into_tick    = (SYSTICK_CYCLES_PER_MSEC - 1u) - cycles_left_in_tick;
+
+    // count down the rest of this tick, plus the whole ticks to skip
+    const uint32_t sleep_reload = cycles_left_in_tick + ((idle_mSec - 1u) * SYSTICK_CYCLES_PER_MSEC);
+
+    if (sleep_reload == 0u)
+    {
+        // a reload of 0 would stop the counter, and the tick is due anyway
+        SysTick_Resume_Ticks(cycles_into_tick);
+        Core_Enable_Interrupts();
+        return;
+    }
+
+    SysTick->LOAD = sleep_reload;
+    SysTick->VAL  = 0u;
+
+    // the DWT cycle counter stops while the core sleeps, unlike SysTick
+    const uint32_t cycle_count_before = DWT->CYCCNT;
+
+    SysTick->CTRL |= SysTick_CTRL_ENABLE_FLAG;
+
+    Core_Data_Sync_Barrier();
+    Core_Wait_For_Interrupt();
+    Core_Instruction_Sync_Barrier();
+
+    const bool     deadline_reached  = (SysTick_Stop() & SysTick_CTRL_COUNT_FLAG) != 0u;
+    const uint32_t count_now         = SysTick->VAL;
+    const uint32_t cycle_count_after = DWT->CYCCNT;
+
+    // the counter restarts from sleep_reload after reaching the deadline, so
+    // count_now measures the overshoot in that case
+    uint32_t elapsed_cycles = sleep_reload - count_now;
+
+    if (deadline_reached)
+    {
+        elapsed_cycles += sleep_reload + 1u;
+    }
+
+    // credit the DWT with the cycles it missed, none if a debugger keeps it clocked in sleep
+    if (elapsed_cycles > (cycle_count_after - cycle_count_before))
+    {
+        DWT_Cycle_Counter_Add(elapsed_cycles - (cycle_count_after - cycle_count_before));
+    }
+
+    elapsed_cycles += cycles_into_tick;
+
+    uint32_t elapsed_mSec = elapsed_cycles / SYSTICK_CYCLES_PER_MSEC;
+
+    if (deadline_reached)
+    {
+        // reaching the deadline left the SysTick interrupt pending, it will
+        // count one of the elapsed ticks as soon as interrupts are unmasked
+        elapsed_mSec--;
+    }
+
+    const uint32_t previous_mSec = mSec_since_reset;
+
+    mSec_since_reset += elapsed_mSec;
+
+    if (mSec_since_reset < previous_mSec)
+    {
+        mSec_since_reset_high_word++;
+    }
+
+    SysTick_Resume_Ticks(elapsed_cycles % SYSTICK_CYCLES_PER_MSEC);
+
+    Core_Enable_Interrupts();
+}
+
+uint32_t SysTick_Get_Max_Idle_mSec(void)
+{
+    return SYSTICK_MAX_IDLE_mSec;
+}
+
+void SysTick_Deadline_From_Now(SysTick_Deadline_t * p_deadline, uint32_t mSec)
+{
+    p_deadline->deadline_mSec = SysTick_Get_mSec_64() + mSec;
+}
+
+void SysTick_Deadline_Advance(SysTick_Deadline_t * p_deadline, uint32_t mSec)
+{
+    p_deadline->deadline_mSec += mSec;
+}
+
+bool SysTick_Deadline_Has_Passed(SysTick_Deadline_t * p_deadline)
+{
+    return SysTick_Get_mSec_64() >= p_deadline->deadline_mSec;
+}
+
+uint64_t SysTick_Deadline_Get_mSec_Remaining(SysTick_Deadline_t * p_deadline)
+{
+    const uint64_t now_mSec = SysTick_Get_mSec_64();
+
+    if (now_mSec >= p_deadline->deadline_mSec)
+    {
+        return 0u;
+    }
+
+    return p_deadline->deadline_mSec - now_mSec;
+}
+
+void SysTick_Sleep_Until(SysTick_Deadline_t * p_deadline)
+{
+    uint64_t remaining_mSec = SysTick_Deadline_Get_mSec_Remaining(p_deadline);
+
+    while (remaining_mSec != 0u)
+    {
+        // SysTick_Tickless_Idle clamps to the longest sleep it can do
+        SysTick_Tickless_Idle((remaining_mSec > UINT32_MAX) ? UINT32_MAX : (uint32_t)remaining_mSec);
+
+        remaining_mSec = SysTick_Deadline_Get_mSec_Remaining(p_deadline);
+    }
+}
+
 /*
 --|----------------------------------------------------------------------------|
 --| PRIVATE HELPER FUNCTION DEFINITIONS
 --|----------------------------------------------------------------------------|
 */
 
+static uint32_t SysTick_Stop(void)
+{
+    // reading the control register clears the count flag, so keep a copy
+    uint32_t ctrl = SysTick->CTRL;
+
+    SysTick->CTRL = ctrl & ~SysTick_CTRL_ENABLE_FLAG;
+
+    // catch a count to 0 between the read and the write
+    ctrl |= SysTick->CTRL;
+
+    return ctrl;
+}
+
+static void SysTick_Resume_Ticks(uint32_t cycles_into_tick)
+{
+    uint32_t first_reload = (SYSTICK_CYCLES_PER_MSEC - 1u) - cycles_into_tick;
+
+    if (first_reload == 0u)
+    {
+        // a reload of 0 would stop the counter
+        first_reload = 1u;
+    }
+
+    // the first reload finishes the current tick
+    SysTick->LOAD = first_reload;
+    SysTick->VAL  = 0u;
+    SysTick->CTRL |= SysTick_CTRL_ENABLE_FLAG;
+
+    // the counter has already taken the short reload, later ones are normal
+    SysTick->LOAD = SYSTICK_CYCLES_PER_MSEC - 1u;
+}
+
 void SysTick_handler(void)
 {
+    // clear the count flag
+    (void)SysTick->CTRL;
+
     mSec_since_reset++;
+
+    // the low word is written first, so readers can detect the carry
+    if (mSec_since_reset == 0u)
+    {
+        mSec_since_reset_high_word++;
+    }
+
+    DWT_Cycle_Counter_Update();
+
+#if defined(STACK_GUARD_CHECK)
+    if (!Stack_Is_Guard_Intact())
+    {
+        Stack_Overflow_Handler();
+    }
+#endif
 }
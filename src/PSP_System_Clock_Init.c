@@ -18,6 +18,8 @@
 */
 
 #include "Common_Masks.h"
+#include "PSP_DWT.h"
+#include "PSP_FLASH.h"
 #include "PSP_RCC.h"
 #include "PSP_System_Clock_Init.h"
 #include "PSP_SysTick.h"
@@ -44,7 +46,34 @@
 --|----------------------------------------------------------------------------|
 */
 
-/* None */
+/*
+--| compile-time checks of the configured clock tree against the limits in the
+--| reference manual and datasheet
+*/
+_Static_assert((CLOCK_TREE_CFG_PLLMUL >= 2u) && (CLOCK_TREE_CFG_PLLMUL <= 16u),
+               "PLL multiplier must be 2 to 16");
+
+_Static_assert((CLOCK_TREE_CFG_PLL_SOURCE != CLOCK_TREE_PLL_SOURCE_HSE) ||
+               ((CLOCK_TREE_HSE_HZ >= 4000000u) && (CLOCK_TREE_HSE_HZ <= 16000000u)),
+               "HSE must be 4 to 16 MHz");
+
+_Static_assert((CLOCK_TREE_CFG_SYSCLK_SOURCE != CLOCK_TREE_SYSCLK_SOURCE_PLL) ||
+               ((CLOCK_TREE_PLL_OUTPUT_HZ >= 16000000u) && (CLOCK_TREE_PLL_OUTPUT_HZ <= 72000000u)),
+               "PLL output must be 16 to 72 MHz");
+
+_Static_assert(CLOCK_TREE_SYSCLK_HZ <= 72000000u, "SYSCLK must not exceed 72 MHz");
+
+_Static_assert(CLOCK_TREE_HPRE_BITS != 0xFFu, "invalid AHB prescaler");
+_Static_assert(CLOCK_TREE_PPRE1_BITS != 0xFFu, "invalid APB1 prescaler");
+_Static_assert(CLOCK_TREE_PPRE2_BITS != 0xFFu, "invalid APB2 prescaler");
+_Static_assert(CLOCK_TREE_ADCPRE_BITS != 0xFFu, "invalid ADC prescaler");
+
+_Static_assert(CLOCK_TREE_PCLK1_HZ <= 36000000u, "PCLK1 must not exceed 36 MHz");
+_Static_assert(CLOCK_TREE_PCLK2_HZ <= 72000000u, "PCLK2 must not exceed 72 MHz");
+_Static_assert(CLOCK_TREE_ADC_CLK_HZ <= 14000000u, "ADC clock must not exceed 14 MHz");
+
+_Static_assert(((SYSTEM_CLOCK_SPEED / 1000u) - 1u) <= 0xFFFFFFu,
+               "a 1 mSec SysTick period must fit in the 24 bit reload register");
 
 /*
 --|----------------------------------------------------------------------------|
@@ -105,6 +134,7 @@ static void SysTick_Init(void);
 void System_Clock_Init(void)
 {
     RCC_Init();
+    DWT_Init();
     SysTick_Init();
 }
 
@@ -116,6 +146,11 @@ void System_Clock_Init(void)
 
 static void RCC_Init(void)
 {
+    // the flash needs more wait states before the clock speeds up, never fewer
+    FLASH->ACR &= ~(THREE_BIT_MASK << FLASH_ACR_LATENCY_SHIFT_AMT);
+    FLASH->ACR |= CLOCK_TREE_FLASH_LATENCY << FLASH_ACR_LATENCY_SHIFT_AMT;
+    FLASH->ACR |= FLASH_ACR_PRFTBE_FLAG;
+
     // enable the internal high speed clock
     RCC->CR |= RCC_CR_HSION_FLAG;
 
@@ -124,33 +159,63 @@ static void RCC_Init(void)
         // wait for the internal clock to be ready
     }
 
-    // set the PLL multiplier
-    RCC->CFGR &= ~(FOUR_BIT_MASK << RCC_CFGR_PLLMUL_SHIFT_AMT);
-    RCC->CFGR |= RCC_CFGR_PLLMUL_X_8 << RCC_CFGR_PLLMUL_SHIFT_AMT;
-
-    // set the PLL clock source
-    RCC->CFGR &= ~RCC_CFGR_PLLSRC_FLAG; // HSI oscillator clock / 2 selected as PLL input clock
+    if ((CLOCK_TREE_CFG_SYSCLK_SOURCE == CLOCK_TREE_SYSCLK_SOURCE_HSE) ||
+        ((CLOCK_TREE_CFG_SYSCLK_SOURCE == CLOCK_TREE_SYSCLK_SOURCE_PLL) && 
+         (CLOCK_TREE_CFG_PLL_SOURCE == CLOCK_TREE_PLL_SOURCE_HSE)))
+    {
+        // enable the external high speed clock
+        RCC->CR |= RCC_CR_HSEON_FLAG;
 
-    // turn on the PLL
-    RCC->CR |= RCC_CR_PLLON_FLAG;
+        while (!(RCC->CR & RCC_CR_HSERDY_FLAG))
+        {
+            // wait for the external clock to be ready
+        }
+    }
 
-    while (!(RCC->CR & RCC_CR_PLLRDY_FLAG))
+    if (CLOCK_TREE_CFG_SYSCLK_SOURCE == CLOCK_TREE_SYSCLK_SOURCE_PLL)
     {
-        // wait for the PLL to lock
+        // set the PLL multiplier
+        RCC->CFGR &= ~(FOUR_BIT_MASK << RCC_CFGR_PLLMUL_SHIFT_AMT);
+        RCC->CFGR |= CLOCK_TREE_PLLMUL_BITS << RCC_CFGR_PLLMUL_SHIFT_AMT;
+
+        // set the PLL clock source
+        if (CLOCK_TREE_CFG_PLL_SOURCE == CLOCK_TREE_PLL_SOURCE_HSE)
+        {
+            RCC->CFGR &= ~RCC_CFGR_PLLXTPRE_FLAG; // HSE not divided
+            RCC->CFGR |= RCC_CFGR_PLLSRC_FLAG;    // HSE selected as PLL input clock
+        }
+        else
+        {
+            RCC->CFGR &= ~RCC_CFGR_PLLSRC_FLAG; // HSI oscillator clock / 2 selected as PLL input clock
+        }
+
+        // turn on the PLL
+        RCC->CR |= RCC_CR_PLLON_FLAG;
+
+        while (!(RCC->CR & RCC_CR_PLLRDY_FLAG))
+        {
+            // wait for the PLL to lock
+        }
     }
 
     // set the clock dividers
     RCC->CFGR &= ~(FOUR_BIT_MASK << RCC_CFGR_HPRE_SHIFT_AMT);
-    RCC->CFGR |= RCC_CFGR_HPRE_NO_DIVIDE << RCC_CFGR_HPRE_SHIFT_AMT;
+    RCC->CFGR |= CLOCK_TREE_HPRE_BITS << RCC_CFGR_HPRE_SHIFT_AMT;
+
+    RCC->CFGR &= ~(THREE_BIT_MASK << RCC_CFGR_PPRE1_SHIFT_AMT);
+    RCC->CFGR |= CLOCK_TREE_PPRE1_BITS << RCC_CFGR_PPRE1_SHIFT_AMT;
 
     RCC->CFGR &= ~(THREE_BIT_MASK << RCC_CFGR_PPRE2_SHIFT_AMT);
-    RCC->CFGR |= RCC_CFGR_PPRE2_NO_DIVIDE << RCC_CFGR_PPRE2_SHIFT_AMT;
+    RCC->CFGR |= CLOCK_TREE_PPRE2_BITS << RCC_CFGR_PPRE2_SHIFT_AMT;
+
+    RCC->CFGR &= ~(TWO_BIT_MASK << RCC_CFGR_ADCPRE_SHIFT_AMT);
+    RCC->CFGR |= CLOCK_TREE_ADCPRE_BITS << RCC_CFGR_ADCPRE_SHIFT_AMT;
 
-    // select the PLL as the system clock
+    // select the configured system clock source
     RCC->CFGR &= ~(TWO_BIT_MASK << RCC_CFGR_SW_SHIFT_AMT);
-    RCC->CFGR |= RCC_CFGR_SW_PLL << RCC_CFGR_SW_SHIFT_AMT;
+    RCC->CFGR |= CLOCK_TREE_CFG_SYSCLK_SOURCE << RCC_CFGR_SW_SHIFT_AMT;
 
-    while (!(RCC->CFGR & (RCC_CFGR_SWS_PLL << RCC_CFGR_SWS_SHIFT_AMT)))
+    while (((RCC->CFGR >> RCC_CFGR_SWS_SHIFT_AMT) & TWO_BIT_MASK) != CLOCK_TREE_CFG_SYSCLK_SOURCE)
     {
         // wait for the setting to take hold
     }
@@ -0,0 +1,1636 @@
+/*
+--|----------------------------------------------------------------------------|
+--| FILE DESCRIPTION:
+--|   PSP_TIMx.c provides the implementation for the general-purpose timer
+--|   driver.
+--|
+--|----------------------------------------------------------------------------|
+--| REFERENCES:
+--|   stm32f10x reference manual, page 365
+--|
+--|----------------------------------------------------------------------------|
+*/
+
+/*
+--|----------------------------------------------------------------------------|
+--| INCLUDE FILES
+--|----------------------------------------------------------------------------|
+*/
+
+#include <stddef.h>
+
+#include "PSP_Clock_Tree.h"
+#include "PSP_DMA.h"
+#include "PSP_TIMx.h"
+
+/*
+--|----------------------------------------------------------------------------|
+--| PRIVATE DEFINES
+--|----------------------------------------------------------------------------|
+*/
+
+/*
+--| NAME: TIMx_MAX_COUNT
+--| DESCRIPTION: the largest value of the 16 bit counter, prescaler and
+--|   auto-reload registers
+--| TYPE: unsigned integer
+*/
+#define TIMx_MAX_COUNT (0xFFFFu)
+
+/*
+--| NAME: TIMx_CCMR_CHANNEL_WIDTH
+--| DESCRIPTION: the number of bits per channel in the CCMR1 and CCMR2 registers
+--| TYPE: unsigned integer
+*/
+#define TIMx_CCMR_CHANNEL_WIDTH (8u)
+
+/*
+--| NAME: TIMx_CCER_CHANNEL_WIDTH
+--| DESCRIPTION: the number of bits per channel in the CCER register
+--| TYPE: unsigned integer
+*/
+#define TIMx_CCER_CHANNEL_WIDTH (4u)
+
+/*
+--| NAME: TIMx_NUM_TIMERS
+--| DESCRIPTION: the number of timers handled by this driver, TIM1 to TIM4
+--| TYPE: unsigned integer
+*/
+#define TIMx_NUM_TIMERS (4u)
+
+/*
+--| NAME: TIMx_HALF_COUNT
+--| DESCRIPTION: half of the counter range, for deciding whether a capture
+--|   came before or after a pending overflow
+--| TYPE: unsigned integer
+*/
+#define TIMx_HALF_COUNT (0x8000u)
+
+/*
+--| NAME: TIMx_COUNTER_BITS
+--| DESCRIPTION: the width of the hardware counter
+--| TYPE: unsigned integer
+*/
+#define TIMx_COUNTER_BITS (16u)
+
+/*
+--| NAME: TIMx_CASCADE_CARRY_WINDOW
+--| DESCRIPTION: low half counts below which the carry of a cascade may still
+--|   be in flight. The low timer's TRGO is resynchronized to the high timer's
+--|   kernel clock, so the high half steps a few kernel clocks after the low
+--|   half wraps, and an unprescaled low half advances once per kernel clock
+--| TYPE: unsigned integer
+*/
+#define TIMx_CASCADE_CARRY_WINDOW (4u)
+
+/*
+--| NAME: TIMx_CASCADE_CARRY_READS
+--| DESCRIPTION: extra reads of the high half when the low half is inside the
+--|   carry window, each at least one APB access, which outlast the carry delay
+--| TYPE: unsigned integer
+*/
+#define TIMx_CASCADE_CARRY_READS (4u)
+
+/*
+--| NAME: TIMx_MAX_DMA_TRANSFERS
+--| DESCRIPTION: the largest number of transfers in one DMA pass
+--| TYPE: unsigned integer
+*/
+#define TIMx_MAX_DMA_TRANSFERS (0xFFFFu)
+
+/*
+--| NAME: TIMx_NSEC_PER_SEC
+--| DESCRIPTION: the number of nanoseconds in a second
+--| TYPE: unsigned integer
+*/
+#define TIMx_NSEC_PER_SEC (1000000000u)
+
+/*
+--| NAME: TIMx_NUM_PHASES
+--| DESCRIPTION: the number of phases of a three-phase bridge, on channels 1 to 3
+--| TYPE: unsigned integer
+*/
+#define TIMx_NUM_PHASES (3u)
+
+/*
+--| NAME: TIMx_NUM_SIX_STEPS
+--| DESCRIPTION: the number of steps in a six-step commutation sequence
+--| TYPE: unsigned integer
+*/
+#define TIMx_NUM_SIX_STEPS (6u)
+
+/*
+--| NAME: TIMx_MAX_CKD_SHIFT
+--| DESCRIPTION: the largest clock division, as a power of 2, for the
+--|   dead-time and filter clock
+--| TYPE: unsigned integer
+*/
+#define TIMx_MAX_CKD_SHIFT (2u)
+
+/*
+--| NAME: TIMx_MAX_REPETITIONS
+--| DESCRIPTION: the largest number of periods per update event, RCR + 1
+--| TYPE: unsigned integer
+*/
+#define TIMx_MAX_REPETITIONS (256u)
+
+/*
+--| NAME: TIMx_DCR_DBA
+--| DESCRIPTION: the DMA burst base address of a register, its word offset
+--|   in TIMx_t
+--| TYPE: unsigned integer
+*/
+#define TIMx_DCR_DBA(reg) (offsetof(TIMx_t, reg) / sizeof(uint32_t))
+
+/*
+--|----------------------------------------------------------------------------|
+--| PRIVATE TYPES
+--|----------------------------------------------------------------------------|
+*/
+
+/*
+--| NAME: TIMx_Phase_State_enum
+--| DESCRIPTION: enumeration for the state of one phase of a bridge in a
+--|   six-step commutation step
+*/
+typedef enum TIMx_Phase_State_Enumeration
+{
+    TIMx_PHASE_OFF, // both switches off
+    TIMx_PHASE_PWM, // high side switching, low side complementary
+    TIMx_PHASE_LOW  // low side on
+} TIMx_Phase_State_enum;
+
+/*
+--|----------------------------------------------------------------------------|
+--| PRIVATE CONSTANTS
+--|----------------------------------------------------------------------------|
+*/
+
+/*
+--| NAME: TIMx_capture_compare_DMA_channels
+--| DESCRIPTION: the DMA1 channel hard wired to each timer capture/compare
+--|   channel, indexed by timer (TIM1 to TIM4) then channel
+--| TYPE: DMA_Channel_enum
+*/
+static const DMA_Channel_enum TIMx_capture_compare_DMA_channels[TIMx_NUM_TIMERS][TIMx_NUM_CHANNELS] =
+{
+    { DMA_CHANNEL_2, DMA_CHANNEL_3,    DMA_CHANNEL_6, DMA_CHANNEL_4    }, // TIM1
+    { DMA_CHANNEL_5, DMA_CHANNEL_7,    DMA_CHANNEL_1, DMA_CHANNEL_7    }, // TIM2
+    { DMA_CHANNEL_6, DMA_CHANNEL_NONE, DMA_CHANNEL_2, DMA_CHANNEL_3    }, // TIM3
+    { DMA_CHANNEL_1, DMA_CHANNEL_4,    DMA_CHANNEL_5, DMA_CHANNEL_NONE }, // TIM4
+};
+
+/*
+--| NAME: TIMx_update_DMA_channels
+--| DESCRIPTION: the DMA1 channel hard wired to each timer's update request,
+--|   indexed by timer (TIM1 to TIM4)
+--| TYPE: DMA_Channel_enum
+*/
+static const DMA_Channel_enum TIMx_update_DMA_channels[TIMx_NUM_TIMERS] =
+{
+    DMA_CHANNEL_5, // TIM1
+    DMA_CHANNEL_2, // TIM2
+    DMA_CHANNEL_3, // TIM3
+    DMA_CHANNEL_7, // TIM4
+};
+
+/*
+--| NAME: TIMx_six_step_phases
+--| DESCRIPTION: the state of phases A, B and C in each six-step commutation step
+--| TYPE: TIMx_Phase_State_enum
+*/
+static const TIMx_Phase_State_enum TIMx_six_step_phases[TIMx_NUM_SIX_STEPS][TIMx_NUM_PHASES] =
+{
+    //  A               B               C
+    { TIMx_PHASE_PWM, TIMx_PHASE_LOW, TIMx_PHASE_OFF }, // step 0
+    { TIMx_PHASE_PWM, TIMx_PHASE_OFF, TIMx_PHASE_LOW }, // step 1
+    { TIMx_PHASE_OFF, TIMx_PHASE_PWM, TIMx_PHASE_LOW }, // step 2
+    { TIMx_PHASE_LOW, TIMx_PHASE_PWM, TIMx_PHASE_OFF }, // step 3
+    { TIMx_PHASE_LOW, TIMx_PHASE_OFF, TIMx_PHASE_PWM }, // step 4
+    { TIMx_PHASE_OFF, TIMx_PHASE_LOW, TIMx_PHASE_PWM }, // step 5
+};
+
+/*
+--| NAME: TIMx_internal_triggers
+--| DESCRIPTION: the internal trigger (ITRx) which connects a master timer's
+--|   TRGO to a slave, indexed by slave then master (TIM1 to TIM4). A timer
+--|   cannot be its own master, those entries are unused.
+--| TYPE: TIMx_SMCR_TS_MASKS_enum
+*/
+static const TIMx_SMCR_TS_MASKS_enum TIMx_internal_triggers[TIMx_NUM_TIMERS][TIMx_NUM_TIMERS] =
+{
+    //  TIM1                        TIM2                        TIM3                        TIM4
+    { TIMx_CR2_SMCR_TS_INT_TRIG_0, TIMx_CR2_SMCR_TS_INT_TRIG_1, TIMx_CR2_SMCR_TS_INT_TRIG_2, TIMx_CR2_SMCR_TS_INT_TRIG_3 }, // TIM1
+    { TIMx_CR2_SMCR_TS_INT_TRIG_0, TIMx_CR2_SMCR_TS_INT_TRIG_0, TIMx_CR2_SMCR_TS_INT_TRIG_2, TIMx_CR2_SMCR_TS_INT_TRIG_3 }, // TIM2
+    { TIMx_CR2_SMCR_TS_INT_TRIG_0, TIMx_CR2_SMCR_TS_INT_TRIG_1, TIMx_CR2_SMCR_TS_INT_TRIG_0, TIMx_CR2_SMCR_TS_INT_TRIG_3 }, // TIM3
+    { TIMx_CR2_SMCR_TS_INT_TRIG_0, TIMx_CR2_SMCR_TS_INT_TRIG_1, TIMx_CR2_SMCR_TS_INT_TRIG_2, TIMx_CR2_SMCR_TS_INT_TRIG_0 }, // TIM4
+};
+
+/*
+--|----------------------------------------------------------------------------|
+--| PRIVATE VARIABLES
+--|----------------------------------------------------------------------------|
+*/
+
+/* None */
+
+/*
+--|----------------------------------------------------------------------------|
+--| PRIVATE HELPER FUNCTION PROTOTYPES
+--|----------------------------------------------------------------------------|
+*/
+
+/*------------------------------------------------------------------------------
+Function Name:
+    TIMx_Get_Clock_Hz
+
+Function Description:
+    Get the input clock frequency of a timer from the clock tree.
+
+Parameters:
+    p_TIMx: pointer to the timer.
+
+Returns:
+    uint32_t: the timer clock frequency in Hz.
+
+Assumptions/Limitations:
+    Assumes that p_TIMx is one of TIM1 to TIM4.
+------------------------------------------------------------------------------*/
+static uint32_t TIMx_Get_Clock_Hz(volatile TIMx_t * p_TIMx);
+
+/*------------------------------------------------------------------------------
+Function Name:
+    TIMx_Get_Index
+
+Function Description:
+    Get the index of a timer, for looking up per-timer tables.
+
+Parameters:
+    p_TIMx: pointer to the timer.
+
+Returns:
+    uint32_t: 0 for TIM1 up to 3 for TIM4.
+
+Assumptions/Limitations:
+    Assumes that p_TIMx is one of TIM1 to TIM4.
+------------------------------------------------------------------------------*/
+static uint32_t TIMx_Get_Index(volatile TIMx_t * p_TIMx);
+
+/*------------------------------------------------------------------------------
+Function Name:
+    TIMx_Set_Tick_Rate
+
+Function Description:
+    Set the prescaler to give the closest counter frequency to the one
+    requested.
+
+Parameters:
+    p_TIMx: pointer to the timer.
+    tick_Hz: the requested counter frequency.
+
+Returns:
+    uint32_t: the actual counter frequency in Hz.
+
+Assumptions/Limitations:
+    The new prescaler takes effect at the next update event.
+------------------------------------------------------------------------------*/
+static uint32_t TIMx_Set_Tick_Rate(volatile TIMx_t * p_TIMx, uint32_t tick_Hz);
+
+/*------------------------------------------------------------------------------
+Function Name:
+    TIMx_Init_Capture_Time_Base
+
+Function Description:
+    Set up a free running 16 bit time base for input capture, counting up
+    at the requested frequency, with update events only on overflow.
+
+Parameters:
+    p_handle: pointer to the capture handle.
+    tick_Hz: the requested counter frequency.
+
+Returns:
+    None
+
+Assumptions/Limitations:
+    Resets the capture results in the handle.
+------------------------------------------------------------------------------*/
+static void TIMx_Init_Capture_Time_Base(TIMx_Capture_Handle_t * p_handle, uint32_t tick_Hz);
+
+/*------------------------------------------------------------------------------
+Function Name:
+    TIMx_Extend_Capture
+
+Function Description:
+    Extend a 16 bit capture to 32 bits with the overflow count. If an
+    overflow is pending and the capture is in the lower half of the count,
+    the capture came after the overflow, so it is counted in.
+
+Parameters:
+    p_handle: pointer to the capture handle.
+    capture: the 16 bit captured count.
+    status: the status register, read after the capture register.
+
+Returns:
+    uint32_t: the extended capture.
+
+Assumptions/Limitations:
+    None
+------------------------------------------------------------------------------*/
+static uint32_t TIMx_Extend_Capture(TIMx_Capture_Handle_t * p_handle, uint32_t capture, uint32_t status);
+
+/*------------------------------------------------------------------------------
+Function Name:
+    TIMx_Set_Master_Mode
+
+Function Description:
+    Select what a timer drives on its trigger output (TRGO).
+
+Parameters:
+    p_TIMx: pointer to the timer.
+    mode: the master mode.
+
+Returns:
+    None
+
+Assumptions/Limitations:
+    None
+------------------------------------------------------------------------------*/
+static void TIMx_Set_Master_Mode(volatile TIMx_t * p_TIMx, TIMx_CR2_MMS_MASKS_enum mode);
+
+/*------------------------------------------------------------------------------
+Function Name:
+    TIMx_Set_Slave_Mode
+
+Function Description:
+    Make a timer a slave of another timer's trigger output.
+
+Parameters:
+    p_slave: pointer to the slave timer.
+    p_master: pointer to the master timer.
+    mode: the slave mode.
+
+Returns:
+    None
+
+Assumptions/Limitations:
+    Assumes that the timers are different.
+------------------------------------------------------------------------------*/
+static void TIMx_Set_Slave_Mode(volatile TIMx_t * p_slave, 
+                                volatile TIMx_t * p_master, 
+                                TIMx_SMCR_SMS_MASKS_enum mode);
+
+/*------------------------------------------------------------------------------
+Function Name:
+    TIMx_Enable_Output
+
+Function Description:
+    Set the polarity of an output channel and enable it.
+
+Parameters:
+    p_TIMx: pointer to the timer.
+    channel: the channel.
+    polarity: the level of the output while it is active.
+
+Returns:
+    None
+
+Assumptions/Limitations:
+    For TIM1 this also sets the main output enable.
+------------------------------------------------------------------------------*/
+static void TIMx_Enable_Output(volatile TIMx_t * p_TIMx, 
+                               TIMx_Channel_enum channel, 
+                               TIMx_Output_Polarity_enum polarity);
+
+/*------------------------------------------------------------------------------
+Function Name:
+    TIMx_nSec_To_Ticks
+
+Function Description:
+    Convert a time to a number of ticks, rounded to the nearest.
+
+Parameters:
+    tick_Hz: the tick frequency.
+    time_nSec: the time in nanoseconds.
+
+Returns:
+    uint64_t: the number of ticks.
+
+Assumptions/Limitations:
+    None
+------------------------------------------------------------------------------*/
+static uint64_t TIMx_nSec_To_Ticks(uint32_t tick_Hz, uint64_t time_nSec);
+
+/*------------------------------------------------------------------------------
+Function Name:
+    TIMx_Encode_Dead_Time
+
+Function Description:
+    Encode a number of dead-time clocks into the DTG field, rounding up to
+    the next step it can represent:
+      0xxxxxxx: DTG[6:0] x 1, 0 to 127
+      10xxxxxx: (64 + DTG[5:0]) x 2, 128 to 254
+      110xxxxx: (32 + DTG[4:0]) x 8, 256 to 504
+      111xxxxx: (32 + DTG[4:0]) x 16, 512 to 1008
+
+Parameters:
+    ticks: the dead time in t_DTS clocks.
+    p_DTG: pointer to where the encoded value is written.
+
+Returns:
+    true if the dead time can be encoded.
+
+Assumptions/Limitations:
+    None
+------------------------------------------------------------------------------*/
+static bool TIMx_Encode_Dead_Time(uint32_t ticks, uint32_t * p_DTG);
+
+/*------------------------------------------------------------------------------
+Function Name:
+    TIMx_Six_Step_Stage
+
+Function Description:
+    Write the output modes and enables of the three phases. With CCPC set
+    they are held in preload until the next commutation event.
+
+Parameters:
+    p_TIMx: pointer to the timer.
+    p_phases: the states of phases A, B and C.
+
+Returns:
+    None
+
+Assumptions/Limitations:
+    None
+------------------------------------------------------------------------------*/
+static void TIMx_Six_Step_Stage(volatile TIMx_t * p_TIMx, const TIMx_Phase_State_enum * p_phases);
+
+/*------------------------------------------------------------------------------
+Function Name:
+    TIMx_Get_CCR
+
+Function Description:
+    Get the capture/compare register of a channel.
+
+Parameters:
+    p_TIMx: pointer to the timer.
+    channel: the channel.
+
+Returns:
+    vuint32_t*: pointer to the channel's CCR register.
+
+Assumptions/Limitations:
+    Relies on CCR1 to CCR4 being consecutive in TIMx_t.
+------------------------------------------------------------------------------*/
+static vuint32_t * TIMx_Get_CCR(volatile TIMx_t * p_TIMx, TIMx_Channel_enum channel);
+
+/*------------------------------------------------------------------------------
+Function Name:
+    TIMx_Set_Channel_Mode
+
+Function Description:
+    Write the capture/compare mode bits of a channel, in CCMR1 or CCMR2.
+
+Parameters:
+    p_TIMx: pointer to the timer.
+    channel: the channel.
+    mode_bits: the mode bits, laid out as for channel 1 in CCMR1 [8 bits].
+
+Returns:
+    None
+
+Assumptions/Limitations:
+    The channel should be disabled in CCER while its mode is changed.
+------------------------------------------------------------------------------*/
+static void TIMx_Set_Channel_Mode(volatile TIMx_t * p_TIMx, TIMx_Channel_enum channel, uint32_t mode_bits);
+
+/*
+--|----------------------------------------------------------------------------|
+--| PUBLIC FUNCTION DEFINITIONS
+--|----------------------------------------------------------------------------|
+*/
+
+void TIMx_PWM_Init(volatile TIMx_t * p_TIMx, TIMx_PWM_Initialization_Data_t * p_init_data)
+{
+    TIMx_Stop(p_TIMx);
+
+    // set the counting mode, edge-aligned counts up
+    p_TIMx->CR1 &= ~(TWO_BIT_MASK << TIMx_CR1_CMS_SHIFT_AMT);
+    p_TIMx->CR1 |= p_init_data->alignment << TIMx_CR1_CMS_SHIFT_AMT;
+    p_TIMx->CR1 &= ~TIMx_CR1_DIR_FLAG;
+
+    // 0 Hz has no period, so run at the slowest rate rather than divide by 0
+    const uint32_t frequency_Hz = (p_init_data->frequency_Hz == 0u) ? 1u : p_init_data->frequency_Hz;
+
+    uint32_t counts_per_period = TIMx_Get_Clock_Hz(p_TIMx) / frequency_Hz;
+
+    if (p_init_data->alignment != TIMx_CR1_CMS_EDGE_ALIGNED_MODE)
+    {
+        // the counter goes up and back down each period
+        counts_per_period /= 2u;
+    }
+
+    if (counts_per_period < 2u)
+    {
+        counts_per_period = 2u;
+    }
+
+    // the most ticks per period the 16 bit ARR can hold: edge-aligned counts
+    // 0 to ARR, ARR + 1 ticks, center-aligned counts up to ARR and back, ARR ticks
+    const uint32_t max_ticks_per_period = (p_init_data->alignment == TIMx_CR1_CMS_EDGE_ALIGNED_MODE) ?
+                                          (TIMx_MAX_COUNT + 1u) : TIMx_MAX_COUNT;
+
+    // the smallest prescaler which fits the period in the 16 bit counter
+    const uint32_t prescaler = (counts_per_period - 1u) / max_ticks_per_period;
+    const uint32_t ticks_per_period = counts_per_period / (prescaler + 1u);
+
+    p_TIMx->PSC = prescaler;
+
+    if (p_init_data->alignment == TIMx_CR1_CMS_EDGE_ALIGNED_MODE)
+    {
+        p_TIMx->ARR = ticks_per_period - 1u;
+    }
+    else
+    {
+        p_TIMx->ARR = ticks_per_period;
+    }
+
+    // buffer the auto-reload register so period changes are glitch-free
+    p_TIMx->CR1 |= TIMx_CR1_ARPE_FLAG;
+
+    // load the prescaler and auto-reload from their preload registers now
+    p_TIMx->EGR = TIMx_EGR_UG_FLAG;
+
+    // clear the update flag set by the forced update, writing 1 has no effect
+    p_TIMx->SR = ~TIMx_SR_UIF_FLAG;
+}
+
+void TIMx_PWM_Channel_Init(volatile TIMx_t * p_TIMx,
+                           TIMx_Channel_enum channel,
+                           TIMx_Output_Polarity_enum polarity,
+                           uint32_t duty_counts)
+{
+    const uint32_t ccer_shift = channel * TIMx_CCER_CHANNEL_WIDTH;
+
+    // disable the channel while changing its mode
+    p_TIMx->CCER &= ~(TIMx_CCER_CC1E_FLAG << ccer_shift);
+
+    // output, PWM mode 1, with the compare register preloaded
+    TIMx_Set_Channel_Mode(p_TIMx, channel,
+                          (TIMx_CCMR1_CC1S_OUTPUT << TIMx_CCMR1_CC1S_SHIFT_AMT) |
+                          (TIMx_CCMR1_OC1M_PWM_MODE_1 << TIMx_CCMR1_OC1M_SHIFT_AMT) |
+                          TIMx_CCMR1_OC1PE_FLAG);
+
+    *TIMx_Get_CCR(p_TIMx, channel) = duty_counts;
+
+    TIMx_Enable_Output(p_TIMx, channel, polarity);
+}
+
+uint32_t TIMx_PWM_Get_Period_Counts(volatile TIMx_t * p_TIMx)
+{
+    if (((p_TIMx->CR1 >> TIMx_CR1_CMS_SHIFT_AMT) & TWO_BIT_MASK) == TIMx_CR1_CMS_EDGE_ALIGNED_MODE)
+    {
+        // edge-aligned counts 0 to ARR inclusive
+        return p_TIMx->ARR + 1u;
+    }
+    else
+    {
+        // center-aligned output is active while CNT < CCR on the way up and down
+        return p_TIMx->ARR;
+    }
+}
+
+void TIMx_PWM_Set_Duty(volatile TIMx_t * p_TIMx, TIMx_Channel_enum channel, uint32_t duty_counts)
+{
+    *TIMx_Get_CCR(p_TIMx, channel) = duty_counts;
+}
+
+void TIMx_PWM_Set_Duty_Permille(volatile TIMx_t * p_TIMx, TIMx_Channel_enum channel, uint32_t duty_permille)
+{
+    TIMx_PWM_Set_Duty(p_TIMx, channel, (TIMx_PWM_Get_Period_Counts(p_TIMx) * duty_permille) / 1000u);
+}
+
+void TIMx_Start(volatile TIMx_t * p_TIMx)
+{
+    p_TIMx->CR1 |= TIMx_CR1_CEN_FLAG;
+}
+
+void TIMx_Stop(volatile TIMx_t * p_TIMx)
+{
+    p_TIMx->CR1 &= ~TIMx_CR1_CEN_FLAG;
+}
+
+void TIMx_Input_Capture_Init(TIMx_Capture_Handle_t * p_handle, 
+                             TIMx_Input_Capture_Initialization_Data_t * p_init_data)
+{
+    volatile TIMx_t * p_TIMx = p_handle->p_TIMx;
+    const TIMx_Channel_enum channel = p_handle->channel;
+    const uint32_t ccer_shift = channel * TIMx_CCER_CHANNEL_WIDTH;
+
+    TIMx_Init_Capture_Time_Base(p_handle, p_init_data->tick_Hz);
+
+    // disable the channel while changing its mode
+    p_TIMx->CCER &= ~(TIMx_CCER_CC1E_FLAG << ccer_shift);
+
+    // input mapped to its own pin (TI1 for channel 1, TI2 for channel 2, ...)
+    TIMx_Set_Channel_Mode(p_TIMx, channel,
+                          (TIMx_CCMR1_CC1S_INPUT_MAP_TI1 << TIMx_CCMR1_CC1S_SHIFT_AMT) |
+                          (p_init_data->prescaler << TIMx_CCMR1_IC1PSC_SHIFT_AMT) |
+                          (p_init_data->filter << TIMx_CCMR1_IC1F_SHIFT_AMT));
+
+    if (p_init_data->edge == TIMx_CAPTURE_FALLING_EDGE)
+    {
+        p_TIMx->CCER |= TIMx_CCER_CC1P_FLAG << ccer_shift;
+    }
+    else
+    {
+        p_TIMx->CCER &= ~(TIMx_CCER_CC1P_FLAG << ccer_shift);
+    }
+
+    p_TIMx->CCER |= TIMx_CCER_CC1E_FLAG << ccer_shift;
+
+    p_TIMx->DIER |= (TIMx_DIER_CC1IE_FLAG << channel) | TIMx_DIER_UIE_FLAG;
+}
+
+void TIMx_Input_Capture_IRQ_Handler(TIMx_Capture_Handle_t * p_handle)
+{
+    volatile TIMx_t * p_TIMx = p_handle->p_TIMx;
+    const TIMx_Channel_enum channel = p_handle->channel;
+
+    if (p_TIMx->SR & (TIMx_SR_CC1IF_FLAG << channel))
+    {
+        // reading the capture register clears the capture flag
+        const uint32_t capture  = *TIMx_Get_CCR(p_TIMx, channel);
+        const uint32_t extended = TIMx_Extend_Capture(p_handle, capture, p_TIMx->SR);
+
+        if (p_handle->capture_count != 0u)
+        {
+            p_handle->period_ticks = extended - p_handle->last_capture;
+        }
+
+        p_handle->last_capture = extended;
+        p_handle->capture_count++;
+
+        // a missed capture is not recoverable, just clear the overcapture flag
+        p_TIMx->SR = ~(TIMx_SR_CC1OF_FLAG << channel);
+    }
+
+    if (p_TIMx->SR & TIMx_SR_UIF_FLAG)
+    {
+        p_TIMx->SR = ~TIMx_SR_UIF_FLAG;
+        p_handle->overflow_count++;
+    }
+}
+
+void TIMx_PWM_Input_Init(TIMx_Capture_Handle_t * p_handle, 
+                         TIMx_Input_Capture_Initialization_Data_t * p_init_data)
+{
+    volatile TIMx_t * p_TIMx = p_handle->p_TIMx;
+
+    p_handle->channel = TIMx_CHANNEL_1;
+
+    TIMx_Init_Capture_Time_Base(p_handle, p_init_data->tick_Hz);
+
+    p_TIMx->CCER &= ~(TIMx_CCER_CC1E_FLAG | TIMx_CCER_CC2E_FLAG);
+
+    // both channels capture TI1, channel 1 directly and channel 2 indirectly
+    TIMx_Set_Channel_Mode(p_TIMx, TIMx_CHANNEL_1,
+                          (TIMx_CCMR1_CC1S_INPUT_MAP_TI1 << TIMx_CCMR1_CC1S_SHIFT_AMT) |
+                          (p_init_data->prescaler << TIMx_CCMR1_IC1PSC_SHIFT_AMT) |
+                          (p_init_data->filter << TIMx_CCMR1_IC1F_SHIFT_AMT));
+
+    TIMx_Set_Channel_Mode(p_TIMx, TIMx_CHANNEL_2,
+                          (TIMx_CCMR1_CC1S_INPUT_MAP_TI2 << TIMx_CCMR1_CC1S_SHIFT_AMT) |
+                          (p_init_data->prescaler << TIMx_CCMR1_IC1PSC_SHIFT_AMT) |
+                          (p_init_data->filter << TIMx_CCMR1_IC1F_SHIFT_AMT));
+
+    // channel 1 captures the period edge, channel 2 the opposite edge
+    if (p_init_data->edge == TIMx_CAPTURE_FALLING_EDGE)
+    {
+        p_TIMx->CCER |= TIMx_CCER_CC1P_FLAG;
+        p_TIMx->CCER &= ~TIMx_CCER_CC2P_FLAG;
+    }
+    else
+    {
+        p_TIMx->CCER &= ~TIMx_CCER_CC1P_FLAG;
+        p_TIMx->CCER |= TIMx_CCER_CC2P_FLAG;
+    }
+
+    // the period edge (TI1FP1) resets the counter
+    p_TIMx->SMCR &= ~((THREE_BIT_MASK << TIMx_CR2_SMCR_TS_SHIFT_AMT) | 
+                      (THREE_BIT_MASK << TIMx_CR2_SMCR_SMS_SHIFT_AMT));
+    p_TIMx->SMCR |= (TIMx_CR2_SMCR_TS_FILTERED_TIMER_INPUT_1 << TIMx_CR2_SMCR_TS_SHIFT_AMT) |
+                    (TIMx_CR2_SMCR_SMS_RESET_MODE << TIMx_CR2_SMCR_SMS_SHIFT_AMT);
+
+    p_TIMx->CCER |= TIMx_CCER_CC1E_FLAG | TIMx_CCER_CC2E_FLAG;
+
+    p_TIMx->DIER |= TIMx_DIER_CC1IE_FLAG | TIMx_DIER_CC2IE_FLAG | TIMx_DIER_UIE_FLAG;
+}
+
+void TIMx_PWM_Input_IRQ_Handler(TIMx_Capture_Handle_t * p_handle)
+{
+    volatile TIMx_t * p_TIMx = p_handle->p_TIMx;
+
+    if (p_TIMx->SR & TIMx_SR_CC2IF_FLAG)
+    {
+        // the counter was reset at the start of the period, so the pulse
+        // width is just the extended capture
+        const uint32_t capture = p_TIMx->CCR2;
+
+        p_handle->pulse_ticks = TIMx_Extend_Capture(p_handle, capture, p_TIMx->SR);
+    }
+
+    if (p_TIMx->SR & TIMx_SR_CC1IF_FLAG)
+    {
+        const uint32_t capture = p_TIMx->CCR1;
+        uint32_t overflow_count = p_handle->overflow_count;
+
+        // the counter was just reset, so a pending overflow must belong to
+        // the period which has ended
+        if (p_TIMx->SR & TIMx_SR_UIF_FLAG)
+        {
+            p_TIMx->SR = ~TIMx_SR_UIF_FLAG;
+            overflow_count++;
+        }
+
+        p_handle->period_ticks   = (overflow_count << TIMx_COUNTER_BITS) | capture;
+        p_handle->overflow_count = 0u;
+        p_handle->capture_count++;
+
+        p_TIMx->SR = ~(TIMx_SR_CC1OF_FLAG | TIMx_SR_CC2OF_FLAG);
+    }
+
+    if (p_TIMx->SR & TIMx_SR_UIF_FLAG)
+    {
+        p_TIMx->SR = ~TIMx_SR_UIF_FLAG;
+        p_handle->overflow_count++;
+    }
+}
+
+uint32_t TIMx_Capture_Get_Frequency_Hz(TIMx_Capture_Handle_t * p_handle)
+{
+    const uint32_t period_ticks = p_handle->period_ticks;
+
+    if (period_ticks == 0u)
+    {
+        return 0u;
+    }
+
+    // round to the nearest Hz
+    return (p_handle->tick_Hz + (period_ticks / 2u)) / period_ticks;
+}
+
+uint32_t TIMx_Capture_Get_Duty_Permille(TIMx_Capture_Handle_t * p_handle)
+{
+    const uint32_t period_ticks = p_handle->period_ticks;
+
+    if (period_ticks == 0u)
+    {
+        return 0u;
+    }
+
+    return (uint32_t)(((uint64_t)p_handle->pulse_ticks * 1000u) / period_ticks);
+}
+
+bool TIMx_Input_Capture_Start_DMA(TIMx_Capture_Handle_t * p_handle, 
+                                  uint16_t * p_timestamps,
+                                  uint32_t num_timestamps,
+                                  bool circular)
+{
+    volatile TIMx_t * p_TIMx = p_handle->p_TIMx;
+    const TIMx_Channel_enum channel = p_handle->channel;
+    const DMA_Channel_enum DMA_channel = TIMx_capture_compare_DMA_channels[TIMx_Get_Index(p_TIMx)][channel];
+
+    if (DMA_channel == DMA_CHANNEL_NONE)
+    {
+        return false;
+    }
+
+    // the DMA reads the capture register, which clears the flag instead
+    p_TIMx->DIER &= ~(TIMx_DIER_CC1IE_FLAG << channel);
+
+    DMA_Channel_Initialization_Data_t DMA_init_data =
+    {
+        TIMx_Get_CCR(p_TIMx, channel),
+        p_timestamps,
+        num_timestamps,
+        DMA_CCR_SIZE_16_BITS,
+        DMA_CCR_PL_HIGH,
+        DMA_CCR_MINC_FLAG | (circular ? DMA_CCR_CIRC_FLAG : 0u)
+    };
+
+    DMA_Channel_Init(DMA_channel, &DMA_init_data);
+
+    p_TIMx->DIER |= TIMx_DIER_CC1DE_FLAG << channel;
+
+    return true;
+}
+
+void TIMx_Encoder_Init(TIMx_Encoder_Handle_t * p_handle, 
+                       TIMx_Encoder_Initialization_Data_t * p_init_data)
+{
+    volatile TIMx_t * p_TIMx = p_handle->p_TIMx;
+
+    TIMx_Stop(p_TIMx);
+
+    // the encoder inputs clock the counter directly, over the full 16 bits
+    p_TIMx->PSC = 0u;
+    p_TIMx->ARR = TIMx_MAX_COUNT;
+    p_TIMx->CR1 &= ~(TWO_BIT_MASK << TIMx_CR1_CMS_SHIFT_AMT);
+    p_TIMx->CR1 |= TIMx_CR1_URS_FLAG;
+
+    p_TIMx->CCER &= ~(TIMx_CCER_CC1E_FLAG | TIMx_CCER_CC2E_FLAG | 
+                      TIMx_CCER_CC1P_FLAG | TIMx_CCER_CC2P_FLAG);
+
+    // IC1 on TI1 (A) and IC2 on TI2 (B)
+    TIMx_Set_Channel_Mode(p_TIMx, TIMx_CHANNEL_1,
+                          (TIMx_CCMR1_CC1S_INPUT_MAP_TI1 << TIMx_CCMR1_CC1S_SHIFT_AMT) |
+                          (p_init_data->filter << TIMx_CCMR1_IC1F_SHIFT_AMT));
+
+    TIMx_Set_Channel_Mode(p_TIMx, TIMx_CHANNEL_2,
+                          (TIMx_CCMR1_CC1S_INPUT_MAP_TI1 << TIMx_CCMR1_CC1S_SHIFT_AMT) |
+                          (p_init_data->filter << TIMx_CCMR1_IC1F_SHIFT_AMT));
+
+    // inverting one input reverses the count direction
+    if (p_init_data->invert_direction)
+    {
+        p_TIMx->CCER |= TIMx_CCER_CC1P_FLAG;
+    }
+
+    p_TIMx->SMCR &= ~(THREE_BIT_MASK << TIMx_CR2_SMCR_SMS_SHIFT_AMT);
+    p_TIMx->SMCR |= p_init_data->mode << TIMx_CR2_SMCR_SMS_SHIFT_AMT;
+
+    p_TIMx->EGR = TIMx_EGR_UG_FLAG;
+    p_TIMx->SR  = 0u;
+
+    p_handle->sample_period_mSec = p_init_data->sample_period_mSec;
+
+    TIMx_Encoder_Reset_Position(p_handle);
+
+    p_TIMx->DIER |= TIMx_DIER_UIE_FLAG;
+}
+
+void TIMx_Encoder_IRQ_Handler(TIMx_Encoder_Handle_t * p_handle)
+{
+    volatile TIMx_t * p_TIMx = p_handle->p_TIMx;
+
+    if (p_TIMx->SR & TIMx_SR_UIF_FLAG)
+    {
+        p_TIMx->SR = ~TIMx_SR_UIF_FLAG;
+
+        // DIR may have changed since the wrap if the encoder is dithering,
+        // which side of the count it is on now is reliable
+        if (p_TIMx->CNT < TIMx_HALF_COUNT)
+        {
+            p_handle->wrap_count++;
+        }
+        else
+        {
+            p_handle->wrap_count--;
+        }
+    }
+}
+
+int32_t TIMx_Encoder_Get_Position(TIMx_Encoder_Handle_t * p_handle)
+{
+    volatile TIMx_t * p_TIMx = p_handle->p_TIMx;
+    int32_t  wrap_count;
+    uint32_t count;
+    uint32_t pending;
+
+    // retry if the handler ran, or a wrap happened, while reading
+    do
+    {
+        wrap_count = p_handle->wrap_count;
+        pending    = p_TIMx->SR & TIMx_SR_UIF_FLAG;
+        count      = p_TIMx->CNT;
+    } while ((wrap_count != p_handle->wrap_count) || 
+             (pending != (p_TIMx->SR & TIMx_SR_UIF_FLAG)));
+
+    // a wrap which the handler has not counted yet
+    if (pending)
+    {
+        wrap_count += (count < TIMx_HALF_COUNT) ? 1 : -1;
+    }
+
+    return (int32_t)(((uint32_t)wrap_count << TIMx_COUNTER_BITS) | count);
+}
+
+void TIMx_Encoder_Reset_Position(TIMx_Encoder_Handle_t * p_handle)
+{
+    p_handle->p_TIMx->CNT = 0u;
+    p_handle->p_TIMx->SR  = ~TIMx_SR_UIF_FLAG;
+
+    p_handle->wrap_count              = 0;
+    p_handle->last_position           = 0;
+    p_handle->velocity_counts_per_sec = 0;
+}
+
+int32_t TIMx_Encoder_Sample(TIMx_Encoder_Handle_t * p_handle)
+{
+    const int32_t position = TIMx_Encoder_Get_Position(p_handle);
+
+    // wrapping subtraction keeps the difference correct across 2^31
+    const int32_t delta = (int32_t)((uint32_t)position - (uint32_t)p_handle->last_position);
+
+    p_handle->last_position = position;
+
+    if (p_handle->sample_period_mSec != 0u)
+    {
+        p_handle->velocity_counts_per_sec = (int32_t)(((int64_t)delta * 1000) / 
+                                                      (int64_t)p_handle->sample_period_mSec);
+    }
+
+    return p_handle->velocity_counts_per_sec;
+}
+
+int32_t TIMx_Encoder_Get_Velocity(TIMx_Encoder_Handle_t * p_handle)
+{
+    return p_handle->velocity_counts_per_sec;
+}
+
+void TIMx_Cascade_Init(TIMx_Cascade_Handle_t * p_handle, uint32_t tick_Hz)
+{
+    volatile TIMx_t * p_low  = p_handle->p_TIMx_low;
+    volatile TIMx_t * p_high = p_handle->p_TIMx_high;
+
+    TIMx_Stop(p_low);
+    TIMx_Stop(p_high);
+
+    p_handle->tick_Hz = TIMx_Set_Tick_Rate(p_low, tick_Hz);
+    p_high->PSC = 0u;
+
+    p_low->ARR  = TIMx_MAX_COUNT;
+    p_high->ARR = TIMx_MAX_COUNT;
+
+    p_low->CR1  &= ~((TWO_BIT_MASK << TIMx_CR1_CMS_SHIFT_AMT) | TIMx_CR1_DIR_FLAG);
+    p_high->CR1 &= ~((TWO_BIT_MASK << TIMx_CR1_CMS_SHIFT_AMT) | TIMx_CR1_DIR_FLAG);
+
+    // each overflow of the low timer clocks the high timer once
+    TIMx_Set_Master_Mode(p_low, TIMx_CR2_MMS_UPDATE);
+    TIMx_Set_Slave_Mode(p_high, p_low, TIMx_CR2_SMCR_SMS_EXT_CLOCK_MODE_1);
+
+    // load the prescalers, then clear any count the forced update caused
+    p_high->EGR = TIMx_EGR_UG_FLAG;
+    p_low->EGR  = TIMx_EGR_UG_FLAG;
+    p_high->CNT = 0u;
+    p_low->CNT  = 0u;
+    p_high->SR  = 0u;
+    p_low->SR   = 0u;
+}
+
+void TIMx_Cascade_Start(TIMx_Cascade_Handle_t * p_handle)
+{
+    // the high timer only counts when clocked, so it can be enabled first
+    TIMx_Start(p_handle->p_TIMx_high);
+    TIMx_Start(p_handle->p_TIMx_low);
+}
+
+uint32_t TIMx_Cascade_Get_Count(TIMx_Cascade_Handle_t * p_handle)
+{
+    uint32_t high;
+    uint32_t low;
+
+    do
+    {
+        high = p_handle->p_TIMx_high->CNT;
+        low  = p_handle->p_TIMx_low->CNT;
+    } while (high != p_handle->p_TIMx_high->CNT);
+
+    if (low < TIMx_CASCADE_CARRY_WINDOW)
+    {
+        // the low half has just wrapped, and both reads of the high half may have
+        // come before its carry reached the high timer. Read the high half again
+        // once the carry has landed, the next carry is 2^16 ticks away
+        for (uint32_t i = 0u; i < TIMx_CASCADE_CARRY_READS; i++)
+        {
+            high = p_handle->p_TIMx_high->CNT;
+        }
+    }
+
+    return (high << TIMx_COUNTER_BITS) | low;
+}
+
+void TIMx_Sync_Init(volatile TIMx_t * p_master, 
+                    volatile TIMx_t * const * pp_slaves, 
+                    uint32_t num_slaves)
+{
+    TIMx_Stop(p_master);
+    TIMx_Set_Master_Mode(p_master, TIMx_CR2_MMS_ENABLE);
+
+    // delay the master by the slaves' trigger synchronization
+    p_master->SMCR |= TIMx_SMCR_MSM_FLAG;
+    p_master->CNT = 0u;
+
+    for (uint32_t i = 0u; i < num_slaves; i++)
+    {
+        volatile TIMx_t * p_slave = pp_slaves[i];
+
+        TIMx_Stop(p_slave);
+        TIMx_Set_Slave_Mode(p_slave, p_master, TIMx_CR2_SMCR_SMS_GATED_MODE);
+        p_slave->CNT = 0u;
+
+        // gated, so the slave only counts while the master is enabled
+        TIMx_Start(p_slave);
+    }
+}
+
+bool TIMx_Burst_Start(volatile TIMx_t * p_TIMx, TIMx_Burst_Initialization_Data_t * p_init_data)
+{
+    const DMA_Channel_enum DMA_channel = TIMx_update_DMA_channels[TIMx_Get_Index(p_TIMx)];
+
+    // ARR and RCR come before CCR1, so they are simply the front of the burst
+    const uint32_t first_register = p_init_data->include_period ? TIMx_DCR_DBA(ARR) : TIMx_DCR_DBA(CCR1);
+    const uint32_t burst_length   = (p_init_data->include_period ? 2u : 0u) + p_init_data->num_channels;
+    const uint32_t num_transfers  = burst_length * p_init_data->num_entries;
+
+    if ((burst_length == 0u) || (num_transfers > TIMx_MAX_DMA_TRANSFERS))
+    {
+        return false;
+    }
+
+    TIMx_Burst_Stop(p_TIMx);
+
+    p_TIMx->DCR = ((burst_length - 1u) << TIMx_DCR_DBL_SHIFT_AMT) | 
+                  (first_register << TIMx_DCR_DBA_SHIFT_AMT);
+
+    // each update request makes DMA write burst_length values into DMAR,
+    // which the timer redirects to the registers in turn
+    DMA_Channel_Initialization_Data_t DMA_init_data =
+    {
+        &p_TIMx->DMAR,
+        (volatile void *)p_init_data->p_table,
+        num_transfers,
+        DMA_CCR_SIZE_16_BITS,
+        DMA_CCR_PL_HIGH,
+        DMA_CCR_DIR_FLAG | DMA_CCR_MINC_FLAG | (p_init_data->circular ? DMA_CCR_CIRC_FLAG : 0u)
+    };
+
+    DMA_Channel_Init(DMA_channel, &DMA_init_data);
+
+    p_TIMx->DIER |= TIMx_DIER_UDE_FLAG;
+
+    return true;
+}
+
+void TIMx_Burst_Stop(volatile TIMx_t * p_TIMx)
+{
+    p_TIMx->DIER &= ~TIMx_DIER_UDE_FLAG;
+
+    DMA_Channel_Disable(TIMx_update_DMA_channels[TIMx_Get_Index(p_TIMx)]);
+}
+
+bool TIMx_Burst_Is_Done(volatile TIMx_t * p_TIMx)
+{
+    return (DMA_Channel_Get_Remaining(TIMx_update_DMA_channels[TIMx_Get_Index(p_TIMx)]) == 0u);
+}
+
+bool TIMx_One_Pulse_Init(volatile TIMx_t * p_TIMx, TIMx_One_Pulse_Initialization_Data_t * p_init_data)
+{
+    const uint32_t clock_Hz = TIMx_Get_Clock_Hz(p_TIMx);
+    const TIMx_Channel_enum channel = p_init_data->channel;
+
+    uint64_t total_ticks = TIMx_nSec_To_Ticks(clock_Hz, (uint64_t)p_init_data->delay_nSec + 
+                                                        p_init_data->width_nSec);
+
+    if (total_ticks < 2u)
+    {
+        total_ticks = 2u;
+    }
+
+    // the smallest prescaler which fits the delay and width in the counter
+    const uint64_t prescaler = (total_ticks - 1u) / (TIMx_MAX_COUNT + 1u);
+
+    if (prescaler > TIMx_MAX_COUNT)
+    {
+        return false;
+    }
+
+    const uint32_t tick_Hz = clock_Hz / ((uint32_t)prescaler + 1u);
+    uint32_t delay_ticks = (uint32_t)TIMx_nSec_To_Ticks(tick_Hz, p_init_data->delay_nSec);
+    uint32_t width_ticks = (uint32_t)TIMx_nSec_To_Ticks(tick_Hz, p_init_data->width_nSec);
+
+    // a zero compare would leave the output active while stopped
+    if (delay_ticks == 0u)
+    {
+        delay_ticks = 1u;
+    }
+
+    if (width_ticks == 0u)
+    {
+        width_ticks = 1u;
+    }
+
+    // rounding may take the total one tick past the counter
+    if ((delay_ticks + width_ticks) > (TIMx_MAX_COUNT + 1u))
+    {
+        width_ticks = (TIMx_MAX_COUNT + 1u) - delay_ticks;
+    }
+
+    TIMx_Stop(p_TIMx);
+
+    p_TIMx->CR1 &= ~((TWO_BIT_MASK << TIMx_CR1_CMS_SHIFT_AMT) | TIMx_CR1_DIR_FLAG);
+    p_TIMx->CR1 |= TIMx_CR1_OPM_FLAG;
+
+    p_TIMx->PSC = (uint32_t)prescaler;
+    p_TIMx->ARR = delay_ticks + width_ticks - 1u;
+
+    p_TIMx->CCER &= ~(TIMx_CCER_CC1E_FLAG << (channel * TIMx_CCER_CHANNEL_WIDTH));
+
+    // PWM mode 2 is inactive below the compare value and active from it up to
+    // the end of the period, where the counter stops
+    TIMx_Set_Channel_Mode(p_TIMx, channel,
+                          (TIMx_CCMR1_CC1S_OUTPUT << TIMx_CCMR1_CC1S_SHIFT_AMT) |
+                          (TIMx_CCMR1_OC1M_PWM_MODE_2 << TIMx_CCMR1_OC1M_SHIFT_AMT));
+
+    *TIMx_Get_CCR(p_TIMx, channel) = delay_ticks;
+
+    p_TIMx->SMCR &= ~((THREE_BIT_MASK << TIMx_CR2_SMCR_TS_SHIFT_AMT) | 
+                      (THREE_BIT_MASK << TIMx_CR2_SMCR_SMS_SHIFT_AMT));
+
+    if (p_init_data->trigger != TIMx_ONE_PULSE_SOFTWARE_TRIGGER)
+    {
+        const TIMx_Channel_enum trigger_channel = (p_init_data->trigger == TIMx_ONE_PULSE_TI1_TRIGGER) ? 
+                                                  TIMx_CHANNEL_1 : TIMx_CHANNEL_2;
+        const uint32_t ccer_shift = trigger_channel * TIMx_CCER_CHANNEL_WIDTH;
+
+        // the trigger channel is an input on its own pin, only its filter
+        // and edge are used, it does not need to be enabled
+        TIMx_Set_Channel_Mode(p_TIMx, trigger_channel,
+                              (TIMx_CCMR1_CC1S_INPUT_MAP_TI1 << TIMx_CCMR1_CC1S_SHIFT_AMT) |
+                              (p_init_data->trigger_filter << TIMx_CCMR1_IC1F_SHIFT_AMT));
+
+        if (p_init_data->trigger_edge == TIMx_CAPTURE_FALLING_EDGE)
+        {
+            p_TIMx->CCER |= TIMx_CCER_CC1P_FLAG << ccer_shift;
+        }
+        else
+        {
+            p_TIMx->CCER &= ~(TIMx_CCER_CC1P_FLAG << ccer_shift);
+        }
+
+        // the trigger edge sets CEN
+        p_TIMx->SMCR |= ((trigger_channel == TIMx_CHANNEL_1) ? TIMx_CR2_SMCR_TS_FILTERED_TIMER_INPUT_1 : 
+                                                               TIMx_CR2_SMCR_TS_FILTERED_TIMER_INPUT_2)
+                        << TIMx_CR2_SMCR_TS_SHIFT_AMT;
+        p_TIMx->SMCR |= TIMx_CR2_SMCR_SMS_TRIGGER_MODE << TIMx_CR2_SMCR_SMS_SHIFT_AMT;
+    }
+
+    // load the prescaler now, the update flag is not used
+    p_TIMx->EGR = TIMx_EGR_UG_FLAG;
+    p_TIMx->SR  = 0u;
+
+    TIMx_Enable_Output(p_TIMx, channel, p_init_data->polarity);
+
+    return true;
+}
+
+void TIMx_One_Pulse_Trigger(volatile TIMx_t * p_TIMx)
+{
+    TIMx_Start(p_TIMx);
+}
+
+bool TIMx_One_Pulse_Is_Busy(volatile TIMx_t * p_TIMx)
+{
+    // cleared by hardware at the end of the pulse
+    return ((p_TIMx->CR1 & TIMx_CR1_CEN_FLAG) != 0u);
+}
+
+bool TIMx_Set_Dead_Time(volatile TIMx_t * p_TIMx, uint32_t dead_time_nSec)
+{
+    const uint32_t clock_Hz = TIMx_Get_Clock_Hz(p_TIMx);
+
+    // try the undivided clock first, for the finest steps
+    for (uint32_t ckd_shift = 0u; ckd_shift <= TIMx_MAX_CKD_SHIFT; ckd_shift++)
+    {
+        const uint64_t DTS_Hz = clock_Hz >> ckd_shift;
+
+        // round up, a short dead time risks shoot-through
+        const uint64_t ticks = ((DTS_Hz * dead_time_nSec) + (TIMx_NSEC_PER_SEC - 1u)) / TIMx_NSEC_PER_SEC;
+        uint32_t DTG;
+
+        if ((ticks <= UINT32_MAX) && TIMx_Encode_Dead_Time((uint32_t)ticks, &DTG))
+        {
+            // CKD values 0, 1 and 2 divide by 1, 2 and 4
+            p_TIMx->CR1 &= ~(TWO_BIT_MASK << TIMx_CR1_CKD_SHIFT_AMT);
+            p_TIMx->CR1 |= ckd_shift << TIMx_CR1_CKD_SHIFT_AMT;
+
+            p_TIMx->BDTR &= ~(TIMx_BDTR_DTG_MASK << TIMx_BDTR_DTG_SHIFT_AMT);
+            p_TIMx->BDTR |= DTG << TIMx_BDTR_DTG_SHIFT_AMT;
+
+            return true;
+        }
+    }
+
+    return false;
+}
+
+void TIMx_PWM_Complementary_Channel_Init(volatile TIMx_t * p_TIMx,
+                                         TIMx_Channel_enum channel,
+                                         TIMx_Output_Polarity_enum polarity,
+                                         TIMx_Output_Polarity_enum complementary_polarity,
+                                         uint32_t duty_counts)
+{
+    const uint32_t ccer_shift = channel * TIMx_CCER_CHANNEL_WIDTH;
+
+    // OISx and OISxN pairs, two bits per channel
+    const uint32_t cr2_shift = channel * 2u;
+
+    // disable both outputs while changing their mode
+    p_TIMx->CCER &= ~((TIMx_CCER_CC1E_FLAG | TIMx_CCER_CC1NE_FLAG | 
+                       TIMx_CCER_CC1P_FLAG | TIMx_CCER_CC1NP_FLAG) << ccer_shift);
+
+    // output, PWM mode 1, with the compare register preloaded
+    TIMx_Set_Channel_Mode(p_TIMx, channel,
+                          (TIMx_CCMR1_CC1S_OUTPUT << TIMx_CCMR1_CC1S_SHIFT_AMT) |
+                          (TIMx_CCMR1_OC1M_PWM_MODE_1 << TIMx_CCMR1_OC1M_SHIFT_AMT) |
+                          TIMx_CCMR1_OC1PE_FLAG);
+
+    *TIMx_Get_CCR(p_TIMx, channel) = duty_counts;
+
+    // idle levels are the physical output levels, so match them to the
+    // inactive levels
+    p_TIMx->CR2 &= ~((TIMx_CR2_OIS1_FLAGS | TIMx_CR2_OIS1N_FLAGS) << cr2_shift);
+
+    if (polarity == TIMx_OUTPUT_ACTIVE_LOW)
+    {
+        p_TIMx->CR2  |= TIMx_CR2_OIS1_FLAGS << cr2_shift;
+        p_TIMx->CCER |= TIMx_CCER_CC1P_FLAG << ccer_shift;
+    }
+
+    if (complementary_polarity == TIMx_OUTPUT_ACTIVE_LOW)
+    {
+        p_TIMx->CR2  |= TIMx_CR2_OIS1N_FLAGS << cr2_shift;
+        p_TIMx->CCER |= TIMx_CCER_CC1NP_FLAG << ccer_shift;
+    }
+
+    // drive disabled outputs to their inactive levels instead of floating
+    p_TIMx->BDTR |= TIMx_BDTR_OSSR_FLAG | TIMx_BDTR_OSSI_FLAG;
+
+    p_TIMx->CCER |= (TIMx_CCER_CC1E_FLAG | TIMx_CCER_CC1NE_FLAG) << ccer_shift;
+}
+
+void TIMx_Break_Init(volatile TIMx_t * p_TIMx, 
+                     TIMx_Output_Polarity_enum break_polarity, 
+                     bool auto_restart)
+{
+    p_TIMx->BDTR &= ~(TIMx_BDTR_BKP_FLAG | TIMx_BDTR_AOE_FLAG);
+
+    if (break_polarity == TIMx_OUTPUT_ACTIVE_HIGH)
+    {
+        p_TIMx->BDTR |= TIMx_BDTR_BKP_FLAG;
+    }
+
+    if (auto_restart)
+    {
+        p_TIMx->BDTR |= TIMx_BDTR_AOE_FLAG;
+    }
+
+    p_TIMx->BDTR |= TIMx_BDTR_BKE_FLAG;
+
+    p_TIMx->SR    = ~TIMx_SR_BIF_FLAG;
+    p_TIMx->DIER |= TIMx_DIER_BIE_FLAG;
+}
+
+bool TIMx_Break_Is_Active(volatile TIMx_t * p_TIMx)
+{
+    return ((p_TIMx->SR & TIMx_SR_BIF_FLAG) != 0u);
+}
+
+bool TIMx_Break_Clear(volatile TIMx_t * p_TIMx)
+{
+    p_TIMx->SR = ~TIMx_SR_BIF_FLAG;
+
+    TIMx_Set_Main_Output_Enable(p_TIMx, true);
+
+    // the break input holds MOE clear while it is active
+    return ((p_TIMx->BDTR & TIMx_BDTR_MOE_FLAG) != 0u);
+}
+
+void TIMx_Set_Main_Output_Enable(volatile TIMx_t * p_TIMx, bool enable)
+{
+    if (enable)
+    {
+        p_TIMx->BDTR |= TIMx_BDTR_MOE_FLAG;
+    }
+    else
+    {
+        p_TIMx->BDTR &= ~TIMx_BDTR_MOE_FLAG;
+    }
+}
+
+void TIMx_Set_Repetition_Count(volatile TIMx_t * p_TIMx, uint32_t num_periods)
+{
+    if (num_periods == 0u)
+    {
+        num_periods = 1u;
+    }
+    else if (num_periods > TIMx_MAX_REPETITIONS)
+    {
+        num_periods = TIMx_MAX_REPETITIONS;
+    }
+
+    p_TIMx->RCR = num_periods - 1u;
+}
+
+bool TIMx_Three_Phase_Init(volatile TIMx_t * p_TIMx, TIMx_Three_Phase_Initialization_Data_t * p_init_data)
+{
+    TIMx_PWM_Initialization_Data_t PWM_init_data =
+    {
+        p_init_data->frequency_Hz,
+        p_init_data->alignment
+    };
+
+    TIMx_PWM_Init(p_TIMx, &PWM_init_data);
+
+    // keep the bridge off until the application is ready
+    TIMx_Set_Main_Output_Enable(p_TIMx, false);
+
+    if (!TIMx_Set_Dead_Time(p_TIMx, p_init_data->dead_time_nSec))
+    {
+        return false;
+    }
+
+    const uint32_t half_duty_counts = TIMx_PWM_Get_Period_Counts(p_TIMx) / 2u;
+
+    for (uint32_t phase = 0u; phase < TIMx_NUM_PHASES; phase++)
+    {
+        TIMx_PWM_Complementary_Channel_Init(p_TIMx, 
+                                            (TIMx_Channel_enum)phase, 
+                                            p_init_data->high_side_polarity, 
+                                            p_init_data->low_side_polarity, 
+                                            half_duty_counts);
+    }
+
+    return true;
+}
+
+void TIMx_Three_Phase_Set_Duty(volatile TIMx_t * p_TIMx, 
+                               uint32_t duty_a_counts, 
+                               uint32_t duty_b_counts, 
+                               uint32_t duty_c_counts)
+{
+    p_TIMx->CCR1 = duty_a_counts;
+    p_TIMx->CCR2 = duty_b_counts;
+    p_TIMx->CCR3 = duty_c_counts;
+}
+
+bool TIMx_Six_Step_Init(volatile TIMx_t * p_TIMx, TIMx_Three_Phase_Initialization_Data_t * p_init_data)
+{
+    static const TIMx_Phase_State_enum all_off[TIMx_NUM_PHASES] =
+    {
+        TIMx_PHASE_OFF, TIMx_PHASE_OFF, TIMx_PHASE_OFF
+    };
+
+    if (!TIMx_Three_Phase_Init(p_TIMx, p_init_data))
+    {
+        return false;
+    }
+
+    // preload the channel enables and modes until a commutation event
+    p_TIMx->CR2 |= TIMx_CR2_CCPC_FLAGS;
+
+    TIMx_Six_Step_Stage(p_TIMx, all_off);
+    TIMx_Six_Step_Commutate(p_TIMx);
+
+    return true;
+}
+
+void TIMx_Six_Step_Set_Step(volatile TIMx_t * p_TIMx, uint32_t step)
+{
+    TIMx_Six_Step_Stage(p_TIMx, TIMx_six_step_phases[step % TIMx_NUM_SIX_STEPS]);
+}
+
+void TIMx_Six_Step_Commutate(volatile TIMx_t * p_TIMx)
+{
+    p_TIMx->EGR = TIMx_EGR_COMG_FLAG;
+}
+
+/*
+--|----------------------------------------------------------------------------|
+--| PRIVATE HELPER FUNCTION DEFINITIONS
+--|----------------------------------------------------------------------------|
+*/
+
+static uint32_t TIMx_Get_Clock_Hz(volatile TIMx_t * p_TIMx)
+{
+    if (p_TIMx == TIM1)
+    {
+        // TIM1 is on APB2, the others are on APB1
+        return CLOCK_TREE_TIM1_CLK_HZ;
+    }
+    else if (p_TIMx == TIM2)
+    {
+        return CLOCK_TREE_TIM2_CLK_HZ;
+    }
+    else if (p_TIMx == TIM3)
+    {
+        return CLOCK_TREE_TIM3_CLK_HZ;
+    }
+    else
+    {
+        return CLOCK_TREE_TIM4_CLK_HZ;
+    }
+}
+
+static uint32_t TIMx_Get_Index(volatile TIMx_t * p_TIMx)
+{
+    if (p_TIMx == TIM1)
+    {
+        return 0u;
+    }
+    else if (p_TIMx == TIM2)
+    {
+        return 1u;
+    }
+    else if (p_TIMx == TIM3)
+    {
+        return 2u;
+    }
+    else
+    {
+        return 3u;
+    }
+}
+
+static uint32_t TIMx_Set_Tick_Rate(volatile TIMx_t * p_TIMx, uint32_t tick_Hz)
+{
+    const uint32_t clock_Hz = TIMx_Get_Clock_Hz(p_TIMx);
+
+    // round to the nearest prescaler
+    uint32_t divider = (clock_Hz + (tick_Hz / 2u)) / tick_Hz;
+
+    if (divider == 0u)
+    {
+        divider = 1u;
+    }
+    else if (divider > (TIMx_MAX_COUNT + 1u))
+    {
+        divider = TIMx_MAX_COUNT + 1u;
+    }
+
+    p_TIMx->PSC = divider - 1u;
+
+    return clock_Hz / divider;
+}
+
+static void TIMx_Init_Capture_Time_Base(TIMx_Capture_Handle_t * p_handle, uint32_t tick_Hz)
+{
+    volatile TIMx_t * p_TIMx = p_handle->p_TIMx;
+
+    TIMx_Stop(p_TIMx);
+
+    p_handle->tick_Hz = TIMx_Set_Tick_Rate(p_TIMx, tick_Hz);
+
+    // free running, counting up over the full 16 bits
+    p_TIMx->CR1 &= ~((TWO_BIT_MASK << TIMx_CR1_CMS_SHIFT_AMT) | TIMx_CR1_DIR_FLAG);
+    p_TIMx->ARR = TIMx_MAX_COUNT;
+
+    // only overflows set the update flag, not forced updates or slave resets
+    p_TIMx->CR1 |= TIMx_CR1_URS_FLAG;
+
+    // load the prescaler now
+    p_TIMx->EGR = TIMx_EGR_UG_FLAG;
+    p_TIMx->SR  = 0u;
+
+    p_handle->overflow_count = 0u;
+    p_handle->last_capture   = 0u;
+    p_handle->period_ticks   = 0u;
+    p_handle->pulse_ticks    = 0u;
+    p_handle->capture_count  = 0u;
+}
+
+static uint32_t TIMx_Extend_Capture(TIMx_Capture_Handle_t * p_handle, uint32_t capture, uint32_t status)
+{
+    uint32_t overflow_count = p_handle->overflow_count;
+
+    if ((status & TIMx_SR_UIF_FLAG) && (capture < TIMx_HALF_COUNT))
+    {
+        overflow_count++;
+    }
+
+    return (overflow_count << TIMx_COUNTER_BITS) | capture;
+}
+
+static void TIMx_Set_Master_Mode(volatile TIMx_t * p_TIMx, TIMx_CR2_MMS_MASKS_enum mode)
+{
+    p_TIMx->CR2 &= ~(THREE_BIT_MASK << TIMx_CR2_MMS_SHIFT_AMT);
+    p_TIMx->CR2 |= mode << TIMx_CR2_MMS_SHIFT_AMT;
+}
+
+static void TIMx_Set_Slave_Mode(volatile TIMx_t * p_slave, 
+                                volatile TIMx_t * p_master, 
+                                TIMx_SMCR_SMS_MASKS_enum mode)
+{
+    const TIMx_SMCR_TS_MASKS_enum trigger = TIMx_internal_triggers[TIMx_Get_Index(p_slave)][TIMx_Get_Index(p_master)];
+
+    // the trigger must be selected while the slave mode is disabled
+    p_slave->SMCR &= ~((THREE_BIT_MASK << TIMx_CR2_SMCR_TS_SHIFT_AMT) | 
+                       (THREE_BIT_MASK << TIMx_CR2_SMCR_SMS_SHIFT_AMT));
+    p_slave->SMCR |= trigger << TIMx_CR2_SMCR_TS_SHIFT_AMT;
+    p_slave->SMCR |= mode << TIMx_CR2_SMCR_SMS_SHIFT_AMT;
+}
+
+static void TIMx_Enable_Output(volatile TIMx_t * p_TIMx, 
+                               TIMx_Channel_enum channel, 
+                               TIMx_Output_Polarity_enum polarity)
+{
+    const uint32_t ccer_shift = channel * TIMx_CCER_CHANNEL_WIDTH;
+
+    if (polarity == TIMx_OUTPUT_ACTIVE_LOW)
+    {
+        p_TIMx->CCER |= TIMx_CCER_CC1P_FLAG << ccer_shift;
+    }
+    else
+    {
+        p_TIMx->CCER &= ~(TIMx_CCER_CC1P_FLAG << ccer_shift);
+    }
+
+    p_TIMx->CCER |= TIMx_CCER_CC1E_FLAG << ccer_shift;
+
+    if (p_TIMx == TIM1)
+    {
+        // the advanced-control timer outputs are gated by the main output enable
+        p_TIMx->BDTR |= TIMx_BDTR_MOE_FLAG;
+    }
+}
+
+static uint64_t TIMx_nSec_To_Ticks(uint32_t tick_Hz, uint64_t time_nSec)
+{
+    return (((uint64_t)tick_Hz * time_nSec) + (TIMx_NSEC_PER_SEC / 2u)) / TIMx_NSEC_PER_SEC;
+}
+
+static bool TIMx_Encode_Dead_Time(uint32_t ticks, uint32_t * p_DTG)
+{
+    if (ticks <= 127u)
+    {
+        *p_DTG = ticks;
+    }
+    else if (ticks <= 254u)
+    {
+        *p_DTG = 0x80u | (((ticks + 1u) / 2u) - 64u);
+    }
+    else if (ticks <= 504u)
+    {
+        *p_DTG = 0xC0u | (((ticks + 7u) / 8u) - 32u);
+    }
+    else if (ticks <= 1008u)
+    {
+        *p_DTG = 0xE0u | (((ticks + 15u) / 16u) - 32u);
+    }
+    else
+    {
+        return false;
+    }
+
+    return true;
+}
+
+static void TIMx_Six_Step_Stage(volatile TIMx_t * p_TIMx, const TIMx_Phase_State_enum * p_phases)
+{
+    const uint32_t enable_flags = TIMx_CCER_CC1E_FLAG | TIMx_CCER_CC1NE_FLAG;
+    uint32_t ccer = p_TIMx->CCER;
+
+    for (uint32_t phase = 0u; phase < TIMx_NUM_PHASES; phase++)
+    {
+        const uint32_t ccer_shift = phase * TIMx_CCER_CHANNEL_WIDTH;
+
+        // forced inactive turns the high side off and, through the
+        // complementary output, the low side on
+        uint32_t mode = TIMx_CCMR1_OC1M_FORCE_INACTIVE_LEVEL;
+
+        ccer &= ~(enable_flags << ccer_shift);
+
+        if (p_phases[phase] == TIMx_PHASE_PWM)
+        {
+            mode = TIMx_CCMR1_OC1M_PWM_MODE_1;
+        }
+
+        if (p_phases[phase] != TIMx_PHASE_OFF)
+        {
+            ccer |= enable_flags << ccer_shift;
+        }
+
+        TIMx_Set_Channel_Mode(p_TIMx, (TIMx_Channel_enum)phase,
+                              (TIMx_CCMR1_CC1S_OUTPUT << TIMx_CCMR1_CC1S_SHIFT_AMT) |
+                              (mode << TIMx_CCMR1_OC1M_SHIFT_AMT) |
+                              TIMx_CCMR1_OC1PE_FLAG);
+    }
+
+    p_TIMx->CCER = ccer;
+}
+
+static vuint32_t * TIMx_Get_CCR(volatile TIMx_t * p_TIMx, TIMx_Channel_enum channel)
+{
+    return &p_TIMx->CCR1 + channel;
+}
+
+static void TIMx_Set_Channel_Mode(volatile TIMx_t * p_TIMx, TIMx_Channel_enum channel, uint32_t mode_bits)
+{
+    // channels 1 and 2 are in CCMR1, channels 3 and 4 are in CCMR2
+    vuint32_t * p_CCMR = (channel < TIMx_CHANNEL_3) ? &p_TIMx->CCMR1 : &p_TIMx->CCMR2;
+
+    const uint32_t shift = (channel & 1u) * TIMx_CCMR_CHANNEL_WIDTH;
+
+    *p_CCMR &= ~(EIGHT_BIT_MASK << shift);
+    *p_CCMR |= mode_bits << shift;
+}
@@ -0,0 +1,253 @@
+/*
+--|----------------------------------------------------------------------------|
+--| FILE DESCRIPTION:
+--|   PSP_Telemetry.c provides the implementation for the binary telemetry
+--|   stream.
+--|
+--|   Telemetry_Send encodes each record into a ring buffer of frames, and
+--|   Telemetry_Flush hands the longest contiguous run of frames to one
+--|   USART DMA write, releasing it from the ring buffer once the write is
+--|   done. Batching records into one write keeps the per record cost to
+--|   the encoding alone.
+--|
+--|----------------------------------------------------------------------------|
+--| REFERENCES:
+--|   Consistent Overhead Byte Stuffing, S. Cheshire and M. Baker, 1999
+--|
+--|----------------------------------------------------------------------------|
+*/
+
+/*
+--|----------------------------------------------------------------------------|
+--| INCLUDE FILES
+--|----------------------------------------------------------------------------|
+*/
+
+#include "PSP_CRC.h"
+#include "PSP_Telemetry.h"
+
+/*
+--|----------------------------------------------------------------------------|
+--| PRIVATE DEFINES
+--|----------------------------------------------------------------------------|
+*/
+
+/*
+--| NAME: TELEMETRY_MAX_RECORD_LENGTH
+--| DESCRIPTION: the most bytes in one record, before encoding
+--| TYPE: unsigned integer
+*/
+#define TELEMETRY_MAX_RECORD_LENGTH (TELEMETRY_HEADER_LENGTH + TELEMETRY_MAX_PAYLOAD_LENGTH + TELEMETRY_CRC_LENGTH)
+
+/*
+--| NAME: TELEMETRY_MAX_FRAME_LENGTH
+--| DESCRIPTION: the most bytes in one encoded record, COBS adds a byte
+--|   per 254 and the 0 delimiter ends it
+--| TYPE: unsigned integer
+*/
+#define TELEMETRY_MAX_FRAME_LENGTH (TELEMETRY_MAX_RECORD_LENGTH + (TELEMETRY_MAX_RECORD_LENGTH / 254u) + 2u)
+
+/*
+--| NAME: TELEMETRY_COBS_MAX_CODE
+--| DESCRIPTION: the COBS code of a run of 254 bytes with no 0 after it
+--| TYPE: unsigned integer
+*/
+#define TELEMETRY_COBS_MAX_CODE (0xFFu)
+
+/*
+--|----------------------------------------------------------------------------|
+--| PRIVATE TYPES
+--|----------------------------------------------------------------------------|
+*/
+
+/* None */
+
+/*
+--|----------------------------------------------------------------------------|
+--| PRIVATE CONSTANTS
+--|----------------------------------------------------------------------------|
+*/
+
+_Static_assert(TELEMETRY_MAX_PAYLOAD_LENGTH <= 255u, "the payload length must fit in its header byte");
+
+/*
+--|----------------------------------------------------------------------------|
+--| PRIVATE VARIABLES
+--|----------------------------------------------------------------------------|
+*/
+
+/* None */
+
+/*
+--|----------------------------------------------------------------------------|
+--| PRIVATE HELPER FUNCTION PROTOTYPES
+--|----------------------------------------------------------------------------|
+*/
+
+/*------------------------------------------------------------------------------
+Function Name:
+    Telemetry_COBS_Encode
+
+Function Description:
+    COBS encode bytes, so that the encoded bytes contain no 0.
+
+Parameters:
+    p_source: the bytes to encode.
+    length: the number of bytes.
+    p_destination: filled in with the encoded bytes, which need room for
+    length + length / 254 + 1 bytes.
+
+Returns:
+    uint32_t: the number of encoded bytes.
+
+Assumptions/Limitations:
+    Does not add the 0 delimiter.
+------------------------------------------------------------------------------*/
+static uint32_t Telemetry_COBS_Encode(const uint8_t * p_source, uint32_t length, uint8_t * p_destination);
+
+/*
+--|----------------------------------------------------------------------------|
+--| PUBLIC FUNCTION DEFINITIONS
+--|----------------------------------------------------------------------------|
+*/
+
+bool Telemetry_Init(Telemetry_t * p_telemetry, USART_Handle_t * p_USART, uint8_t * p_buffer, uint32_t buffer_size)
+{
+    p_telemetry->p_USART        = p_USART;
+    p_telemetry->in_flight      = 0u;
+    p_telemetry->sequence       = 0u;
+    p_telemetry->dropped_frames = 0u;
+
+    return Ring_Buffer_Init(&p_telemetry->frames, p_buffer, buffer_size);
+}
+
+bool Telemetry_Send(Telemetry_t * p_telemetry, uint8_t type, const void * p_payload, uint32_t length)
+{
+    // word aligned, so the CRC unit can be fed the record a word at a time
+    uint32_t        record_words[(TELEMETRY_MAX_RECORD_LENGTH + 3u) / 4u];
+    uint8_t         frame[TELEMETRY_MAX_FRAME_LENGTH];
+    uint8_t *       p_record  = (uint8_t *)record_words;
+    const uint8_t * p_bytes   = (const uint8_t *)p_payload;
+    uint16_t        sequence;
+    uint32_t        index     = TELEMETRY_HEADER_LENGTH;
+    uint32_t        frame_length;
+    uint32_t        crc;
+    uint32_t        i;
+
+    if (length > TELEMETRY_MAX_PAYLOAD_LENGTH)
+    {
+        return false;
+    }
+
+    // a record dropped for lack of room still takes a number, so the gap shows it was lost
+    sequence = p_telemetry->sequence++;
+
+    p_record[0] = type;
+    p_record[1] = (uint8_t)length;
+    p_record[2] = (uint8_t)(sequence & 0xFFu);
+    p_record[3] = (uint8_t)(sequence >> 8u);
+
+    for (i = 0u; i < length; i++)
+    {
+        p_record[index++] = p_bytes[i];
+    }
+
+    // the CRC covers whole words, the padding is not sent
+    while ((index & 3u) != 0u)
+    {
+        p_record[index++] = 0u;
+    }
+
+    crc   = CRC_Calculate(record_words, index / 4u);
+    index = TELEMETRY_HEADER_LENGTH + length;
+
+    p_record[index++] = (uint8_t)(crc & 0xFFu);
+    p_record[index++] = (uint8_t)((crc >> 8u) & 0xFFu);
+    p_record[index++] = (uint8_t)((crc >> 16u) & 0xFFu);
+    p_record[index++] = (uint8_t)(crc >> 24u);
+
+    frame_length          = Telemetry_COBS_Encode(p_record, index, frame);
+    frame[frame_length++] = 0u;
+
+    // a record is queued whole or not at all, so the receiver never sees part of one
+    if (Ring_Buffer_Get_Free(&p_telemetry->frames) < frame_length)
+    {
+        p_telemetry->dropped_frames++;
+        return false;
+    }
+
+    (void)Ring_Buffer_Write(&p_telemetry->frames, frame, frame_length);
+
+    return true;
+}
+
+void Telemetry_Flush(Telemetry_t * p_telemetry)
+{
+    const uint8_t * p_span;
+    uint32_t        span_length;
+
+    if (p_telemetry->in_flight != 0u)
+    {
+        if (!USART_Is_TX_Idle(p_telemetry->p_USART))
+        {
+            return;
+        }
+
+        // DMA is done with the frames, so the producer may reuse their space
+        Ring_Buffer_Commit_Read(&p_telemetry->frames, p_telemetry->in_flight);
+        p_telemetry->in_flight = 0u;
+    }
+
+    p_span = Ring_Buffer_Get_Read_Span(&p_telemetry->frames, &span_length);
+
+    if ((span_length != 0u) && USART_Write(p_telemetry->p_USART, p_span, span_length))
+    {
+        p_telemetry->in_flight = span_length;
+    }
+}
+
+uint32_t Telemetry_Get_Dropped(Telemetry_t * p_telemetry)
+{
+    return p_telemetry->dropped_frames;
+}
+
+/*
+--|----------------------------------------------------------------------------|
+--| PRIVATE HELPER FUNCTION DEFINITIONS
+--|----------------------------------------------------------------------------|
+*/
+
+static uint32_t Telemetry_COBS_Encode(const uint8_t * p_source, uint32_t length, uint8_t * p_destination)
+{
+    uint32_t code_index  = 0u;
+    uint32_t write_index = 1u;
+    uint8_t  code        = 1u;
+    uint32_t i;
+
+    // each code byte holds the distance to the next 0, which it replaces
+    for (i = 0u; i < length; i++)
+    {
+        if (p_source[i] == 0u)
+        {
+            p_destination[code_index] = code;
+            code_index                = write_index++;
+            code                      = 1u;
+        }
+        else
+        {
+            p_destination[write_index++] = p_source[i];
+            code++;
+
+            if (code == TELEMETRY_COBS_MAX_CODE)
+            {
+                p_destination[code_index] = code;
+                code_index                = write_index++;
+                code                      = 1u;
+            }
+        }
+    }
+
+    p_destination[code_index] = code;
+
+    return write_index;
+}
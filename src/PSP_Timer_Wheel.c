@@ -0,0 +1,583 @@
+/*
+--|----------------------------------------------------------------------------|
+--| FILE DESCRIPTION:
+--|   PSP_Timer_Wheel.c provides the implementation for the hierarchical timer
+--|   wheel.
+--|
+--|   Level 0 has one slot per mSec. Each higher level has one slot per full
+--|   revolution of the level below it. A timer is filed in the lowest level
+--|   which can hold its remaining delay, and is moved ("cascaded") down a
+--|   level each time the level below wraps around to the timer's slot.
+--|
+--|   All of the wheel data is only touched from thread context, so no
+--|   interrupt masking is needed. The SysTick interrupt only counts mSec,
+--|   and Timer_Wheel_Service catches the wheel up to that count, jumping
+--|   straight from one occupied slot or cascade to the next.
+--|
+--|----------------------------------------------------------------------------|
+--| REFERENCES:
+--|   Varghese & Lauck, "Hashed and Hierarchical Timing Wheels", 1987
+--|
+--|----------------------------------------------------------------------------|
+*/
+
+/*
+--|----------------------------------------------------------------------------|
+--| INCLUDE FILES
+--|----------------------------------------------------------------------------|
+*/
+
+#include <stddef.h>
+
+#include "PSP_SysTick.h"
+#include "PSP_Timer_Wheel.h"
+
+/*
+--|----------------------------------------------------------------------------|
+--| PRIVATE DEFINES
+--|----------------------------------------------------------------------------|
+*/
+
+/*
+--| NAME: TIMER_WHEEL_SLOT_MASK
+--| DESCRIPTION: mask for the slot index within a level
+--| TYPE: unsigned integer
+*/
+#define TIMER_WHEEL_SLOT_MASK (TIMER_WHEEL_NUM_SLOTS - 1u)
+
+/*
+--| NAME: TIMER_WHEEL_MAX_DELTA_mSec
+--| DESCRIPTION: the longest delay which fits in the wheel without re-cascading
+--| TYPE: unsigned integer
+*/
+#define TIMER_WHEEL_MAX_DELTA_mSec ((1u << (TIMER_WHEEL_SLOT_BITS * TIMER_WHEEL_NUM_LEVELS)) - 1u)
+
+/*
+--| NAME: TIMER_WHEEL_LEVEL_EXPIRED
+--| DESCRIPTION: level marker for timers waiting in the expired list
+--| TYPE: unsigned integer
+*/
+#define TIMER_WHEEL_LEVEL_EXPIRED (TIMER_WHEEL_NUM_LEVELS)
+
+/*
+--|----------------------------------------------------------------------------|
+--| PRIVATE TYPES
+--|----------------------------------------------------------------------------|
+*/
+
+/* None */
+
+/*
+--|----------------------------------------------------------------------------|
+--| PRIVATE CONSTANTS
+--|----------------------------------------------------------------------------|
+*/
+
+_Static_assert(TIMER_WHEEL_NUM_SLOTS == 64u, "the slot occupancy bitmaps are 64 bits wide");
+
+/*
+--|----------------------------------------------------------------------------|
+--| PRIVATE VARIABLES
+--|----------------------------------------------------------------------------|
+*/
+
+/*
+--| NAME: wheel_slots
+--| DESCRIPTION: the head of the list of timers in each slot of each level
+--| TYPE: Timer_Wheel_Timer_t*
+*/
+static Timer_Wheel_Timer_t * wheel_slots[TIMER_WHEEL_NUM_LEVELS][TIMER_WHEEL_NUM_SLOTS];
+
+/*
+--| NAME: wheel_slot_occupancy
+--| DESCRIPTION: one bit per slot, set if the slot holds any timers
+--| TYPE: uint64_t
+*/
+static uint64_t wheel_slot_occupancy[TIMER_WHEEL_NUM_LEVELS];
+
+/*
+--| NAME: expired_list
+--| DESCRIPTION: the head of the list of expired timers waiting for their callbacks
+--| TYPE: Timer_Wheel_Timer_t*
+*/
+static Timer_Wheel_Timer_t * expired_list = NULL;
+
+/*
+--| NAME: wheel_time_mSec
+--| DESCRIPTION: the SysTick time the wheel has been advanced up to
+--| TYPE: uint32_t
+*/
+static uint32_t wheel_time_mSec = 0u;
+
+/*
+--|----------------------------------------------------------------------------|
+--| PRIVATE HELPER FUNCTION PROTOTYPES
+--|----------------------------------------------------------------------------|
+*/
+
+/*------------------------------------------------------------------------------
+Function Name:
+    Timer_Wheel_Is_Empty
+
+Function Description:
+    Check if no timers are filed in any level of the wheel.
+
+Parameters:
+    None
+
+Returns:
+    true if every slot is empty, else false.
+
+Assumptions/Limitations:
+    Timers in the expired list are not counted.
+------------------------------------------------------------------------------*/
+static bool Timer_Wheel_Is_Empty(void);
+
+/*------------------------------------------------------------------------------
+Function Name:
+    Timer_Wheel_Sync_If_Empty
+
+Function Description:
+    Move the wheel time up to the current SysTick time if the wheel is empty,
+    so that a new timer is filed relative to the present even if
+    Timer_Wheel_Service has not been called for a long time.
+
+Parameters:
+    None
+
+Returns:
+    None
+
+Assumptions/Limitations:
+    None
+------------------------------------------------------------------------------*/
+static void Timer_Wheel_Sync_If_Empty(void);
+
+/*------------------------------------------------------------------------------
+Function Name:
+    Timer_Wheel_Get_Next_Event
+
+Function Description:
+    Find the next wheel time at which anything happens: an occupied level 0
+    slot expires, or an occupied slot of a higher level is cascaded. The
+    wheel time can be moved up to just before it without touching any slot.
+
+Parameters:
+    p_event_mSec: set to the wheel time of the next event.
+
+Returns:
+    true if an event was found, false if the wheel is empty.
+
+Assumptions/Limitations:
+    Timers in the expired list are not counted.
+------------------------------------------------------------------------------*/
+static bool Timer_Wheel_Get_Next_Event(uint32_t * p_event_mSec);
+
+/*------------------------------------------------------------------------------
+Function Name:
+    Timer_Wheel_Link
+
+Function Description:
+    Push a timer onto the front of a list.
+
+Parameters:
+    pp_head: pointer to the head of the list.
+    p_timer: pointer to the timer.
+
+Returns:
+    None
+
+Assumptions/Limitations:
+    Assumes that the timer is not in any list.
+------------------------------------------------------------------------------*/
+static void Timer_Wheel_Link(Timer_Wheel_Timer_t ** pp_head, Timer_Wheel_Timer_t * p_timer);
+
+/*------------------------------------------------------------------------------
+Function Name:
+    Timer_Wheel_Unlink
+
+Function Description:
+    Remove a timer from whichever list it is in, updating the slot occupancy.
+
+Parameters:
+    p_timer: pointer to the timer.
+
+Returns:
+    None
+
+Assumptions/Limitations:
+    Assumes that the timer is in a list.
+------------------------------------------------------------------------------*/
+static void Timer_Wheel_Unlink(Timer_Wheel_Timer_t * p_timer);
+
+/*------------------------------------------------------------------------------
+Function Name:
+    Timer_Wheel_Insert
+
+Function Description:
+    File a timer in the wheel slot matching its expiry time, or in the
+    expired list if it is already due.
+
+Parameters:
+    p_timer: pointer to the timer, with a valid expiry time.
+
+Returns:
+    None
+
+Assumptions/Limitations:
+    Assumes that the timer is not in any list.
+------------------------------------------------------------------------------*/
+static void Timer_Wheel_Insert(Timer_Wheel_Timer_t * p_timer);
+
+/*------------------------------------------------------------------------------
+Function Name:
+    Timer_Wheel_Expire
+
+Function Description:
+    Move a timer to the expired list, to have its callback called by
+    Timer_Wheel_Service.
+
+Parameters:
+    p_timer: pointer to the timer.
+
+Returns:
+    None
+
+Assumptions/Limitations:
+    Assumes that the timer is not in any list.
+------------------------------------------------------------------------------*/
+static void Timer_Wheel_Expire(Timer_Wheel_Timer_t * p_timer);
+
+/*------------------------------------------------------------------------------
+Function Name:
+    Timer_Wheel_Cascade
+
+Function Description:
+    Re-file every timer in the given slot, moving them to lower levels.
+
+Parameters:
+    level: the level to cascade from [1 to TIMER_WHEEL_NUM_LEVELS - 1].
+    slot: the slot to cascade.
+
+Returns:
+    None
+
+Assumptions/Limitations:
+    None
+------------------------------------------------------------------------------*/
+static void Timer_Wheel_Cascade(uint32_t level, uint32_t slot);
+
+/*------------------------------------------------------------------------------
+Function Name:
+    Timer_Wheel_Advance_One_Tick
+
+Function Description:
+    Advance the wheel time by one mSec, cascade any levels which wrapped, and
+    move the timers expiring now to the expired list.
+
+Parameters:
+    None
+
+Returns:
+    None
+
+Assumptions/Limitations:
+    None
+------------------------------------------------------------------------------*/
+static void Timer_Wheel_Advance_One_Tick(void);
+
+/*
+--|----------------------------------------------------------------------------|
+--| PUBLIC FUNCTION DEFINITIONS
+--|----------------------------------------------------------------------------|
+*/
+
+void Timer_Wheel_Start_One_Shot(Timer_Wheel_Timer_t * p_timer,
+                                uint32_t delay_mSec,
+                                Timer_Wheel_Callback_t callback,
+                                void * p_context)
+{
+    Timer_Wheel_Cancel(p_timer);
+
+    p_timer->callback    = callback;
+    p_timer->p_context   = p_context;
+    p_timer->period_mSec = 0u;
+    p_timer->expiry_mSec = SysTick_Get_mSec() + delay_mSec;
+
+    Timer_Wheel_Sync_If_Empty();
+    Timer_Wheel_Insert(p_timer);
+}
+
+void Timer_Wheel_Start_Periodic(Timer_Wheel_Timer_t * p_timer,
+                                uint32_t period_mSec,
+                                Timer_Wheel_Callback_t callback,
+                                void * p_context)
+{
+    Timer_Wheel_Cancel(p_timer);
+
+    p_timer->callback    = callback;
+    p_timer->p_context   = p_context;
+    p_timer->period_mSec = period_mSec;
+    p_timer->expiry_mSec = SysTick_Get_mSec() + period_mSec;
+
+    Timer_Wheel_Sync_If_Empty();
+    Timer_Wheel_Insert(p_timer);
+}
+
+void Timer_Wheel_Cancel(Timer_Wheel_Timer_t * p_timer)
+{
+    if (p_timer->pp_prev_next != NULL)
+    {
+        Timer_Wheel_Unlink(p_timer);
+    }
+}
+
+bool Timer_Wheel_Is_Active(Timer_Wheel_Timer_t * p_timer)
+{
+    return p_timer->pp_prev_next != NULL;
+}
+
+void Timer_Wheel_Service(void)
+{
+    const uint32_t now_mSec = SysTick_Get_mSec();
+
+    while (wheel_time_mSec != now_mSec)
+    {
+        uint32_t event_mSec;
+
+        if (!Timer_Wheel_Get_Next_Event(&event_mSec) || ((int32_t)(event_mSec - now_mSec) > 0))
+        {
+            // nothing happens before the present, so jump straight to it
+            wheel_time_mSec = now_mSec;
+        }
+        else
+        {
+            // skip the empty slots in between, then expire or cascade at the event
+            wheel_time_mSec = event_mSec - 1u;
+            Timer_Wheel_Advance_One_Tick();
+        }
+    }
+
+    // pop the expired timers one at a time, so that callbacks may cancel or
+    // restart any timer, including ones which are still waiting in the list
+    while (expired_list != NULL)
+    {
+        Timer_Wheel_Timer_t * p_timer = expired_list;
+
+        Timer_Wheel_Unlink(p_timer);
+
+        if (p_timer->period_mSec != 0u)
+        {
+            // advance from the previous expiry rather than from now to avoid drift
+            p_timer->expiry_mSec += p_timer->period_mSec;
+            Timer_Wheel_Insert(p_timer);
+        }
+
+        p_timer->callback(p_timer->p_context);
+    }
+}
+
+uint32_t Timer_Wheel_Get_mSec_Until_Next_Expiry(void)
+{
+    if (expired_list != NULL)
+    {
+        return 0u;
+    }
+
+    uint32_t next_event_mSec;
+
+    if (!Timer_Wheel_Get_Next_Event(&next_event_mSec))
+    {
+        return UINT32_MAX;
+    }
+
+    const uint32_t mSec_until_event = next_event_mSec - SysTick_Get_mSec();
+
+    if ((int32_t)mSec_until_event <= 0)
+    {
+        return 0u;
+    }
+
+    return mSec_until_event;
+}
+
+/*
+--|----------------------------------------------------------------------------|
+--| PRIVATE HELPER FUNCTION DEFINITIONS
+--|----------------------------------------------------------------------------|
+*/
+
+static bool Timer_Wheel_Is_Empty(void)
+{
+    for (uint32_t level = 0u; level < TIMER_WHEEL_NUM_LEVELS; ++level)
+    {
+        if (wheel_slot_occupancy[level] != 0u)
+        {
+            return false;
+        }
+    }
+
+    return true;
+}
+
+static void Timer_Wheel_Sync_If_Empty(void)
+{
+    if (Timer_Wheel_Is_Empty())
+    {
+        // nothing can expire, so jump straight to the present
+        wheel_time_mSec = SysTick_Get_mSec();
+    }
+}
+
+static bool Timer_Wheel_Get_Next_Event(uint32_t * p_event_mSec)
+{
+    bool timer_found = false;
+
+    for (uint32_t level = 0u; level < TIMER_WHEEL_NUM_LEVELS; ++level)
+    {
+        const uint64_t occupancy = wheel_slot_occupancy[level];
+
+        if (occupancy == 0u)
+        {
+            continue;
+        }
+
+        const uint32_t level_shift  = TIMER_WHEEL_SLOT_BITS * level;
+        const uint32_t level_index  = wheel_time_mSec >> level_shift;
+        const uint32_t search_start = (level_index + 1u) & TIMER_WHEEL_SLOT_MASK;
+
+        // rotate the bitmap so bit 0 is the slot after the current one
+        uint64_t rotated = occupancy;
+
+        if (search_start != 0u)
+        {
+            rotated = (occupancy >> search_start) | (occupancy << (TIMER_WHEEL_NUM_SLOTS - search_start));
+        }
+
+        const uint32_t slots_ahead = (uint32_t)__builtin_ctzll(rotated) + 1u;
+
+        // the slot is serviced when the wheel time reaches its start
+        const uint32_t event_mSec = (level_index + slots_ahead) << level_shift;
+
+        if (!timer_found || ((int32_t)(event_mSec - *p_event_mSec) < 0))
+        {
+            *p_event_mSec = event_mSec;
+            timer_found   = true;
+        }
+    }
+
+    return timer_found;
+}
+
+static void Timer_Wheel_Link(Timer_Wheel_Timer_t ** pp_head, Timer_Wheel_Timer_t * p_timer)
+{
+    p_timer->p_next = *pp_head;
+
+    if (p_timer->p_next != NULL)
+    {
+        p_timer->p_next->pp_prev_next = &p_timer->p_next;
+    }
+
+    p_timer->pp_prev_next = pp_head;
+    *pp_head = p_timer;
+}
+
+static void Timer_Wheel_Unlink(Timer_Wheel_Timer_t * p_timer)
+{
+    *p_timer->pp_prev_next = p_timer->p_next;
+
+    if (p_timer->p_next != NULL)
+    {
+        p_timer->p_next->pp_prev_next = p_timer->pp_prev_next;
+    }
+
+    if ((p_timer->level != TIMER_WHEEL_LEVEL_EXPIRED) &&
+        (wheel_slots[p_timer->level][p_timer->slot] == NULL))
+    {
+        wheel_slot_occupancy[p_timer->level] &= ~((uint64_t)1u << p_timer->slot);
+    }
+
+    p_timer->p_next       = NULL;
+    p_timer->pp_prev_next = NULL;
+}
+
+static void Timer_Wheel_Insert(Timer_Wheel_Timer_t * p_timer)
+{
+    uint32_t delta_mSec = p_timer->expiry_mSec - wheel_time_mSec;
+
+    if ((int32_t)delta_mSec <= 0)
+    {
+        // already due
+        Timer_Wheel_Expire(p_timer);
+        return;
+    }
+
+    if (delta_mSec > TIMER_WHEEL_MAX_DELTA_mSec)
+    {
+        // too far in the future, park it at the far end and re-file it later
+        delta_mSec = TIMER_WHEEL_MAX_DELTA_mSec;
+    }
+
+    const uint32_t slot_time_mSec = wheel_time_mSec + delta_mSec;
+
+    uint32_t level = 0u;
+
+    while (delta_mSec >= (1u << (TIMER_WHEEL_SLOT_BITS * (level + 1u))))
+    {
+        level++;
+    }
+
+    const uint32_t slot = (slot_time_mSec >> (TIMER_WHEEL_SLOT_BITS * level)) & TIMER_WHEEL_SLOT_MASK;
+
+    p_timer->level = (uint8_t)level;
+    p_timer->slot  = (uint8_t)slot;
+
+    Timer_Wheel_Link(&wheel_slots[level][slot], p_timer);
+    wheel_slot_occupancy[level] |= ((uint64_t)1u << slot);
+}
+
+static void Timer_Wheel_Expire(Timer_Wheel_Timer_t * p_timer)
+{
+    p_timer->level = TIMER_WHEEL_LEVEL_EXPIRED;
+    Timer_Wheel_Link(&expired_list, p_timer);
+}
+
+static void Timer_Wheel_Cascade(uint32_t level, uint32_t slot)
+{
+    while (wheel_slots[level][slot] != NULL)
+    {
+        Timer_Wheel_Timer_t * p_timer = wheel_slots[level][slot];
+
+        Timer_Wheel_Unlink(p_timer);
+        Timer_Wheel_Insert(p_timer);
+    }
+}
+
+static void Timer_Wheel_Advance_One_Tick(void)
+{
+    wheel_time_mSec++;
+
+    // when a level wraps around, bring the next slot of the level above down
+    for (uint32_t level = 1u; level < TIMER_WHEEL_NUM_LEVELS; ++level)
+    {
+        const uint32_t lower_bits = wheel_time_mSec & ((1u << (TIMER_WHEEL_SLOT_BITS * level)) - 1u);
+
+        if (lower_bits != 0u)
+        {
+            break;
+        }
+
+        Timer_Wheel_Cascade(level, (wheel_time_mSec >> (TIMER_WHEEL_SLOT_BITS * level)) & TIMER_WHEEL_SLOT_MASK);
+    }
+
+    // everything left in the current level 0 slot expires now
+    const uint32_t slot = wheel_time_mSec & TIMER_WHEEL_SLOT_MASK;
+
+    while (wheel_slots[0u][slot] != NULL)
+    {
+        Timer_Wheel_Timer_t * p_timer = wheel_slots[0u][slot];
+
+        Timer_Wheel_Unlink(p_timer);
+        Timer_Wheel_Expire(p_timer);
+    }
+}
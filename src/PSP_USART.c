@@ -0,0 +1,372 @@
+/*
+--|----------------------------------------------------------------------------|
+--| FILE DESCRIPTION:
+--|   PSP_USART.c provides the implementation for USART1, USART2 and USART3.
+--|
+--|   Receiving runs a DMA channel in circular mode over the receive
+--|   buffer for as long as the USART is on. The idle line interrupt and
+--|   the DMA half and full interrupts each hand the bytes received since
+--|   the last one to the callback, in place, so the CPU never touches
+--|   single bytes.
+--|
+--|   Transmitting takes writes from a queue of descriptors, one DMA
+--|   transfer per write. USART_Write only adds to the head of the queue
+--|   and the interrupt handler only takes from the tail, so no interrupt
+--|   masking is needed.
+--|
+--|----------------------------------------------------------------------------|
+--| REFERENCES:
+--|   stm32f10x reference manual, page 771
+--|
+--|----------------------------------------------------------------------------|
+*/
+
+/*
+--|----------------------------------------------------------------------------|
+--| INCLUDE FILES
+--|----------------------------------------------------------------------------|
+*/
+
+#include <stddef.h>
+
+#include "PSP_Clock_Tree.h"
+#include "PSP_DMA.h"
+#include "PSP_USART.h"
+
+/*
+--|----------------------------------------------------------------------------|
+--| PRIVATE DEFINES
+--|----------------------------------------------------------------------------|
+*/
+
+/*
+--| NAME: USART_NUM_USARTS
+--| DESCRIPTION: the number of USARTs supported, USART1 to USART3
+--| TYPE: unsigned integer
+*/
+#define USART_NUM_USARTS (3u)
+
+/*
+--| NAME: USART_TX_QUEUE_MASK
+--| DESCRIPTION: mask for the index of a write within the transmit queue
+--| TYPE: unsigned integer
+*/
+#define USART_TX_QUEUE_MASK (USART_TX_QUEUE_LENGTH - 1u)
+
+/*
+--|----------------------------------------------------------------------------|
+--| PRIVATE TYPES
+--|----------------------------------------------------------------------------|
+*/
+
+/* None */
+
+/*
+--|----------------------------------------------------------------------------|
+--| PRIVATE CONSTANTS
+--|----------------------------------------------------------------------------|
+*/
+
+_Static_assert((USART_TX_QUEUE_LENGTH & USART_TX_QUEUE_MASK) == 0u, "the transmit queue length must be a power of 2");
+
+/*
+--| NAME: USART_TX_DMA_channels
+--| DESCRIPTION: the DMA1 channel hard wired to each USART's transmitter,
+--|   indexed by USART (USART1 to USART3)
+--| TYPE: DMA_Channel_enum
+*/
+static const DMA_Channel_enum USART_TX_DMA_channels[USART_NUM_USARTS] =
+{
+    DMA_CHANNEL_4, // USART1
+    DMA_CHANNEL_7, // USART2
+    DMA_CHANNEL_2, // USART3
+};
+
+/*
+--| NAME: USART_RX_DMA_channels
+--| DESCRIPTION: the DMA1 channel hard wired to each USART's receiver,
+--|   indexed by USART (USART1 to USART3)
+--| TYPE: DMA_Channel_enum
+*/
+static const DMA_Channel_enum USART_RX_DMA_channels[USART_NUM_USARTS] =
+{
+    DMA_CHANNEL_5, // USART1
+    DMA_CHANNEL_6, // USART2
+    DMA_CHANNEL_3, // USART3
+};
+
+/*
+--|----------------------------------------------------------------------------|
+--| PRIVATE VARIABLES
+--|----------------------------------------------------------------------------|
+*/
+
+/* None */
+
+/*
+--|----------------------------------------------------------------------------|
+--| PRIVATE HELPER FUNCTION PROTOTYPES
+--|----------------------------------------------------------------------------|
+*/
+
+/*------------------------------------------------------------------------------
+Function Name:
+    USART_Get_Index
+
+Function Description:
+    Get the index of a USART, for looking up per-USART tables.
+
+Parameters:
+    p_USART: pointer to the USART.
+
+Returns:
+    uint32_t: 0 for USART1 up to 2 for USART3.
+
+Assumptions/Limitations:
+    Assumes that p_USART is one of USART1 to USART3.
+------------------------------------------------------------------------------*/
+static uint32_t USART_Get_Index(volatile USART_t * p_USART);
+
+/*------------------------------------------------------------------------------
+Function Name:
+    USART_Start_TX
+
+Function Description:
+    Start the transmit DMA channel on the write at the tail of the queue.
+
+Parameters:
+    p_handle: pointer to the USART handle.
+
+Returns:
+    None
+
+Assumptions/Limitations:
+    Assumes that the queue is not empty and the channel is not running.
+------------------------------------------------------------------------------*/
+static void USART_Start_TX(USART_Handle_t * p_handle);
+
+/*------------------------------------------------------------------------------
+Function Name:
+    USART_Deliver_RX
+
+Function Description:
+    Give the bytes DMA has written since the last call to the callback, in
+    one span, or two if they wrap around the end of the buffer.
+
+Parameters:
+    p_handle: pointer to the USART handle.
+    frame_end: true if the line has gone idle, ending the frame.
+
+Returns:
+    None
+
+Assumptions/Limitations:
+    None
+------------------------------------------------------------------------------*/
+static void USART_Deliver_RX(USART_Handle_t * p_handle, bool frame_end);
+
+/*
+--|----------------------------------------------------------------------------|
+--| PUBLIC FUNCTION DEFINITIONS
+--|----------------------------------------------------------------------------|
+*/
+
+uint32_t USART_Init(USART_Handle_t * p_handle, USART_Initialization_Data_t * p_init_data)
+{
+    volatile USART_t * p_USART  = p_handle->p_USART;
+    const uint32_t     index    = USART_Get_Index(p_USART);
+    const uint32_t     clock_Hz = (index == 0u) ? CLOCK_TREE_PCLK2_HZ : CLOCK_TREE_PCLK1_HZ;
+    uint32_t           divider;
+
+    // the USART is configured while it is disabled
+    p_USART->CR1 = 0u;
+
+    // with 16x oversampling, BRR holds the bus clock over the baud rate in 12.4 fixed point
+    divider = (clock_Hz + (p_init_data->baud_rate / 2u)) / p_init_data->baud_rate;
+    if (divider < 16u)
+    {
+        divider = 16u;
+    }
+
+    p_USART->BRR = divider;
+    p_USART->CR2 = USART_CR2_STOP_1_BIT << USART_CR2_STOP_SHIFT_AMT;
+    p_USART->CR3 = USART_CR3_DMAT_FLAG;
+
+    p_handle->tx_channel     = USART_TX_DMA_channels[index];
+    p_handle->rx_channel     = USART_RX_DMA_channels[index];
+    p_handle->baud_rate      = clock_Hz / divider;
+    p_handle->p_rx_buffer    = p_init_data->p_rx_buffer;
+    p_handle->rx_buffer_size = p_init_data->rx_buffer_size;
+    p_handle->rx_read_index  = 0u;
+    p_handle->rx_callback    = p_init_data->rx_callback;
+    p_handle->p_context      = p_init_data->p_context;
+    p_handle->tx_head        = 0u;
+    p_handle->tx_tail        = 0u;
+    p_handle->tx_busy        = false;
+
+    if (p_init_data->p_rx_buffer != NULL)
+    {
+        DMA_Channel_Initialization_Data_t rx_init_data =
+        {
+            &p_USART->DR,
+            p_init_data->p_rx_buffer,
+            p_init_data->rx_buffer_size,
+            DMA_CCR_SIZE_8_BITS,
+            DMA_CCR_PL_HIGH,
+            DMA_CCR_MINC_FLAG | DMA_CCR_CIRC_FLAG | DMA_CCR_HTIE_FLAG | DMA_CCR_TCIE_FLAG
+        };
+
+        DMA_Channel_Init(p_handle->rx_channel, &rx_init_data);
+
+        p_USART->CR3 |= USART_CR3_DMAR_FLAG;
+        p_USART->CR1  = USART_CR1_UE_FLAG | USART_CR1_TE_FLAG | USART_CR1_RE_FLAG | USART_CR1_IDLEIE_FLAG;
+    }
+    else
+    {
+        p_USART->CR1 = USART_CR1_UE_FLAG | USART_CR1_TE_FLAG;
+    }
+
+    return p_handle->baud_rate;
+}
+
+void USART_IRQ_Handler(USART_Handle_t * p_handle)
+{
+    if (p_handle->p_rx_buffer != NULL)
+    {
+        bool frame_end = false;
+
+        // IDLE is cleared by reading SR, done here, then DR
+        if ((p_handle->p_USART->SR & USART_SR_IDLE_FLAG) != 0u)
+        {
+            (void)p_handle->p_USART->DR;
+            frame_end = true;
+        }
+
+        if ((DMA_Channel_Get_Flags(p_handle->rx_channel) & (DMA_ISR_HTIF_FLAG | DMA_ISR_TCIF_FLAG)) != 0u)
+        {
+            DMA_Channel_Clear_Flags(p_handle->rx_channel, DMA_ISR_HTIF_FLAG | DMA_ISR_TCIF_FLAG | DMA_ISR_GIF_FLAG);
+        }
+
+        USART_Deliver_RX(p_handle, frame_end);
+    }
+
+    if ((DMA_Channel_Get_Flags(p_handle->tx_channel) & DMA_ISR_TCIF_FLAG) != 0u)
+    {
+        DMA_Channel_Clear_Flags(p_handle->tx_channel, DMA_ISR_TCIF_FLAG | DMA_ISR_GIF_FLAG);
+
+        p_handle->tx_tail++;
+
+        if (p_handle->tx_tail != p_handle->tx_head)
+        {
+            USART_Start_TX(p_handle);
+        }
+        else
+        {
+            p_handle->tx_busy = false;
+        }
+    }
+}
+
+bool USART_Write(USART_Handle_t * p_handle, const uint8_t * p_data, uint32_t length)
+{
+    const uint32_t head = p_handle->tx_head;
+
+    if ((length == 0u) || ((head - p_handle->tx_tail) >= USART_TX_QUEUE_LENGTH))
+    {
+        return false;
+    }
+
+    p_handle->tx_queue[head & USART_TX_QUEUE_MASK].p_data = p_data;
+    p_handle->tx_queue[head & USART_TX_QUEUE_MASK].length = length;
+
+    // once the head moves, the interrupt handler may start the write itself
+    p_handle->tx_head = head + 1u;
+
+    // the transmit interrupt only fires while busy, so it cannot race this
+    if (!p_handle->tx_busy)
+    {
+        p_handle->tx_busy = true;
+        USART_Start_TX(p_handle);
+    }
+
+    return true;
+}
+
+bool USART_Is_TX_Idle(USART_Handle_t * p_handle)
+{
+    return !p_handle->tx_busy;
+}
+
+/*
+--|----------------------------------------------------------------------------|
+--| PRIVATE HELPER FUNCTION DEFINITIONS
+--|----------------------------------------------------------------------------|
+*/
+
+static uint32_t USART_Get_Index(volatile USART_t * p_USART)
+{
+    if (p_USART == USART1)
+    {
+        return 0u;
+    }
+    else if (p_USART == USART2)
+    {
+        return 1u;
+    }
+    else
+    {
+        return 2u;
+    }
+}
+
+static void USART_Start_TX(USART_Handle_t * p_handle)
+{
+    volatile USART_TX_Descriptor_t * p_write = &p_handle->tx_queue[p_handle->tx_tail & USART_TX_QUEUE_MASK];
+
+    DMA_Channel_Initialization_Data_t tx_init_data =
+    {
+        &p_handle->p_USART->DR,
+        (volatile void *)(uintptr_t)p_write->p_data,
+        p_write->length,
+        DMA_CCR_SIZE_8_BITS,
+        DMA_CCR_PL_MEDIUM,
+        DMA_CCR_MINC_FLAG | DMA_CCR_DIR_FLAG | DMA_CCR_TCIE_FLAG
+    };
+
+    DMA_Channel_Init(p_handle->tx_channel, &tx_init_data);
+}
+
+static void USART_Deliver_RX(USART_Handle_t * p_handle, bool frame_end)
+{
+    // CNDTR counts down to 1 and reloads, so the write index is always within the buffer
+    const uint32_t write_index = p_handle->rx_buffer_size - DMA_Channel_Get_Remaining(p_handle->rx_channel);
+    uint32_t       read_index  = p_handle->rx_read_index;
+    bool           ended       = false;
+
+    if (write_index < read_index)
+    {
+        // the part up to the end of the buffer ends the frame only if nothing follows it
+        ended = frame_end && (write_index == 0u);
+
+        if (p_handle->rx_callback != NULL)
+        {
+            p_handle->rx_callback(p_handle->p_context, &p_handle->p_rx_buffer[read_index],
+                                  p_handle->rx_buffer_size - read_index, ended);
+        }
+
+        read_index = 0u;
+    }
+
+    if ((write_index > read_index) || (frame_end && !ended))
+    {
+        if (p_handle->rx_callback != NULL)
+        {
+            p_handle->rx_callback(p_handle->p_context, &p_handle->p_rx_buffer[read_index],
+                                  write_index - read_index, frame_end);
+        }
+
+        read_index = write_index;
+    }
+
+    p_handle->rx_read_index = read_index;
+}
@@ -0,0 +1,299 @@
+/*
+--|----------------------------------------------------------------------------|
+--| FILE DESCRIPTION:
+--|   clock_tree_test.c is a Linux host test of the PSP_Clock_Tree.h model:
+--|   the derived clocks, prescaler bits and flash latency for several
+--|   configurations, and the TIMx PSC/ARR and SPI BR helpers. It prints each
+--|   failed check and exits non-zero if there were any.
+--|
+--|   To build and run it:
+--|   $ make host_test
+--|
+--|----------------------------------------------------------------------------|
+--| REFERENCES:
+--|   RM0008 STM32F101xx, STM32F102xx, STM32F103xx Reference Manual, rev 21
+--|
+--|----------------------------------------------------------------------------|
+*/
+
+/*
+--|----------------------------------------------------------------------------|
+--| INCLUDE FILES
+--|----------------------------------------------------------------------------|
+*/
+
+#include "PSP_Clock_Tree.h"
+
+#include <stdio.h>
+#include <stdlib.h>
+
+/*
+--|----------------------------------------------------------------------------|
+--| DEFINES
+--|----------------------------------------------------------------------------|
+*/
+
+/*
+--| NAME: CHECK
+--| DESCRIPTION: compare an unsigned value against its expected value, and
+--|   count and print a failure
+--| TYPE: statement
+*/
+#define CHECK(actual, expected) Check((unsigned long)(actual), (unsigned long)(expected), #actual, __LINE__)
+
+/*
+--| CONFIGURATION
+--| clear the defaults, each test defines its own configuration: the derived
+--| clocks are macros, so they follow whatever is defined where they are used
+*/
+#undef CLOCK_TREE_HSE_HZ
+#undef CLOCK_TREE_CFG_SYSCLK_SOURCE
+#undef CLOCK_TREE_CFG_PLL_SOURCE
+#undef CLOCK_TREE_CFG_PLLMUL
+#undef CLOCK_TREE_CFG_HPRE_DIV
+#undef CLOCK_TREE_CFG_PPRE1_DIV
+#undef CLOCK_TREE_CFG_PPRE2_DIV
+#undef CLOCK_TREE_CFG_ADCPRE_DIV
+
+/*
+--|----------------------------------------------------------------------------|
+--| TYPES
+--|----------------------------------------------------------------------------|
+*/
+
+/* None */
+
+/*
+--|----------------------------------------------------------------------------|
+--| CONSTANTS
+--|----------------------------------------------------------------------------|
+*/
+
+/* None */
+
+/*
+--|----------------------------------------------------------------------------|
+--| VARIABLES
+--|----------------------------------------------------------------------------|
+*/
+
+/*
+--| NAME: num_checks
+--| DESCRIPTION: the checks made so far
+--| TYPE: unsigned int
+*/
+static unsigned int num_checks = 0u;
+
+/*
+--| NAME: num_failures
+--| DESCRIPTION: the checks failed so far
+--| TYPE: unsigned int
+*/
+static unsigned int num_failures = 0u;
+
+/*
+--|----------------------------------------------------------------------------|
+--| FUNCTION PROTOTYPES
+--|----------------------------------------------------------------------------|
+*/
+
+static void Check(unsigned long actual, unsigned long expected, const char * p_name, int line);
+static void Test_Default_Configuration(void);
+static void Test_72MHz_Configuration(void);
+static void Test_HSI_Divided_Configuration(void);
+static void Test_Invalid_Prescalers(void);
+static void Test_Timer_Helpers(void);
+static void Test_SPI_Helper(void);
+
+/*
+--|----------------------------------------------------------------------------|
+--| FUNCTION DEFINITIONS
+--|----------------------------------------------------------------------------|
+*/
+
+int main(void)
+{
+    Test_Default_Configuration();
+    Test_72MHz_Configuration();
+    Test_HSI_Divided_Configuration();
+    Test_Invalid_Prescalers();
+    Test_Timer_Helpers();
+    Test_SPI_Helper();
+
+    printf("clock tree: %u of %u checks passed\n", num_checks - num_failures, num_checks);
+
+    return (num_failures == 0u) ? EXIT_SUCCESS : EXIT_FAILURE;
+}
+
+/*
+--|----------------------------------------------------------------------------|
+--| HELPER FUNCTION DEFINITIONS
+--|----------------------------------------------------------------------------|
+*/
+
+static void Check(unsigned long actual, unsigned long expected, const char * p_name, int line)
+{
+    num_checks++;
+
+    if (actual != expected)
+    {
+        num_failures++;
+        printf("line %d: %s is %lu, expected %lu\n", line, p_name, actual, expected);
+    }
+}
+
+// the defaults in PSP_Clock_Tree.h: HSI / 2 * 8, no bus division
+static void Test_Default_Configuration(void)
+{
+#define CLOCK_TREE_HSE_HZ            (8000000u)
+#define CLOCK_TREE_CFG_SYSCLK_SOURCE (CLOCK_TREE_SYSCLK_SOURCE_PLL)
+#define CLOCK_TREE_CFG_PLL_SOURCE    (CLOCK_TREE_PLL_SOURCE_HSI_DIV_2)
+#define CLOCK_TREE_CFG_PLLMUL        (8u)
+#define CLOCK_TREE_CFG_HPRE_DIV      (1u)
+#define CLOCK_TREE_CFG_PPRE1_DIV     (1u)
+#define CLOCK_TREE_CFG_PPRE2_DIV     (1u)
+#define CLOCK_TREE_CFG_ADCPRE_DIV    (4u)
+
+    CHECK(CLOCK_TREE_PLL_INPUT_HZ, 4000000u);
+    CHECK(CLOCK_TREE_SYSCLK_HZ, 32000000u);
+    CHECK(CLOCK_TREE_HCLK_HZ, 32000000u);
+    CHECK(CLOCK_TREE_PCLK1_HZ, 32000000u);
+    CHECK(CLOCK_TREE_PCLK2_HZ, 32000000u);
+    CHECK(CLOCK_TREE_TIM1_CLK_HZ, 32000000u);
+    CHECK(CLOCK_TREE_TIM2_CLK_HZ, 32000000u);
+    CHECK(CLOCK_TREE_ADC_CLK_HZ, 8000000u);
+    CHECK(CLOCK_TREE_PLLMUL_BITS, 0b0110u);
+    CHECK(CLOCK_TREE_HPRE_BITS, 0b0000u);
+    CHECK(CLOCK_TREE_PPRE1_BITS, 0b000u);
+    CHECK(CLOCK_TREE_PPRE2_BITS, 0b000u);
+    CHECK(CLOCK_TREE_ADCPRE_BITS, 0b01u);
+    CHECK(CLOCK_TREE_FLASH_LATENCY, 0b001u);
+
+#undef CLOCK_TREE_HSE_HZ
+#undef CLOCK_TREE_CFG_SYSCLK_SOURCE
+#undef CLOCK_TREE_CFG_PLL_SOURCE
+#undef CLOCK_TREE_CFG_PLLMUL
+#undef CLOCK_TREE_CFG_HPRE_DIV
+#undef CLOCK_TREE_CFG_PPRE1_DIV
+#undef CLOCK_TREE_CFG_PPRE2_DIV
+#undef CLOCK_TREE_CFG_ADCPRE_DIV
+}
+
+// the fastest configuration: HSE * 9, APB1 divided to stay within 36 MHz
+static void Test_72MHz_Configuration(void)
+{
+#define CLOCK_TREE_HSE_HZ            (8000000u)
+#define CLOCK_TREE_CFG_SYSCLK_SOURCE (CLOCK_TREE_SYSCLK_SOURCE_PLL)
+#define CLOCK_TREE_CFG_PLL_SOURCE    (CLOCK_TREE_PLL_SOURCE_HSE)
+#define CLOCK_TREE_CFG_PLLMUL        (9u)
+#define CLOCK_TREE_CFG_HPRE_DIV      (1u)
+#define CLOCK_TREE_CFG_PPRE1_DIV     (2u)
+#define CLOCK_TREE_CFG_PPRE2_DIV     (1u)
+#define CLOCK_TREE_CFG_ADCPRE_DIV    (6u)
+
+    CHECK(CLOCK_TREE_PLL_INPUT_HZ, 8000000u);
+    CHECK(CLOCK_TREE_SYSCLK_HZ, 72000000u);
+    CHECK(CLOCK_TREE_HCLK_HZ, 72000000u);
+    CHECK(CLOCK_TREE_PCLK1_HZ, 36000000u);
+    CHECK(CLOCK_TREE_PCLK2_HZ, 72000000u);
+    CHECK(CLOCK_TREE_TIM1_CLK_HZ, 72000000u);
+    CHECK(CLOCK_TREE_TIM2_CLK_HZ, 72000000u); // doubled, as APB1 is divided
+    CHECK(CLOCK_TREE_ADC_CLK_HZ, 12000000u);
+    CHECK(CLOCK_TREE_PLLMUL_BITS, 0b0111u);
+    CHECK(CLOCK_TREE_PPRE1_BITS, 0b100u);
+    CHECK(CLOCK_TREE_PPRE2_BITS, 0b000u);
+    CHECK(CLOCK_TREE_ADCPRE_BITS, 0b10u);
+    CHECK(CLOCK_TREE_FLASH_LATENCY, 0b010u);
+
+#undef CLOCK_TREE_HSE_HZ
+#undef CLOCK_TREE_CFG_SYSCLK_SOURCE
+#undef CLOCK_TREE_CFG_PLL_SOURCE
+#undef CLOCK_TREE_CFG_PLLMUL
+#undef CLOCK_TREE_CFG_HPRE_DIV
+#undef CLOCK_TREE_CFG_PPRE1_DIV
+#undef CLOCK_TREE_CFG_PPRE2_DIV
+#undef CLOCK_TREE_CFG_ADCPRE_DIV
+}
+
+// HSI directly, with the AHB and both APB buses divided
+static void Test_HSI_Divided_Configuration(void)
+{
+#define CLOCK_TREE_HSE_HZ            (8000000u)
+#define CLOCK_TREE_CFG_SYSCLK_SOURCE (CLOCK_TREE_SYSCLK_SOURCE_HSI)
+#define CLOCK_TREE_CFG_PLL_SOURCE    (CLOCK_TREE_PLL_SOURCE_HSE)
+#define CLOCK_TREE_CFG_PLLMUL        (9u)
+#define CLOCK_TREE_CFG_HPRE_DIV      (2u)
+#define CLOCK_TREE_CFG_PPRE1_DIV     (4u)
+#define CLOCK_TREE_CFG_PPRE2_DIV     (16u)
+#define CLOCK_TREE_CFG_ADCPRE_DIV    (2u)
+
+    CHECK(CLOCK_TREE_SYSCLK_HZ, 8000000u);
+    CHECK(CLOCK_TREE_HCLK_HZ, 4000000u);
+    CHECK(CLOCK_TREE_PCLK1_HZ, 1000000u);
+    CHECK(CLOCK_TREE_PCLK2_HZ, 250000u);
+    CHECK(CLOCK_TREE_TIM2_CLK_HZ, 2000000u);
+    CHECK(CLOCK_TREE_TIM1_CLK_HZ, 500000u);
+    CHECK(CLOCK_TREE_ADC_CLK_HZ, 125000u);
+    CHECK(CLOCK_TREE_HPRE_BITS, 0b1000u);
+    CHECK(CLOCK_TREE_PPRE1_BITS, 0b101u);
+    CHECK(CLOCK_TREE_PPRE2_BITS, 0b111u);
+    CHECK(CLOCK_TREE_ADCPRE_BITS, 0b00u);
+    CHECK(CLOCK_TREE_FLASH_LATENCY, 0b000u);
+
+#undef CLOCK_TREE_HSE_HZ
+#undef CLOCK_TREE_CFG_SYSCLK_SOURCE
+#undef CLOCK_TREE_CFG_PLL_SOURCE
+#undef CLOCK_TREE_CFG_PLLMUL
+#undef CLOCK_TREE_CFG_HPRE_DIV
+#undef CLOCK_TREE_CFG_PPRE1_DIV
+#undef CLOCK_TREE_CFG_PPRE2_DIV
+#undef CLOCK_TREE_CFG_ADCPRE_DIV
+}
+
+// dividers the hardware cannot do encode as 0xFF, which the static asserts reject
+static void Test_Invalid_Prescalers(void)
+{
+#define CLOCK_TREE_CFG_HPRE_DIV   (32u)
+#define CLOCK_TREE_CFG_ADCPRE_DIV (5u)
+
+    CHECK(CLOCK_TREE_HPRE_BITS, 0xFFu);
+    CHECK(CLOCK_TREE_ADCPRE_BITS, 0xFFu);
+    CHECK(CLOCK_TREE_PPRE_BITS(3u), 0xFFu);
+    CHECK(CLOCK_TREE_PPRE_BITS(32u), 0xFFu);
+
+#undef CLOCK_TREE_CFG_HPRE_DIV
+#undef CLOCK_TREE_CFG_ADCPRE_DIV
+}
+
+static void Test_Timer_Helpers(void)
+{
+    // exact divisions
+    CHECK(CLOCK_TREE_TIMER_PSC(72000000u, 10000u), 7199u);
+    CHECK(CLOCK_TREE_TIMER_PSC(32000000u, 1000000u), 31u);
+    CHECK(CLOCK_TREE_TIMER_ARR(10000u, 1u), 9999u);
+    CHECK(CLOCK_TREE_TIMER_ARR(1000000u, 10000u), 99u);
+
+    // inexact divisions round to the nearest rate, truncating would be one less
+    CHECK(CLOCK_TREE_TIMER_PSC(72000000u, 7000u), 10285u); // 10285.7
+    CHECK(CLOCK_TREE_TIMER_PSC(72000000u, 7001u), 10283u); // 10284.2
+    CHECK(CLOCK_TREE_TIMER_ARR(10000u, 6u), 1666u);        // 1666.7
+    CHECK(CLOCK_TREE_TIMER_ARR(10000u, 3u), 3332u);        // 3333.3
+
+    // the 16 bit range
+    CHECK(CLOCK_TREE_TIMER_PSC(65536000u, 1000u) <= CLOCK_TREE_TIMER_MAX, 1u);
+    CHECK(CLOCK_TREE_TIMER_PSC(65537000u, 1000u) <= CLOCK_TREE_TIMER_MAX, 0u);
+    CHECK(CLOCK_TREE_TIMER_PSC(72000000u, 1000u) <= CLOCK_TREE_TIMER_MAX, 0u);
+    CHECK(CLOCK_TREE_TIMER_ARR(10000000u, 1u) <= CLOCK_TREE_TIMER_MAX, 0u);
+
+    // a rate above the input clock is out of range, not a huge divider
+    CHECK(CLOCK_TREE_TIMER_PSC(8000000u, 20000000u) <= CLOCK_TREE_TIMER_MAX, 0u);
+}
+
+static void Test_SPI_Helper(void)
+{
+    CHECK(CLOCK_TREE_SPI_BR(72000000u, 36000000u), 0b000u);
+    CHECK(CLOCK_TREE_SPI_BR(72000000u, 20000000u), 0b001u);
+    CHECK(CLOCK_TREE_SPI_BR(72000000u, 18000000u), 0b001u);
+    CHECK(CLOCK_TREE_SPI_BR(72000000u, 1000000u), 0b110u);
+    CHECK(CLOCK_TREE_SPI_BR(72000000u, 1000u), 0b111u);
+}
@@ -0,0 +1,436 @@
+/*
+--|----------------------------------------------------------------------------|
+--| FILE DESCRIPTION:
+--|   ring_buffer_stress.c is a Linux host stress test of PSP_Ring_Buffer,
+--|   with a producer and a consumer thread standing in for the interrupt and
+--|   thread contexts. Each pass streams a pattern through a small ring
+--|   buffer, so it wraps constantly, checks every byte on the consumer side,
+--|   and reports the throughput. It exits non-zero if any byte was lost,
+--|   repeated or corrupted.
+--|
+--|   To build and run it:
+--|   $ make host_test
+--|   $ ./bin/tools/ring_buffer_stress [bytes per pass] [ring buffer size]
+--|
+--|----------------------------------------------------------------------------|
+--| REFERENCES:
+--|   None.
+--|
+--|----------------------------------------------------------------------------|
+*/
+
+/*
+--|----------------------------------------------------------------------------|
+--| INCLUDE FILES
+--|----------------------------------------------------------------------------|
+*/
+
+#include "PSP_Ring_Buffer.h"
+
+#include <pthread.h>
+#include <sched.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <time.h>
+
+/*
+--|----------------------------------------------------------------------------|
+--| DEFINES
+--|----------------------------------------------------------------------------|
+*/
+
+/*
+--| NAME: DEFAULT_BYTES_PER_PASS
+--| DESCRIPTION: the bytes streamed through the ring buffer in each pass
+--| TYPE: unsigned integer
+*/
+#define DEFAULT_BYTES_PER_PASS (64u * 1024u * 1024u)
+
+/*
+--| NAME: DEFAULT_RING_SIZE
+--| DESCRIPTION: the ring buffer size, small so that it wraps constantly
+--| TYPE: unsigned integer
+*/
+#define DEFAULT_RING_SIZE (256u)
+
+/*
+--| NAME: MAX_RING_SIZE
+--| DESCRIPTION: the largest ring buffer size which may be asked for
+--| TYPE: unsigned integer
+*/
+#define MAX_RING_SIZE (1024u * 1024u)
+
+/*
+--| NAME: MAX_BLOCK_LENGTH
+--| DESCRIPTION: the most bytes written or read at once by the block passes
+--| TYPE: unsigned integer
+*/
+#define MAX_BLOCK_LENGTH (97u)
+
+/*
+--| NAME: STALL_SECONDS
+--| DESCRIPTION: how long either side may go without moving a byte before the
+--|   pass is failed as stalled, as a broken ring buffer can deadlock
+--| TYPE: floating point
+*/
+#define STALL_SECONDS (5.0)
+
+/*
+--| NAME: SPINS_PER_STALL_CHECK
+--| DESCRIPTION: the idle spins between checks of the clock for a stall
+--| TYPE: unsigned integer
+*/
+#define SPINS_PER_STALL_CHECK (1024u)
+
+/*
+--|----------------------------------------------------------------------------|
+--| TYPES
+--|----------------------------------------------------------------------------|
+*/
+
+/*
+--| NAME: Stress_Mode_enum
+--| DESCRIPTION: how each side moves bytes through the ring buffer
+*/
+typedef enum Stress_Mode_Enumeration
+{
+    STRESS_MODE_BYTES,  // Ring_Buffer_Put and Ring_Buffer_Get
+    STRESS_MODE_BLOCKS, // Ring_Buffer_Write and Ring_Buffer_Read, of varying lengths
+    STRESS_MODE_SPANS,  // the write and read spans, filled and used in place
+} Stress_Mode_enum;
+
+/*
+--| NAME: Stress_Pass_t
+--| DESCRIPTION: one pass, shared by the producer and consumer threads
+*/
+typedef struct Stress_Pass_Type
+{
+    Ring_Buffer_t    ring;         // the ring buffer under test
+    Stress_Mode_enum mode;         // how bytes are moved
+    uint32_t         total_bytes;  // the bytes to stream
+    uint32_t         bad_bytes;    // bytes the consumer did not expect, only written by the consumer
+    uint32_t         first_bad;    // the stream position of the first bad byte
+    volatile bool    stalled;      // set by either side if it stalled, stops both
+} Stress_Pass_t;
+
+/*
+--| NAME: Stall_Detector_t
+--| DESCRIPTION: one side's record of how long it has gone without progress
+*/
+typedef struct Stall_Detector_Type
+{
+    uint32_t idle_spins; // attempts in a row which moved nothing
+    double   idle_since; // the time of the first of them
+} Stall_Detector_t;
+
+/*
+--|----------------------------------------------------------------------------|
+--| CONSTANTS
+--|----------------------------------------------------------------------------|
+*/
+
+/*
+--| NAME: mode_names
+--| DESCRIPTION: the name of each mode, for the report
+--| TYPE: const char *[]
+*/
+static const char * const mode_names[] =
+{
+    [STRESS_MODE_BYTES]  = "bytes",
+    [STRESS_MODE_BLOCKS] = "blocks",
+    [STRESS_MODE_SPANS]  = "spans",
+};
+
+/*
+--|----------------------------------------------------------------------------|
+--| VARIABLES
+--|----------------------------------------------------------------------------|
+*/
+
+/*
+--| NAME: ring_storage
+--| DESCRIPTION: the ring buffer storage
+--| TYPE: uint8_t[]
+*/
+static uint8_t ring_storage[MAX_RING_SIZE];
+
+/*
+--|----------------------------------------------------------------------------|
+--| FUNCTION PROTOTYPES
+--|----------------------------------------------------------------------------|
+*/
+
+static bool Run_Pass(Stress_Mode_enum mode, uint32_t total_bytes, uint32_t ring_size);
+static void * Producer(void * p_argument);
+static void * Consumer(void * p_argument);
+static bool Is_Stalled(Stress_Pass_t * p_pass, Stall_Detector_t * p_detector, uint32_t moved);
+static void Check_Bytes(Stress_Pass_t * p_pass, const uint8_t * p_data, uint32_t length, uint32_t position);
+static uint8_t Pattern(uint32_t position);
+static uint32_t Block_Length(uint32_t step);
+static double Get_Seconds(void);
+
+/*
+--|----------------------------------------------------------------------------|
+--| FUNCTION DEFINITIONS
+--|----------------------------------------------------------------------------|
+*/
+
+int main(int argc, char * argv[])
+{
+    const uint32_t total_bytes = (argc > 1) ? (uint32_t)strtoul(argv[1], NULL, 0) : DEFAULT_BYTES_PER_PASS;
+    const uint32_t ring_size   = (argc > 2) ? (uint32_t)strtoul(argv[2], NULL, 0) : DEFAULT_RING_SIZE;
+    bool           passed      = true;
+
+    if ((argc > 3) || (ring_size > MAX_RING_SIZE))
+    {
+        fprintf(stderr, "usage: %s [bytes per pass] [ring buffer size, a power of 2 up to %u]\n",
+                argv[0], MAX_RING_SIZE);
+        return EXIT_FAILURE;
+    }
+
+    passed = Run_Pass(STRESS_MODE_BYTES, total_bytes, ring_size) && passed;
+    passed = Run_Pass(STRESS_MODE_BLOCKS, total_bytes, ring_size) && passed;
+    passed = Run_Pass(STRESS_MODE_SPANS, total_bytes, ring_size) && passed;
+
+    return passed ? EXIT_SUCCESS : EXIT_FAILURE;
+}
+
+/*
+--|----------------------------------------------------------------------------|
+--| HELPER FUNCTION DEFINITIONS
+--|----------------------------------------------------------------------------|
+*/
+
+static bool Run_Pass(Stress_Mode_enum mode, uint32_t total_bytes, uint32_t ring_size)
+{
+    Stress_Pass_t pass = {.mode = mode, .total_bytes = total_bytes};
+    pthread_t     producer;
+    pthread_t     consumer;
+    double        seconds;
+
+    if (!Ring_Buffer_Init(&pass.ring, ring_storage, ring_size))
+    {
+        fprintf(stderr, "ring buffer size %u is not a power of 2\n", ring_size);
+        return false;
+    }
+
+    seconds = Get_Seconds();
+
+    if ((pthread_create(&consumer, NULL, Consumer, &pass) != 0) ||
+        (pthread_create(&producer, NULL, Producer, &pass) != 0))
+    {
+        fprintf(stderr, "could not start the threads\n");
+        exit(EXIT_FAILURE);
+    }
+
+    pthread_join(producer, NULL);
+    pthread_join(consumer, NULL);
+
+    seconds = Get_Seconds() - seconds;
+
+    if (pass.stalled)
+    {
+        printf("%-6s: FAILED, stalled for %.0f s with %u of %u bytes waiting\n", mode_names[mode],
+               STALL_SECONDS, Ring_Buffer_Get_Count(&pass.ring), ring_size);
+        return false;
+    }
+
+    printf("%-6s: %u bytes through %u in %.3f s, %.1f MB/s, ",
+           mode_names[mode], total_bytes, ring_size, seconds, (total_bytes / seconds) / 1e6);
+
+    if (pass.bad_bytes != 0u)
+    {
+        printf("FAILED, %u bad bytes, the first at %u\n", pass.bad_bytes, pass.first_bad);
+        return false;
+    }
+
+    printf("passed\n");
+    return true;
+}
+
+static void * Producer(void * p_argument)
+{
+    Stress_Pass_t *  p_pass   = p_argument;
+    uint32_t         position = 0u;
+    uint32_t         step     = 0u;
+    Stall_Detector_t detector = {0};
+    uint8_t          block[MAX_BLOCK_LENGTH];
+
+    while ((position < p_pass->total_bytes) && !p_pass->stalled)
+    {
+        uint32_t length = Block_Length(step++);
+        uint32_t moved  = 0u;
+        uint32_t i;
+
+        if (length > (p_pass->total_bytes - position))
+        {
+            length = p_pass->total_bytes - position;
+        }
+
+        switch (p_pass->mode)
+        {
+            case STRESS_MODE_BYTES:
+                moved = Ring_Buffer_Put(&p_pass->ring, Pattern(position)) ? 1u : 0u;
+                break;
+
+            case STRESS_MODE_BLOCKS:
+                for (i = 0u; i < length; i++)
+                {
+                    block[i] = Pattern(position + i);
+                }
+                moved = Ring_Buffer_Write(&p_pass->ring, block, length);
+                break;
+
+            case STRESS_MODE_SPANS:
+            {
+                uint8_t * p_span = Ring_Buffer_Get_Write_Span(&p_pass->ring, &moved);
+
+                if (moved > length)
+                {
+                    moved = length;
+                }
+                for (i = 0u; i < moved; i++)
+                {
+                    p_span[i] = Pattern(position + i);
+                }
+                Ring_Buffer_Commit_Write(&p_pass->ring, moved);
+                break;
+            }
+        }
+
+        position += moved;
+
+        if (Is_Stalled(p_pass, &detector, moved))
+        {
+            break;
+        }
+
+        if (moved == 0u)
+        {
+            // full, let the consumer run if the threads share a core
+            sched_yield();
+        }
+    }
+
+    return NULL;
+}
+
+static void * Consumer(void * p_argument)
+{
+    Stress_Pass_t *  p_pass   = p_argument;
+    uint32_t         position = 0u;
+    uint32_t         step     = 0u;
+    Stall_Detector_t detector = {0};
+    uint8_t          block[MAX_BLOCK_LENGTH];
+
+    while ((position < p_pass->total_bytes) && !p_pass->stalled)
+    {
+        const uint32_t length = Block_Length(step++);
+        uint32_t       moved  = 0u;
+
+        switch (p_pass->mode)
+        {
+            case STRESS_MODE_BYTES:
+                moved = Ring_Buffer_Get(&p_pass->ring, block) ? 1u : 0u;
+                Check_Bytes(p_pass, block, moved, position);
+                break;
+
+            case STRESS_MODE_BLOCKS:
+                moved = Ring_Buffer_Read(&p_pass->ring, block, length);
+                Check_Bytes(p_pass, block, moved, position);
+                break;
+
+            case STRESS_MODE_SPANS:
+            {
+                const uint8_t * p_span = Ring_Buffer_Get_Read_Span(&p_pass->ring, &moved);
+
+                if (moved > length)
+                {
+                    moved = length;
+                }
+                Check_Bytes(p_pass, p_span, moved, position);
+                Ring_Buffer_Commit_Read(&p_pass->ring, moved);
+                break;
+            }
+        }
+
+        position += moved;
+
+        if (Is_Stalled(p_pass, &detector, moved))
+        {
+            break;
+        }
+
+        if (moved == 0u)
+        {
+            // empty, let the producer run if the threads share a core
+            sched_yield();
+        }
+    }
+
+    // the producer stops at total_bytes, so anything left over was duplicated
+    if (Ring_Buffer_Get_Count(&p_pass->ring) != 0u)
+    {
+        p_pass->bad_bytes += Ring_Buffer_Get_Count(&p_pass->ring);
+    }
+
+    return NULL;
+}
+
+static bool Is_Stalled(Stress_Pass_t * p_pass, Stall_Detector_t * p_detector, uint32_t moved)
+{
+    if (moved != 0u)
+    {
+        p_detector->idle_spins = 0u;
+    }
+    else if (p_detector->idle_spins++ == 0u)
+    {
+        p_detector->idle_since = Get_Seconds();
+    }
+    else if (((p_detector->idle_spins % SPINS_PER_STALL_CHECK) == 0u) &&
+             ((Get_Seconds() - p_detector->idle_since) > STALL_SECONDS))
+    {
+        p_pass->stalled = true;
+    }
+
+    return p_pass->stalled;
+}
+
+static void Check_Bytes(Stress_Pass_t * p_pass, const uint8_t * p_data, uint32_t length, uint32_t position)
+{
+    uint32_t i;
+
+    for (i = 0u; i < length; i++)
+    {
+        if (p_data[i] != Pattern(position + i))
+        {
+            if (p_pass->bad_bytes == 0u)
+            {
+                p_pass->first_bad = position + i;
+            }
+            p_pass->bad_bytes++;
+        }
+    }
+}
+
+// a byte which depends on all the bits of the position, so a lost or repeated
+// run of bytes is caught whatever its length, unlike a plain counter
+static uint8_t Pattern(uint32_t position)
+{
+    return (uint8_t)((position * 2654435761u) >> 24);
+}
+
+// 1 to MAX_BLOCK_LENGTH, varied so the spans split at every point of the storage
+static uint32_t Block_Length(uint32_t step)
+{
+    return ((step * 37u) % MAX_BLOCK_LENGTH) + 1u;
+}
+
+static double Get_Seconds(void)
+{
+    struct timespec now;
+
+    clock_gettime(CLOCK_MONOTONIC, &now);
+
+    return (double)now.tv_sec + ((double)now.tv_nsec / 1e9);
+}
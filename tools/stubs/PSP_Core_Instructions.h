@@ -0,0 +1,193 @@
+/*
+--|----------------------------------------------------------------------------|
+--| FILE DESCRIPTION:
+--|   PSP_Core_Instructions.h is a host stand in for the Cortex-M3 header of
+--|   the same name, for host tools which build library sources. It is found
+--|   first through the include path, and only provides what they use.
+--|   Interrupts are the calls a host test makes into handlers, so masking
+--|   them only has to order the compiler's memory accesses.
+--|
+--|----------------------------------------------------------------------------|
+--| REFERENCES:
+--|   None.
+--|
+--|----------------------------------------------------------------------------|
+*/
+
+#ifndef PSP_CORE_INSTRUCTIONS_H_INCLUDED
+#define PSP_CORE_INSTRUCTIONS_H_INCLUDED
+
+/*
+--|----------------------------------------------------------------------------|
+--| INCLUDE FILES
+--|----------------------------------------------------------------------------|
+*/
+
+#include "Common_Typedefs.h"
+
+/*
+--|----------------------------------------------------------------------------|
+--| PUBLIC DEFINES
+--|----------------------------------------------------------------------------|
+*/
+
+/* None */
+
+/*
+--|----------------------------------------------------------------------------|
+--| PUBLIC TYPES
+--|----------------------------------------------------------------------------|
+*/
+
+/* None */
+
+/*
+--|----------------------------------------------------------------------------|
+--| PUBLIC CONSTANTS
+--|----------------------------------------------------------------------------|
+*/
+
+/* None */
+
+/*
+--|----------------------------------------------------------------------------|
+--| PUBLIC VARIABLES
+--|----------------------------------------------------------------------------|
+*/
+
+/* None */
+
+/*
+--|----------------------------------------------------------------------------|
+--| PUBLIC FUNCTION PROTOTYPES
+--|----------------------------------------------------------------------------|
+*/
+
+/*------------------------------------------------------------------------------
+Function Name:
+    Core_Data_Memory_Barrier
+
+Function Description:
+    Order the memory accesses before the barrier ahead of those after it,
+    in the compiler and the host CPU, as DMB does on the target.
+
+Parameters:
+    None
+
+Returns:
+    None
+
+Assumptions/Limitations:
+    None
+------------------------------------------------------------------------------*/
+static inline void Core_Data_Memory_Barrier(void)
+{
+    __atomic_thread_fence(__ATOMIC_SEQ_CST);
+}
+
+/*------------------------------------------------------------------------------
+Function Name:
+    Core_Data_Sync_Barrier
+
+Function Description:
+    Complete the memory accesses before the barrier before continuing, as
+    DSB does on the target.
+
+Parameters:
+    None
+
+Returns:
+    None
+
+Assumptions/Limitations:
+    None
+------------------------------------------------------------------------------*/
+static inline void Core_Data_Sync_Barrier(void)
+{
+    __atomic_thread_fence(__ATOMIC_SEQ_CST);
+}
+
+/*------------------------------------------------------------------------------
+Function Name:
+    Core_Instruction_Sync_Barrier
+
+Function Description:
+    Stop the compiler moving accesses across the barrier, ISB has nothing
+    else to do on the host.
+
+Parameters:
+    None
+
+Returns:
+    None
+
+Assumptions/Limitations:
+    None
+------------------------------------------------------------------------------*/
+static inline void Core_Instruction_Sync_Barrier(void)
+{
+    __atomic_signal_fence(__ATOMIC_SEQ_CST);
+}
+
+/*------------------------------------------------------------------------------
+Function Name:
+    Core_Disable_Interrupts
+
+Function Description:
+    Stop the compiler moving accesses across the call, as CPSID i does.
+
+Parameters:
+    None
+
+Returns:
+    None
+
+Assumptions/Limitations:
+    None
+------------------------------------------------------------------------------*/
+static inline void Core_Disable_Interrupts(void)
+{
+    __atomic_signal_fence(__ATOMIC_SEQ_CST);
+}
+
+/*------------------------------------------------------------------------------
+Function Name:
+    Core_Enable_Interrupts
+
+Function Description:
+    Stop the compiler moving accesses across the call, as CPSIE i does.
+
+Parameters:
+    None
+
+Returns:
+    None
+
+Assumptions/Limitations:
+    None
+------------------------------------------------------------------------------*/
+static inline void Core_Enable_Interrupts(void)
+{
+    __atomic_signal_fence(__ATOMIC_SEQ_CST);
+}
+
+/*------------------------------------------------------------------------------
+Function Name:
+    Core_Wait_For_Interrupt
+
+Function Description:
+    Sleep until an interrupt is pending, as WFI does.
+
+Parameters:
+    None
+
+Returns:
+    None
+
+Assumptions/Limitations:
+    Defined by the host test which calls code that sleeps, to simulate the
+    time spent asleep.
+------------------------------------------------------------------------------*/
+void Core_Wait_For_Interrupt(void);
+
+#endif
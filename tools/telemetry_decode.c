@@ -0,0 +1,535 @@
+/*
+--|----------------------------------------------------------------------------|
+--| FILE DESCRIPTION:
+--|   telemetry_decode.c is a Linux host tool which decodes the binary
+--|   telemetry stream sent by PSP_Telemetry, from a file (such as a capture)
+--|   or a serial port or pty, and prints one line per record.
+--|
+--|   To build and run it:
+--|   $ make tools
+--|   $ ./bin/tools/telemetry_decode /dev/ttyUSB0 2000000
+--|   $ ./bin/tools/telemetry_decode capture.bin
+--|
+--|----------------------------------------------------------------------------|
+--| REFERENCES:
+--|   Consistent Overhead Byte Stuffing, S. Cheshire and M. Baker, 1999
+--|
+--|----------------------------------------------------------------------------|
+*/
+
+/*
+--|----------------------------------------------------------------------------|
+--| INCLUDE FILES
+--|----------------------------------------------------------------------------|
+*/
+
+// before termios.h, whose CR1 to CR3 macros clash with the USART register names
+#include "PSP_Telemetry.h"
+
+#include <errno.h>
+#include <fcntl.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <termios.h>
+#include <unistd.h>
+
+/*
+--|----------------------------------------------------------------------------|
+--| DEFINES
+--|----------------------------------------------------------------------------|
+*/
+
+/*
+--| NAME: MAX_RECORD_LENGTH
+--| DESCRIPTION: the most bytes in one decoded record
+--| TYPE: unsigned integer
+*/
+#define MAX_RECORD_LENGTH (TELEMETRY_HEADER_LENGTH + TELEMETRY_MAX_PAYLOAD_LENGTH + TELEMETRY_CRC_LENGTH)
+
+/*
+--| NAME: MAX_FRAME_LENGTH
+--| DESCRIPTION: the most bytes in one encoded record, without the delimiter
+--| TYPE: unsigned integer
+*/
+#define MAX_FRAME_LENGTH (MAX_RECORD_LENGTH + (MAX_RECORD_LENGTH / 254u) + 1u)
+
+/*
+--| NAME: CRC_POLYNOMIAL
+--| DESCRIPTION: the polynomial of the CRC unit
+--| TYPE: unsigned integer
+*/
+#define CRC_POLYNOMIAL (0x04C11DB7u)
+
+/*
+--|----------------------------------------------------------------------------|
+--| TYPES
+--|----------------------------------------------------------------------------|
+*/
+
+/*
+--| NAME: Decoder_Stats_t
+--| DESCRIPTION: counts of what the decoder has seen
+*/
+typedef struct Decoder_Stats_Type
+{
+    unsigned long records;       // records decoded
+    unsigned long bad_frames;    // frames which failed COBS, length or CRC checks
+    unsigned long lost_records;  // records missing from the sequence
+    unsigned long overlong;      // frames longer than any record
+} Decoder_Stats_t;
+
+/*
+--|----------------------------------------------------------------------------|
+--| CONSTANTS
+--|----------------------------------------------------------------------------|
+*/
+
+/* None */
+
+/*
+--|----------------------------------------------------------------------------|
+--| VARIABLES
+--|----------------------------------------------------------------------------|
+*/
+
+/* None */
+
+/*
+--|----------------------------------------------------------------------------|
+--| FUNCTION PROTOTYPES
+--|----------------------------------------------------------------------------|
+*/
+
+static int Open_Input(const char * p_path, unsigned long baud_rate);
+static speed_t Get_Speed(unsigned long baud_rate);
+static uint32_t COBS_Decode(const uint8_t * p_source, uint32_t length, uint8_t * p_destination);
+static uint32_t CRC_Calculate_Host(const uint8_t * p_bytes, uint32_t length);
+static void Decode_Frame(const uint8_t * p_frame, uint32_t length, Decoder_Stats_t * p_stats, int * p_expected_sequence);
+static void Print_Payload(uint8_t type, const uint8_t * p_payload, uint32_t length);
+
+/*
+--|----------------------------------------------------------------------------|
+--| FUNCTION DEFINITIONS
+--|----------------------------------------------------------------------------|
+*/
+
+int main(int argc, char * argv[])
+{
+    Decoder_Stats_t stats             = {0};
+    uint8_t         frame[MAX_FRAME_LENGTH];
+    uint32_t        frame_length      = 0u;
+    int             expected_sequence = -1;
+    bool            overlong          = false;
+    uint8_t         input[4096];
+    ssize_t         num_read;
+    int             fd;
+
+    if ((argc < 2) || (argc > 3))
+    {
+        fprintf(stderr, "usage: %s <file, serial port or pty> [baud rate]\n", argv[0]);
+        return EXIT_FAILURE;
+    }
+
+    fd = Open_Input(argv[1], (argc == 3) ? strtoul(argv[2], NULL, 0) : 0u);
+    if (fd < 0)
+    {
+        return EXIT_FAILURE;
+    }
+
+    while ((num_read = read(fd, input, sizeof(input))) != 0)
+    {
+        ssize_t i;
+
+        if (num_read < 0)
+        {
+            if (errno == EINTR)
+            {
+                continue;
+            }
+
+            perror("read");
+            break;
+        }
+
+        for (i = 0; i < num_read; i++)
+        {
+            if (input[i] == 0u)
+            {
+                if (overlong)
+                {
+                    stats.overlong++;
+                }
+                else if (frame_length != 0u)
+                {
+                    Decode_Frame(frame, frame_length, &stats, &expected_sequence);
+                }
+
+                frame_length = 0u;
+                overlong     = false;
+            }
+            else if (frame_length < MAX_FRAME_LENGTH)
+            {
+                frame[frame_length++] = input[i];
+            }
+            else
+            {
+                // wait for the next delimiter to get back in step
+                overlong = true;
+            }
+        }
+
+        fflush(stdout);
+    }
+
+    fprintf(stderr, "%lu records, %lu bad frames, %lu overlong frames, %lu records lost\n",
+            stats.records, stats.bad_frames, stats.overlong, stats.lost_records);
+
+    close(fd);
+
+    return EXIT_SUCCESS;
+}
+
+/*------------------------------------------------------------------------------
+Function Name:
+    Open_Input
+
+Function Description:
+    Open the input, putting it in raw mode if it is a terminal.
+
+Parameters:
+    p_path: the file, serial port or pty.
+    baud_rate: the baud rate to set on a serial port, 0 to leave it.
+
+Returns:
+    int: the file descriptor, or -1 on error.
+
+Assumptions/Limitations:
+    None
+------------------------------------------------------------------------------*/
+static int Open_Input(const char * p_path, unsigned long baud_rate)
+{
+    struct termios settings;
+    int            fd = open(p_path, O_RDONLY | O_NOCTTY);
+
+    if (fd < 0)
+    {
+        perror(p_path);
+        return -1;
+    }
+
+    if (isatty(fd))
+    {
+        if (tcgetattr(fd, &settings) != 0)
+        {
+            perror("tcgetattr");
+            close(fd);
+            return -1;
+        }
+
+        cfmakeraw(&settings);
+        settings.c_cc[VMIN]  = 1;
+        settings.c_cc[VTIME] = 0;
+
+        if (baud_rate != 0u)
+        {
+            const speed_t speed = Get_Speed(baud_rate);
+
+            if (speed == B0)
+            {
+                fprintf(stderr, "unsupported baud rate %lu\n", baud_rate);
+                close(fd);
+                return -1;
+            }
+
+            cfsetispeed(&settings, speed);
+            cfsetospeed(&settings, speed);
+        }
+
+        if (tcsetattr(fd, TCSANOW, &settings) != 0)
+        {
+            perror("tcsetattr");
+            close(fd);
+            return -1;
+        }
+    }
+
+    return fd;
+}
+
+/*------------------------------------------------------------------------------
+Function Name:
+    Get_Speed
+
+Function Description:
+    Get the termios speed for a baud rate.
+
+Parameters:
+    baud_rate: bits per second.
+
+Returns:
+    speed_t: the speed, or B0 if termios has none for the baud rate.
+
+Assumptions/Limitations:
+    None
+------------------------------------------------------------------------------*/
+static speed_t Get_Speed(unsigned long baud_rate)
+{
+    switch (baud_rate)
+    {
+        case 9600u:    return B9600;
+        case 19200u:   return B19200;
+        case 38400u:   return B38400;
+        case 57600u:   return B57600;
+        case 115200u:  return B115200;
+        case 230400u:  return B230400;
+        case 460800u:  return B460800;
+        case 921600u:  return B921600;
+        case 1000000u: return B1000000;
+        case 2000000u: return B2000000;
+        default:       return B0;
+    }
+}
+
+/*------------------------------------------------------------------------------
+Function Name:
+    COBS_Decode
+
+Function Description:
+    Decode one COBS frame, without its delimiter.
+
+Parameters:
+    p_source: the encoded bytes.
+    length: the number of encoded bytes.
+    p_destination: filled in with the decoded bytes, room for length bytes.
+
+Returns:
+    uint32_t: the number of decoded bytes, or 0 if the frame is malformed.
+
+Assumptions/Limitations:
+    None
+------------------------------------------------------------------------------*/
+static uint32_t COBS_Decode(const uint8_t * p_source, uint32_t length, uint8_t * p_destination)
+{
+    uint32_t read_index  = 0u;
+    uint32_t write_index = 0u;
+
+    while (read_index < length)
+    {
+        const uint8_t code = p_source[read_index++];
+        uint8_t       i;
+
+        if ((code == 0u) || ((read_index + code - 1u) > length))
+        {
+            return 0u;
+        }
+
+        for (i = 1u; i < code; i++)
+        {
+            p_destination[write_index++] = p_source[read_index++];
+        }
+
+        // a code below the maximum stands for a 0, except at the end of the frame
+        if ((code != 0xFFu) && (read_index < length))
+        {
+            p_destination[write_index++] = 0u;
+        }
+    }
+
+    return write_index;
+}
+
+/*------------------------------------------------------------------------------
+Function Name:
+    CRC_Calculate_Host
+
+Function Description:
+    Compute the CRC the way the target's CRC unit does: CRC-32 from
+    0xFFFFFFFF over little endian words, most significant bit first, with
+    no reflection and no final XOR. The bytes are padded with zeros to
+    whole words.
+
+Parameters:
+    p_bytes: the bytes.
+    length: the number of bytes.
+
+Returns:
+    uint32_t: the CRC.
+
+Assumptions/Limitations:
+    None
+------------------------------------------------------------------------------*/
+static uint32_t CRC_Calculate_Host(const uint8_t * p_bytes, uint32_t length)
+{
+    uint32_t crc = 0xFFFFFFFFu;
+    uint32_t i;
+
+    for (i = 0u; i < length; i += 4u)
+    {
+        uint32_t word = 0u;
+        uint32_t j;
+
+        for (j = 0u; (j < 4u) && ((i + j) < length); j++)
+        {
+            word |= (uint32_t)p_bytes[i + j] << (8u * j);
+        }
+
+        crc ^= word;
+
+        for (j = 0u; j < 32u; j++)
+        {
+            crc = ((crc & 0x80000000u) != 0u) ? ((crc << 1u) ^ CRC_POLYNOMIAL) : (crc << 1u);
+        }
+    }
+
+    return crc;
+}
+
+/*------------------------------------------------------------------------------
+Function Name:
+    Decode_Frame
+
+Function Description:
+    Check and print one frame.
+
+Parameters:
+    p_frame: the encoded bytes, without the delimiter.
+    length: the number of encoded bytes.
+    p_stats: the counts, updated.
+    p_expected_sequence: the sequence number of the next record, -1 before
+    the first record, updated.
+
+Returns:
+    None
+
+Assumptions/Limitations:
+    None
+------------------------------------------------------------------------------*/
+static void Decode_Frame(const uint8_t * p_frame, uint32_t length, Decoder_Stats_t * p_stats, int * p_expected_sequence)
+{
+    uint8_t  record[MAX_FRAME_LENGTH];
+    uint32_t record_length = COBS_Decode(p_frame, length, record);
+    uint32_t payload_length;
+    uint32_t sequence;
+    uint32_t crc;
+
+    if (record_length < (TELEMETRY_HEADER_LENGTH + TELEMETRY_CRC_LENGTH))
+    {
+        p_stats->bad_frames++;
+        return;
+    }
+
+    payload_length = record[1];
+    if (record_length != (TELEMETRY_HEADER_LENGTH + payload_length + TELEMETRY_CRC_LENGTH))
+    {
+        p_stats->bad_frames++;
+        return;
+    }
+
+    crc = (uint32_t)record[record_length - 4u]
+        | ((uint32_t)record[record_length - 3u] << 8u)
+        | ((uint32_t)record[record_length - 2u] << 16u)
+        | ((uint32_t)record[record_length - 1u] << 24u);
+
+    if (crc != CRC_Calculate_Host(record, TELEMETRY_HEADER_LENGTH + payload_length))
+    {
+        p_stats->bad_frames++;
+        return;
+    }
+
+    sequence = (uint32_t)record[2] | ((uint32_t)record[3] << 8u);
+    if (*p_expected_sequence >= 0)
+    {
+        p_stats->lost_records += (sequence - (uint32_t)*p_expected_sequence) & 0xFFFFu;
+    }
+
+    *p_expected_sequence = (int)((sequence + 1u) & 0xFFFFu);
+    p_stats->records++;
+
+    printf("%5u ", sequence);
+    Print_Payload(record[0], &record[TELEMETRY_HEADER_LENGTH], payload_length);
+    printf("\n");
+}
+
+/*------------------------------------------------------------------------------
+Function Name:
+    Print_Payload
+
+Function Description:
+    Print a record's type and payload.
+
+Parameters:
+    type: the record type.
+    p_payload: the payload.
+    length: the payload length in bytes.
+
+Returns:
+    None
+
+Assumptions/Limitations:
+    Array payloads are printed to the last whole element.
+------------------------------------------------------------------------------*/
+static void Print_Payload(uint8_t type, const uint8_t * p_payload, uint32_t length)
+{
+    uint32_t i;
+
+    switch (type)
+    {
+        case TELEMETRY_RECORD_TYPE_TEXT:
+            printf("text \"%.*s\"", (int)length, (const char *)p_payload);
+            break;
+
+        case TELEMETRY_RECORD_TYPE_U8:
+            printf("u8 ");
+            for (i = 0u; i < length; i++)
+            {
+                printf(" %u", p_payload[i]);
+            }
+            break;
+
+        case TELEMETRY_RECORD_TYPE_U16:
+            printf("u16");
+            for (i = 0u; (i + 2u) <= length; i += 2u)
+            {
+                printf(" %u", (unsigned)(p_payload[i] | (p_payload[i + 1u] << 8u)));
+            }
+            break;
+
+        case TELEMETRY_RECORD_TYPE_U32:
+        case TELEMETRY_RECORD_TYPE_I32:
+        case TELEMETRY_RECORD_TYPE_F32:
+            printf("%s", (type == TELEMETRY_RECORD_TYPE_U32) ? "u32" : (type == TELEMETRY_RECORD_TYPE_I32) ? "i32" : "f32");
+            for (i = 0u; (i + 4u) <= length; i += 4u)
+            {
+                uint32_t word = (uint32_t)p_payload[i]
+                              | ((uint32_t)p_payload[i + 1u] << 8u)
+                              | ((uint32_t)p_payload[i + 2u] << 16u)
+                              | ((uint32_t)p_payload[i + 3u] << 24u);
+
+                if (type == TELEMETRY_RECORD_TYPE_U32)
+                {
+                    printf(" %u", word);
+                }
+                else if (type == TELEMETRY_RECORD_TYPE_I32)
+                {
+                    printf(" %d", (int32_t)word);
+                }
+                else
+                {
+                    float32_t value;
+
+                    memcpy(&value, &word, sizeof(value));
+                    printf(" %g", value);
+                }
+            }
+            break;
+
+        default:
+            printf("type 0x%02X", type);
+            for (i = 0u; i < length; i++)
+            {
+                printf(" %02X", p_payload[i]);
+            }
+            break;
+    }
+}
@@ -0,0 +1,618 @@
+/*
+--|----------------------------------------------------------------------------|
+--| FILE DESCRIPTION:
+--|   tickless_test.c is a Linux x86-64 host test of SysTick_Tickless_Idle,
+--|   built with PSP_SysTick.c and PSP_DWT.c. The core peripherals are mapped
+--|   as memory at their target addresses, and every access to the SysTick
+--|   page is trapped and single stepped, so that a model of the counter can
+--|   see each register read and write as the hardware would. The DWT cycle
+--|   counter is plain memory which the model counts, and stops in sleep
+--|   unless a debugger is modelled.
+--|
+--|   Each register access takes one cycle, and the core sleeps in
+--|   Core_Wait_For_Interrupt until the SysTick deadline or a modelled early
+--|   wakeup. Every tick the handler counts is checked to be on the 1 mSec
+--|   grid of the first tick, and to bring the count to its place on it.
+--|
+--|   To build and run it:
+--|   $ make host_test
+--|
+--|----------------------------------------------------------------------------|
+--| REFERENCES:
+--|   PM0056 programming manual, page 150
+--|
+--|----------------------------------------------------------------------------|
+*/
+
+/*
+--|----------------------------------------------------------------------------|
+--| INCLUDE FILES
+--|----------------------------------------------------------------------------|
+*/
+
+// for the register names in ucontext_t
+#define _GNU_SOURCE
+
+#include "PSP_Core_Instructions.h"
+#include "PSP_DWT.h"
+#include "PSP_SysTick.h"
+#include "PSP_System_Clock_Init.h"
+
+#include <signal.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <sys/mman.h>
+#include <ucontext.h>
+#include <unistd.h>
+
+/*
+--|----------------------------------------------------------------------------|
+--| DEFINES
+--|----------------------------------------------------------------------------|
+*/
+
+/*
+--| NAME: CHECK
+--| DESCRIPTION: compare an unsigned value against its expected value, and
+--|   count and print a failure
+--| TYPE: statement
+*/
+#define CHECK(actual, expected) Check((unsigned long)(actual), (unsigned long)(expected), #actual, __LINE__)
+
+/*
+--| NAME: CYCLES_PER_MSEC
+--| DESCRIPTION: the core clock cycles in one tick
+--| TYPE: unsigned integer
+*/
+#define CYCLES_PER_MSEC (SYSTEM_CLOCK_SPEED / 1000u)
+
+/*
+--| NAME: TOLERANCE_CYCLES
+--| DESCRIPTION: how far a tick may drift from the grid, and the DWT from the
+--|   model's clock, as the counter stops for a few cycles at each sleep
+--| TYPE: unsigned integer
+*/
+#define TOLERANCE_CYCLES (256u)
+
+/*
+--| NAME: PERIPHERAL_MAP_SIZE
+--| DESCRIPTION: the bytes mapped from PSP_CORE_PERIPHERAL_BASE, up to the end
+--|   of the system control space
+--| TYPE: unsigned integer
+*/
+#define PERIPHERAL_MAP_SIZE (0x10000u)
+
+/*
+--| NAME: EFLAGS_TRAP_FLAG
+--| DESCRIPTION: the x86 single step flag
+--| TYPE: unsigned integer
+*/
+#define EFLAGS_TRAP_FLAG (0x100u)
+
+/*
+--| NAME: PAGE_FAULT_WRITE_FLAG
+--| DESCRIPTION: the x86 page fault error code bit for a write, a read modify
+--|   write instruction faults as a write
+--| TYPE: unsigned integer
+*/
+#define PAGE_FAULT_WRITE_FLAG (0x2u)
+
+/*
+--| NAME: MAX_SLEEP_CYCLES
+--| DESCRIPTION: a sleep longer than this will never be woken
+--| TYPE: unsigned integer
+*/
+#define MAX_SLEEP_CYCLES (2u * (SYSTICK_MAX_RELOAD + 1u))
+
+/*
+--|----------------------------------------------------------------------------|
+--| TYPES
+--|----------------------------------------------------------------------------|
+*/
+
+/*
+--| NAME: SysTick_Model_t
+--| DESCRIPTION: the state of the modelled SysTick counter and core clock
+--| TYPE: struct
+*/
+typedef struct
+{
+    uint64_t cycle;                // core clock cycles since the test started
+    uint32_t ctrl;                 // the control register, without the count flag
+    uint32_t load;                 // the reload register
+    uint32_t count;                // the current value register
+    bool     count_flag;           // the counter reached 0 since the control register was read
+    bool     tick_pending;         // the SysTick interrupt is pending
+    uint64_t last_tick_cycle;      // the cycle on which the counter last reached 0
+    bool     asleep;               // the core is in Core_Wait_For_Interrupt
+    bool     dwt_clocked_in_sleep; // a debugger keeps the DWT counting in sleep
+    uint64_t wake_after_cycles;    // wake early after this long asleep, 0 for no early wakeup
+    uint32_t sleeps;               // calls of Core_Wait_For_Interrupt
+    uint32_t sleep_reload;         // the reload register in the last sleep
+} SysTick_Model_t;
+
+/*
+--|----------------------------------------------------------------------------|
+--| CONSTANTS
+--|----------------------------------------------------------------------------|
+*/
+
+/* None */
+
+/*
+--|----------------------------------------------------------------------------|
+--| VARIABLES
+--|----------------------------------------------------------------------------|
+*/
+
+/*
+--| NAME: num_checks
+--| DESCRIPTION: the checks made so far
+--| TYPE: unsigned int
+*/
+static unsigned int num_checks = 0u;
+
+/*
+--| NAME: num_failures
+--| DESCRIPTION: the checks failed so far
+--| TYPE: unsigned int
+*/
+static unsigned int num_failures = 0u;
+
+/*
+--| NAME: model
+--| DESCRIPTION: the modelled SysTick counter and core clock
+--| TYPE: SysTick_Model_t
+*/
+static SysTick_Model_t model;
+
+/*
+--| NAME: p_systick_page
+--| DESCRIPTION: the trapped page, holding SysTick, the NVIC and the SCB
+--| TYPE: void *
+*/
+static void * p_systick_page;
+
+/*
+--| NAME: page_size
+--| DESCRIPTION: the host page size
+--| TYPE: size_t
+*/
+static size_t page_size;
+
+/*
+--| NAME: access_address
+--| DESCRIPTION: the address of the trapped access being single stepped
+--| TYPE: uintptr_t
+*/
+static volatile uintptr_t access_address;
+
+/*
+--| NAME: access_is_write
+--| DESCRIPTION: the trapped access being single stepped writes
+--| TYPE: bool
+*/
+static volatile bool access_is_write;
+
+/*
+--|----------------------------------------------------------------------------|
+--| FUNCTION PROTOTYPES
+--|----------------------------------------------------------------------------|
+*/
+
+// the interrupt routine in PSP_SysTick.c
+void SysTick_handler(void);
+
+static void Check(unsigned long actual, unsigned long expected, const char * p_name, int line);
+static void Map_Peripherals(void);
+static void Access_Fault_Handler(int signal, siginfo_t * p_info, void * p_context);
+static void Access_Step_Handler(int signal, siginfo_t * p_info, void * p_context);
+static void Model_Start(void);
+static void Model_Advance(void);
+static void Model_Run(uint64_t cycles);
+static void Model_Run_To_Tick_Phase(uint32_t cycles_into_tick);
+static void Model_Deliver_Tick(void);
+static int64_t Get_DWT_Offset(void);
+static void Test_Full_Sleep(void);
+static void Test_Early_Wakeup(void);
+static void Test_Clamped_Sleep(void);
+static void Test_Pending_Tick(void);
+static void Test_DWT_Clocked_In_Sleep(void);
+
+/*
+--|----------------------------------------------------------------------------|
+--| FUNCTION DEFINITIONS
+--|----------------------------------------------------------------------------|
+*/
+
+int main(void)
+{
+    Map_Peripherals();
+    Model_Start();
+
+    Test_Full_Sleep();
+    Test_Early_Wakeup();
+    Test_Clamped_Sleep();
+    Test_Pending_Tick();
+    Test_DWT_Clocked_In_Sleep();
+
+    printf("tickless idle: %u of %u checks passed\n", num_checks - num_failures, num_checks);
+
+    return (num_failures == 0u) ? EXIT_SUCCESS : EXIT_FAILURE;
+}
+
+// the core sleeps until the SysTick interrupt, or an early wakeup if one is set
+void Core_Wait_For_Interrupt(void)
+{
+    uint64_t slept_cycles = 0u;
+
+    model.sleeps++;
+    model.sleep_reload = model.load;
+    model.asleep       = true;
+
+    while (!model.tick_pending &&
+           ((model.wake_after_cycles == 0u) || (slept_cycles < model.wake_after_cycles)))
+    {
+        if (slept_cycles == MAX_SLEEP_CYCLES)
+        {
+            printf("the core was never woken\n");
+            exit(EXIT_FAILURE);
+        }
+
+        Model_Advance();
+        slept_cycles++;
+    }
+
+    model.asleep = false;
+}
+
+/*
+--|----------------------------------------------------------------------------|
+--| HELPER FUNCTION DEFINITIONS
+--|----------------------------------------------------------------------------|
+*/
+
+static void Check(unsigned long actual, unsigned long expected, const char * p_name, int line)
+{
+    num_checks++;
+
+    if (actual != expected)
+    {
+        num_failures++;
+        printf("line %d: %s is %lu, expected %lu\n", line, p_name, actual, expected);
+    }
+}
+
+// map the core peripherals as memory, trapping every access to the SysTick page
+static void Map_Peripherals(void)
+{
+    void * const p_peripherals = mmap((void *)(uintptr_t)PSP_CORE_PERIPHERAL_BASE, PERIPHERAL_MAP_SIZE,
+                                      PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS | MAP_FIXED_NOREPLACE,
+                                      -1, 0);
+
+    if (p_peripherals != (void *)(uintptr_t)PSP_CORE_PERIPHERAL_BASE)
+    {
+        perror("mapping the core peripherals");
+        exit(EXIT_FAILURE);
+    }
+
+    page_size      = (size_t)sysconf(_SC_PAGESIZE);
+    p_systick_page = (void *)((uintptr_t)PSP_CORE_PERIPHERAL_STK_BASE & ~(uintptr_t)(page_size - 1u));
+
+    struct sigaction action = { 0 };
+
+    action.sa_flags     = SA_SIGINFO;
+    action.sa_sigaction = Access_Fault_Handler;
+    sigaction(SIGSEGV, &action, NULL);
+
+    action.sa_sigaction = Access_Step_Handler;
+    sigaction(SIGTRAP, &action, NULL);
+
+    mprotect(p_systick_page, page_size, PROT_NONE);
+}
+
+// before a trapped access, spend its cycle and show the model in the registers
+static void Access_Fault_Handler(int signal, siginfo_t * p_info, void * p_context)
+{
+    ucontext_t * const p_uc    = p_context;
+    const uintptr_t    address = (uintptr_t)p_info->si_addr;
+
+    (void)signal;
+
+    if ((address < (uintptr_t)p_systick_page) || (address >= ((uintptr_t)p_systick_page + page_size)))
+    {
+        // a real fault, crash on it
+        struct sigaction action = { 0 };
+
+        action.sa_handler = SIG_DFL;
+        sigaction(SIGSEGV, &action, NULL);
+        return;
+    }
+
+    access_address  = address;
+    access_is_write = (p_uc->uc_mcontext.gregs[REG_ERR] & PAGE_FAULT_WRITE_FLAG) != 0;
+
+    mprotect(p_systick_page, page_size, PROT_READ | PROT_WRITE);
+
+    Model_Advance();
+
+    SysTick->CTRL = model.ctrl | (model.count_flag ? SysTick_CTRL_COUNT_FLAG : 0u);
+    SysTick->LOAD = model.load;
+    SysTick->VAL  = model.count;
+
+    p_uc->uc_mcontext.gregs[REG_EFL] |= EFLAGS_TRAP_FLAG;
+}
+
+// after a trapped access, apply what it did to the model
+static void Access_Step_Handler(int signal, siginfo_t * p_info, void * p_context)
+{
+    ucontext_t * const p_uc = p_context;
+
+    (void)signal;
+    (void)p_info;
+
+    p_uc->uc_mcontext.gregs[REG_EFL] &= ~(greg_t)EFLAGS_TRAP_FLAG;
+
+    if (access_address == (uintptr_t)&SysTick->CTRL)
+    {
+        if (access_is_write)
+        {
+            model.ctrl = SysTick->CTRL & (SysTick_CTRL_CLKSOURCE_FLAG | SysTick_CTRL_TICKINT_FLAG |
+                                          SysTick_CTRL_ENABLE_FLAG);
+        }
+        else
+        {
+            model.count_flag = false;
+        }
+    }
+    else if (access_is_write && (access_address == (uintptr_t)&SysTick->LOAD))
+    {
+        model.load = SysTick->LOAD & SYSTICK_MAX_RELOAD;
+    }
+    else if (access_is_write && (access_address == (uintptr_t)&SysTick->VAL))
+    {
+        // any write clears the counter and the count flag
+        model.count      = 0u;
+        model.count_flag = false;
+    }
+
+    mprotect(p_systick_page, page_size, PROT_NONE);
+}
+
+// the state PSP_System_Clock_Init leaves, with the counter reaching 0 every mSec from cycle 0
+static void Model_Start(void)
+{
+    DWT_Init();
+
+    model.load            = CYCLES_PER_MSEC - 1u;
+    model.count           = 0u;
+    model.ctrl            = SysTick_CTRL_CLKSOURCE_FLAG | SysTick_CTRL_TICKINT_FLAG | SysTick_CTRL_ENABLE_FLAG;
+    model.cycle           = 0u;
+    model.last_tick_cycle = 0u;
+}
+
+// one core clock cycle
+static void Model_Advance(void)
+{
+    model.cycle++;
+
+    if (!model.asleep || model.dwt_clocked_in_sleep)
+    {
+        DWT->CYCCNT++;
+    }
+
+    if (model.ctrl & SysTick_CTRL_ENABLE_FLAG)
+    {
+        if (model.count == 0u)
+        {
+            model.count = model.load;
+        }
+        else if (--model.count == 0u)
+        {
+            model.count_flag      = true;
+            model.last_tick_cycle = model.cycle;
+
+            if (model.ctrl & SysTick_CTRL_TICKINT_FLAG)
+            {
+                model.tick_pending = true;
+            }
+        }
+    }
+}
+
+// run awake for a number of cycles, handling each tick as it comes
+static void Model_Run(uint64_t cycles)
+{
+    while (true)
+    {
+        if (model.tick_pending)
+        {
+            Model_Deliver_Tick();
+        }
+
+        if (cycles == 0u)
+        {
+            break;
+        }
+
+        Model_Advance();
+        cycles--;
+    }
+}
+
+// run awake until the given number of cycles after a tick
+static void Model_Run_To_Tick_Phase(uint32_t cycles_into_tick)
+{
+    Model_Run(1u);
+
+    while ((model.cycle - model.last_tick_cycle) != cycles_into_tick)
+    {
+        Model_Run(1u);
+    }
+}
+
+// the handler counts the tick, which must land on the grid with the count its place on it
+static void Model_Deliver_Tick(void)
+{
+    model.tick_pending = false;
+
+    SysTick_handler();
+
+    const uint64_t nearest_tick = (model.last_tick_cycle + (CYCLES_PER_MSEC / 2u)) / CYCLES_PER_MSEC;
+    const int64_t  phase_error  = (int64_t)(model.last_tick_cycle - (nearest_tick * CYCLES_PER_MSEC));
+
+    CHECK(llabs(phase_error) <= TOLERANCE_CYCLES, 1u);
+    CHECK(SysTick_Get_mSec(), nearest_tick);
+}
+
+// how far the extended DWT count is ahead of the model's clock
+static int64_t Get_DWT_Offset(void)
+{
+    return (int64_t)(DWT_Get_Cycles() - model.cycle);
+}
+
+// a sleep to the deadline credits all but the tick the pending interrupt counts
+static void Test_Full_Sleep(void)
+{
+    Model_Run_To_Tick_Phase((CYCLES_PER_MSEC * 4u) / 10u);
+
+    const uint32_t mSec_before       = SysTick_Get_mSec();
+    const uint32_t sleeps_before     = model.sleeps;
+    const int64_t  dwt_offset_before = Get_DWT_Offset();
+
+    SysTick_Tickless_Idle(100u);
+
+    CHECK(model.sleeps, sleeps_before + 1u);
+    CHECK(model.tick_pending, true);
+    CHECK(SysTick_Get_mSec(), mSec_before + 99u);
+
+    Model_Run(0u);
+
+    CHECK(SysTick_Get_mSec(), mSec_before + 100u);
+    CHECK(llabs(Get_DWT_Offset() - dwt_offset_before) <= TOLERANCE_CYCLES, 1u);
+
+    // the 1 mSec ticks carry on in phase
+    Model_Run(3u * CYCLES_PER_MSEC);
+
+    CHECK(SysTick_Get_mSec(), mSec_before + 103u);
+
+    // the shortest sleep finishes the current tick
+    Model_Run_To_Tick_Phase((CYCLES_PER_MSEC * 9u) / 10u);
+
+    SysTick_Tickless_Idle(1u);
+    Model_Run(0u);
+
+    CHECK(SysTick_Get_mSec(), mSec_before + 104u);
+}
+
+// an early wakeup credits the whole ticks slept, the next tick stays on the grid
+static void Test_Early_Wakeup(void)
+{
+    Model_Run_To_Tick_Phase((CYCLES_PER_MSEC * 3u) / 10u);
+
+    const uint32_t mSec_before       = SysTick_Get_mSec();
+    const int64_t  dwt_offset_before = Get_DWT_Offset();
+
+    // 0.3 mSec into the tick, plus 37.5 mSec, wakes 0.8 mSec into the 37th tick after
+    model.wake_after_cycles = (CYCLES_PER_MSEC * 375u) / 10u;
+
+    SysTick_Tickless_Idle(100u);
+
+    model.wake_after_cycles = 0u;
+
+    CHECK(model.tick_pending, false);
+    CHECK(model.sleep_reload >= (99u * CYCLES_PER_MSEC), 1u);
+    CHECK(SysTick_Get_mSec(), mSec_before + 37u);
+    CHECK(llabs(Get_DWT_Offset() - dwt_offset_before) <= TOLERANCE_CYCLES, 1u);
+
+    // the first tick after waking comes after the rest of the 38th mSec
+    Model_Run(CYCLES_PER_MSEC / 10u);
+
+    CHECK(SysTick_Get_mSec(), mSec_before + 37u);
+
+    Model_Run((CYCLES_PER_MSEC * 2u) / 10u);
+
+    CHECK(SysTick_Get_mSec(), mSec_before + 38u);
+
+    Model_Run(3u * CYCLES_PER_MSEC);
+
+    CHECK(SysTick_Get_mSec(), mSec_before + 41u);
+}
+
+// a sleep longer than the 24 bit reload register can count stops at the longest it can
+static void Test_Clamped_Sleep(void)
+{
+    const uint32_t max_idle_mSec = SysTick_Get_Max_Idle_mSec();
+
+    CHECK((max_idle_mSec * CYCLES_PER_MSEC) <= (SYSTICK_MAX_RELOAD + 1u), 1u);
+    CHECK(((max_idle_mSec + 1u) * CYCLES_PER_MSEC) > (SYSTICK_MAX_RELOAD + 1u), 1u);
+
+    const uint32_t idle_mSec[] = { max_idle_mSec + 1u, UINT32_MAX };
+
+    for (size_t i = 0u; i < (sizeof(idle_mSec) / sizeof(idle_mSec[0])); i++)
+    {
+        // just after a tick, where the rest of the tick is longest
+        Model_Run_To_Tick_Phase(TOLERANCE_CYCLES);
+
+        const uint32_t mSec_before       = SysTick_Get_mSec();
+        const int64_t  dwt_offset_before = Get_DWT_Offset();
+
+        SysTick_Tickless_Idle(idle_mSec[i]);
+
+        CHECK(model.sleep_reload <= SYSTICK_MAX_RELOAD, 1u);
+
+        Model_Run(0u);
+
+        CHECK(SysTick_Get_mSec(), mSec_before + max_idle_mSec);
+        CHECK(llabs(Get_DWT_Offset() - dwt_offset_before) <= TOLERANCE_CYCLES, 1u);
+
+        Model_Run(2u * CYCLES_PER_MSEC);
+    }
+}
+
+// a tick which came after interrupts were masked is handled instead of sleeping
+static void Test_Pending_Tick(void)
+{
+    while (!model.tick_pending)
+    {
+        Model_Advance();
+    }
+
+    const uint32_t mSec_before   = SysTick_Get_mSec();
+    const uint32_t sleeps_before = model.sleeps;
+
+    SysTick_Tickless_Idle(50u);
+
+    CHECK(model.sleeps, sleeps_before);
+    CHECK((model.ctrl & SysTick_CTRL_ENABLE_FLAG) != 0u, 1u);
+    CHECK(SysTick_Get_mSec(), mSec_before);
+
+    Model_Run(2u * CYCLES_PER_MSEC);
+
+    CHECK(SysTick_Get_mSec(), mSec_before + 3u);
+}
+
+// with a debugger keeping the DWT counting in sleep, it is not credited twice
+static void Test_DWT_Clocked_In_Sleep(void)
+{
+    model.dwt_clocked_in_sleep = true;
+
+    Model_Run_To_Tick_Phase(CYCLES_PER_MSEC / 2u);
+
+    const int64_t dwt_offset_before = Get_DWT_Offset();
+
+    SysTick_Tickless_Idle(20u);
+    Model_Run(0u);
+
+    CHECK(llabs(Get_DWT_Offset() - dwt_offset_before) <= TOLERANCE_CYCLES, 1u);
+
+    model.wake_after_cycles = 5u * CYCLES_PER_MSEC;
+
+    SysTick_Tickless_Idle(20u);
+    Model_Run(0u);
+
+    model.wake_after_cycles    = 0u;
+    model.dwt_clocked_in_sleep = false;
+
+    CHECK(llabs(Get_DWT_Offset() - dwt_offset_before) <= TOLERANCE_CYCLES, 1u);
+}
@@ -0,0 +1,428 @@
+/*
+--|----------------------------------------------------------------------------|
+--| FILE DESCRIPTION:
+--|   timer_wheel_test.c is a Linux host test of PSP_Timer_Wheel.c, which
+--|   runs a seeded random workload of starts, cancels and servicing against
+--|   a brute force reference holding each timer's expiry. Time advances in
+--|   steps of up to 2^22 mSec, from starts which include the 32 bit wrap,
+--|   and the callbacks restart and cancel timers as they expire.
+--|
+--|   Each expiry must be due and not already fired, no due timer may be left
+--|   after servicing, and the time until the next expiry may be early but
+--|   never late. It prints each failed check and exits non-zero if there
+--|   were any.
+--|
+--|   To build and run it:
+--|   $ make host_test
+--|
+--|----------------------------------------------------------------------------|
+--| REFERENCES:
+--|   None.
+--|
+--|----------------------------------------------------------------------------|
+*/
+
+/*
+--|----------------------------------------------------------------------------|
+--| INCLUDE FILES
+--|----------------------------------------------------------------------------|
+*/
+
+#include "PSP_SysTick.h"
+#include "PSP_Timer_Wheel.h"
+
+#include <stdio.h>
+#include <stdlib.h>
+
+/*
+--|----------------------------------------------------------------------------|
+--| DEFINES
+--|----------------------------------------------------------------------------|
+*/
+
+/*
+--| NAME: CHECK
+--| DESCRIPTION: compare an unsigned value against its expected value, and
+--|   count and print a failure
+--| TYPE: statement
+*/
+#define CHECK(actual, expected) Check((unsigned long)(actual), (unsigned long)(expected), #actual, __LINE__)
+
+/*
+--| NAME: NUM_TIMERS
+--| DESCRIPTION: the timers in the workload
+--| TYPE: unsigned integer
+*/
+#define NUM_TIMERS (300u)
+
+/*
+--| NAME: NUM_STEPS
+--| DESCRIPTION: the starts, cancels and services in each workload
+--| TYPE: unsigned integer
+*/
+#define NUM_STEPS (20000u)
+
+/*
+--| NAME: MAX_GAP_mSec
+--| DESCRIPTION: the longest time between services, as after a tickless sleep
+--| TYPE: unsigned integer
+*/
+#define MAX_GAP_mSec (1u << 22u)
+
+/*
+--| NAME: MAX_DELAY_mSec
+--| DESCRIPTION: the longest delay a timer may be started with
+--| TYPE: unsigned integer
+*/
+#define MAX_DELAY_mSec (0x7FFFFFFFu)
+
+/*
+--| NAME: MAX_PRINTED_FAILURES
+--| DESCRIPTION: stop printing after this many failures, a broken wheel
+--|   fails the same check on most steps
+--| TYPE: unsigned integer
+*/
+#define MAX_PRINTED_FAILURES (20u)
+
+/*
+--|----------------------------------------------------------------------------|
+--| TYPES
+--|----------------------------------------------------------------------------|
+*/
+
+/*
+--| NAME: Reference_Timer_t
+--| DESCRIPTION: what the wheel should hold for one timer
+--| TYPE: struct
+*/
+typedef struct
+{
+    bool     active;      // started and not yet expired or cancelled
+    uint32_t expiry_mSec; // absolute expiry time
+    uint32_t period_mSec; // reload period, 0 for one-shot timers
+} Reference_Timer_t;
+
+/*
+--|----------------------------------------------------------------------------|
+--| CONSTANTS
+--|----------------------------------------------------------------------------|
+*/
+
+/*
+--| NAME: seeds
+--| DESCRIPTION: the random workloads run from each start time
+--| TYPE: uint64_t[]
+*/
+static const uint64_t seeds[] = { 1u, 2u, 3u, 4u, 5u };
+
+/*
+--| NAME: start_times_mSec
+--| DESCRIPTION: the SysTick times the workloads start at, from reset, and
+--|   shortly before the signed and unsigned 32 bit wraps
+--| TYPE: uint32_t[]
+*/
+static const uint32_t start_times_mSec[] = { 0u, 0x7FFFF000u, 0xFFFF0000u };
+
+/*
+--|----------------------------------------------------------------------------|
+--| VARIABLES
+--|----------------------------------------------------------------------------|
+*/
+
+/*
+--| NAME: num_checks
+--| DESCRIPTION: the checks made so far
+--| TYPE: unsigned int
+*/
+static unsigned int num_checks = 0u;
+
+/*
+--| NAME: num_failures
+--| DESCRIPTION: the checks failed so far
+--| TYPE: unsigned int
+*/
+static unsigned int num_failures = 0u;
+
+/*
+--| NAME: num_expiries
+--| DESCRIPTION: the callbacks made so far
+--| TYPE: unsigned long
+*/
+static unsigned long num_expiries = 0u;
+
+/*
+--| NAME: now_mSec
+--| DESCRIPTION: the time returned by the SysTick_Get_mSec stand in
+--| TYPE: uint32_t
+*/
+static uint32_t now_mSec = 0u;
+
+/*
+--| NAME: random_state
+--| DESCRIPTION: the state of the workload's random number generator
+--| TYPE: uint64_t
+*/
+static uint64_t random_state = 0u;
+
+/*
+--| NAME: timers
+--| DESCRIPTION: the timers under test, zero-initialized as the wheel requires
+--| TYPE: Timer_Wheel_Timer_t[]
+*/
+static Timer_Wheel_Timer_t timers[NUM_TIMERS];
+
+/*
+--| NAME: reference
+--| DESCRIPTION: the expected state of each timer
+--| TYPE: Reference_Timer_t[]
+*/
+static Reference_Timer_t reference[NUM_TIMERS];
+
+/*
+--|----------------------------------------------------------------------------|
+--| FUNCTION PROTOTYPES
+--|----------------------------------------------------------------------------|
+*/
+
+static void Check(unsigned long actual, unsigned long expected, const char * p_name, int line);
+static uint32_t Random(void);
+static uint32_t Random_Delay(void);
+static uint32_t Random_Gap(void);
+static void Start_Timer(uint32_t index, uint32_t delay_mSec, bool periodic);
+static void Cancel_Timer(uint32_t index);
+static void Expiry_Callback(void * p_context);
+static void Check_Serviced(void);
+static void Run_Workload(uint64_t seed, uint32_t start_time_mSec);
+
+/*
+--|----------------------------------------------------------------------------|
+--| FUNCTION DEFINITIONS
+--|----------------------------------------------------------------------------|
+*/
+
+int main(void)
+{
+    for (size_t i = 0u; i < (sizeof(start_times_mSec) / sizeof(start_times_mSec[0])); i++)
+    {
+        for (size_t j = 0u; j < (sizeof(seeds) / sizeof(seeds[0])); j++)
+        {
+            Run_Workload(seeds[j], start_times_mSec[i]);
+        }
+    }
+
+    printf("timer wheel: %u of %u checks passed, %lu expiries\n",
+           num_checks - num_failures, num_checks, num_expiries);
+
+    return (num_failures == 0u) ? EXIT_SUCCESS : EXIT_FAILURE;
+}
+
+// the wheel's time source, advanced by the workload
+uint32_t SysTick_Get_mSec(void)
+{
+    return now_mSec;
+}
+
+/*
+--|----------------------------------------------------------------------------|
+--| HELPER FUNCTION DEFINITIONS
+--|----------------------------------------------------------------------------|
+*/
+
+static void Check(unsigned long actual, unsigned long expected, const char * p_name, int line)
+{
+    num_checks++;
+
+    if (actual != expected)
+    {
+        num_failures++;
+
+        if (num_failures <= MAX_PRINTED_FAILURES)
+        {
+            printf("line %d at %lu mSec: %s is %lu, expected %lu\n",
+                   line, (unsigned long)now_mSec, p_name, actual, expected);
+        }
+    }
+}
+
+// a 64 bit linear congruential generator, returning its upper bits
+static uint32_t Random(void)
+{
+    random_state = (random_state * 6364136223846793005u) + 1442695040888963407u;
+
+    return (uint32_t)(random_state >> 33u);
+}
+
+// mostly short delays, some which cascade through every level, and a few as long as allowed
+static uint32_t Random_Delay(void)
+{
+    const uint32_t kind = Random() % 10u;
+
+    if (kind < 5u)
+    {
+        return 1u + (Random() % 100u);
+    }
+    else if (kind < 8u)
+    {
+        return 1u + (Random() % 70000u);
+    }
+    else if (kind < 9u)
+    {
+        return 1u + (Random() % (1u << 24u));
+    }
+
+    return 1u + (Random() % MAX_DELAY_mSec);
+}
+
+// mostly a few mSec between services, some seconds, and a few long sleeps
+static uint32_t Random_Gap(void)
+{
+    const uint32_t kind = Random() % 10u;
+
+    if (kind < 6u)
+    {
+        return Random() % 5u;
+    }
+    else if (kind < 9u)
+    {
+        return Random() % 5000u;
+    }
+
+    return Random() % (MAX_GAP_mSec + 1u);
+}
+
+static void Start_Timer(uint32_t index, uint32_t delay_mSec, bool periodic)
+{
+    if (periodic)
+    {
+        Timer_Wheel_Start_Periodic(&timers[index], delay_mSec, Expiry_Callback, &reference[index]);
+    }
+    else
+    {
+        Timer_Wheel_Start_One_Shot(&timers[index], delay_mSec, Expiry_Callback, &reference[index]);
+    }
+
+    reference[index].active      = true;
+    reference[index].expiry_mSec = now_mSec + delay_mSec;
+    reference[index].period_mSec = periodic ? delay_mSec : 0u;
+}
+
+static void Cancel_Timer(uint32_t index)
+{
+    Timer_Wheel_Cancel(&timers[index]);
+
+    reference[index].active = false;
+}
+
+// an expiry must be due and still active, and a quarter of them restart or cancel a timer
+static void Expiry_Callback(void * p_context)
+{
+    Reference_Timer_t * const p_reference = p_context;
+
+    num_expiries++;
+
+    CHECK(p_reference->active, true);
+    CHECK((int32_t)(now_mSec - p_reference->expiry_mSec) >= 0, true);
+
+    if (p_reference->period_mSec != 0u)
+    {
+        p_reference->expiry_mSec += p_reference->period_mSec;
+    }
+    else
+    {
+        p_reference->active = false;
+    }
+
+    if ((Random() % 4u) == 0u)
+    {
+        const uint32_t index = Random() % NUM_TIMERS;
+
+        if ((Random() % 2u) == 0u)
+        {
+            Cancel_Timer(index);
+        }
+        else
+        {
+            Start_Timer(index, 1u + (Random() % 3000u), false);
+        }
+    }
+}
+
+// after servicing, nothing is due and the next expiry is not reported late
+static void Check_Serviced(void)
+{
+    bool     any_active         = false;
+    uint32_t min_remaining_mSec = UINT32_MAX;
+
+    for (uint32_t i = 0u; i < NUM_TIMERS; i++)
+    {
+        CHECK(Timer_Wheel_Is_Active(&timers[i]), reference[i].active);
+
+        if (reference[i].active)
+        {
+            const uint32_t remaining_mSec = reference[i].expiry_mSec - now_mSec;
+
+            CHECK((int32_t)remaining_mSec > 0, true);
+
+            any_active = true;
+
+            if (remaining_mSec < min_remaining_mSec)
+            {
+                min_remaining_mSec = remaining_mSec;
+            }
+        }
+    }
+
+    const uint32_t until_next_mSec = Timer_Wheel_Get_mSec_Until_Next_Expiry();
+
+    if (any_active)
+    {
+        CHECK((until_next_mSec >= 1u) && (until_next_mSec <= min_remaining_mSec), true);
+    }
+    else
+    {
+        CHECK(until_next_mSec, UINT32_MAX);
+    }
+}
+
+static void Run_Workload(uint64_t seed, uint32_t start_time_mSec)
+{
+    // an empty wheel jumps to the present when the next timer starts
+    for (uint32_t i = 0u; i < NUM_TIMERS; i++)
+    {
+        Cancel_Timer(i);
+    }
+
+    random_state = seed;
+    now_mSec     = start_time_mSec;
+
+    for (uint32_t step = 0u; step < NUM_STEPS; step++)
+    {
+        const uint32_t action = Random() % 100u;
+
+        if (action < 30u)
+        {
+            const uint32_t index      = Random() % NUM_TIMERS;
+            const uint32_t delay_mSec = Random_Delay();
+
+            if ((Random() % 3u) == 0u)
+            {
+                Start_Timer(index, (delay_mSec % 200000u) + 1u, true);
+            }
+            else
+            {
+                Start_Timer(index, delay_mSec, false);
+            }
+        }
+        else if (action < 35u)
+        {
+            Cancel_Timer(Random() % NUM_TIMERS);
+        }
+        else
+        {
+            now_mSec += Random_Gap();
+
+            Timer_Wheel_Service();
+            Check_Serviced();
+        }
+    }
+}